@@ -205,7 +205,8 @@ static Oid YBCExecuteInsertInternal(Oid dboid,
                                     Relation rel,
                                     TupleDesc tupleDesc,
                                     HeapTuple tuple,
-                                    bool is_single_row_txn)
+                                    bool is_single_row_txn,
+                                    bool is_bulk_load)
 {
 	Oid            relid    = RelationGetRelid(rel);
 	AttrNumber     minattr  = YBGetFirstLowInvalidAttributeNumber(rel);
@@ -226,6 +227,8 @@ static Oid YBCExecuteInsertInternal(Oid dboid,
 	                              YbGetStorageRelid(rel),
 	                              is_single_row_txn,
 	                              &insert_stmt));
+	if (is_bulk_load)
+		HandleYBStatus(YBCPgInsertStmtSetIsBulkLoad(insert_stmt, true));
 
 	/* Get the ybctid for the tuple and bind to statement */
 	tuple->t_ybctid = YBCGetYBTupleIdFromTuple(rel, tuple, tupleDesc);
@@ -316,17 +319,21 @@ Oid YBCExecuteInsertForDb(Oid dboid,
 	                                rel,
 	                                tupleDesc,
 	                                tuple,
-	                                non_transactional);
+	                                non_transactional,
+	                                false /* is_bulk_load */);
 }
 
 Oid YBCExecuteNonTxnInsert(Relation rel,
                            TupleDesc tupleDesc,
                            HeapTuple tuple)
 {
-	return YBCExecuteNonTxnInsertForDb(YBCGetDatabaseOid(rel),
-	                                   rel,
-	                                   tupleDesc,
-	                                   tuple);
+	/* Only used by non-transactional COPY, so rows are marked as bulk load. */
+	return YBCExecuteInsertInternal(YBCGetDatabaseOid(rel),
+	                                rel,
+	                                tupleDesc,
+	                                tuple,
+	                                true /* is_single_row_txn */,
+	                                true /* is_bulk_load */);
 }
 
 Oid YBCExecuteNonTxnInsertForDb(Oid dboid,
@@ -338,7 +345,8 @@ Oid YBCExecuteNonTxnInsertForDb(Oid dboid,
 	                                rel,
 	                                tupleDesc,
 	                                tuple,
-	                                true /* is_single_row_txn */);
+	                                true /* is_single_row_txn */,
+	                                false /* is_bulk_load */);
 }
 
 Oid YBCHeapInsert(TupleTableSlot *slot,
@@ -504,6 +512,13 @@ void YBCExecuteInsertIndexForDb(Oid dboid,
 		 */
 		HandleYBStatus(YBCPgInsertStmtSetWriteTime(insert_stmt,
 												   *backfill_write_time));
+		/*
+		 * Entries of non-unique indexes are unique by the base tuple id, so
+		 * tablet server could ingest them as SST files, bypassing the mem
+		 * table.
+		 */
+		if (!index->rd_index->indisunique)
+			HandleYBStatus(YBCPgInsertStmtSetIsBulkLoad(insert_stmt, true));
 	}
 
 	/* Execute the insert and clean up. */
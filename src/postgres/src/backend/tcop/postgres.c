@@ -3712,7 +3712,7 @@ static void YBRefreshCache()
 	YBPreloadRelCache();
 
 	/* Also invalidate the pggate cache. */
-	HandleYBStatus(YBCPgInvalidateCache());
+	HandleYBStatus(YBCPgInvalidateCache(catalog_master_version));
 
 	/* Set the new ysql cache version. */
 	yb_catalog_cache_version = catalog_master_version;
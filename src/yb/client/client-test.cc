@@ -64,6 +64,7 @@
 #include "yb/common/schema.h"
 #include "yb/common/wire_protocol.h"
 
+#include "yb/consensus/consensus.h"
 #include "yb/consensus/consensus.proxy.h"
 
 #include "yb/gutil/algorithm.h"
@@ -88,6 +89,7 @@
 
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_metadata.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 
 #include "yb/tserver/mini_tablet_server.h"
@@ -2630,6 +2632,106 @@ TEST_F(ClientTest, ColocatedTablesLookupTablet) {
   ASSERT_EQ(lookup_serial_stop, lookup_serial_start + 1);
 }
 
+// Once tablet locations are cached, concurrent lookups should be served from the cache without
+// sending new lookup RPCs to master.
+TEST_F(ClientTest, ConcurrentCachedLookupTablet) {
+  const auto kTabletLookupTimeout = 10s;
+  const auto kNumThreads = 8;
+  const auto kNumLookupsPerThread = 1000;
+
+  const auto table = client_table_.table();
+  const auto partitions = table->GetVersionedPartitions();
+  std::vector<TabletId> tablet_ids;
+  for (const auto& partition_key : partitions->keys) {
+    auto tablet = ASSERT_RESULT(client_->LookupTabletByKeyFuture(
+        table, partition_key, CoarseMonoClock::now() + kTabletLookupTimeout).get());
+    tablet_ids.push_back(tablet->tablet_id());
+  }
+
+  const auto lookup_serial_start = client::internal::TEST_GetLookupSerial();
+
+  std::atomic<size_t> num_mismatches{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i != kNumThreads; ++i) {
+    threads.emplace_back([&, i] {
+      for (int j = 0; j != kNumLookupsPerThread; ++j) {
+        const auto idx = (i + j) % partitions->keys.size();
+        auto tablet = client_->LookupTabletByKeyFuture(
+            table, partitions->keys[idx], CoarseMonoClock::now() + kTabletLookupTimeout).get();
+        if (!tablet.ok() || (**tablet).tablet_id() != tablet_ids[idx]) {
+          ++num_mismatches;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(num_mismatches, 0);
+  ASSERT_EQ(client::internal::TEST_GetLookupSerial(), lookup_serial_start);
+}
+
+// Replica that rejects a write with NOT_THE_LEADER sends the uuid of the new leader, so the retry
+// goes directly to it, without asking other followers or looking up tablet locations on master.
+TEST_F(ClientTest, LeaderHintAfterLeaderChange) {
+  const auto kTabletLookupTimeout = 10s;
+
+  // Warm up the meta cache, including the leader of the tablet.
+  ASSERT_NO_FATALS(InsertTestRows(client_table2_, 1));
+  auto tablet = ASSERT_RESULT(client_->LookupTabletByKeyFuture(
+      client_table2_.table(), /* partition_key = */ "",
+      CoarseMonoClock::now() + kTabletLookupTimeout).get());
+  auto* old_leader = tablet->LeaderTServer();
+  ASSERT_NE(old_leader, nullptr);
+
+  // Without the hint, the client would try replicas in this order, so pick the last one to make
+  // sure that the first guess is wrong.
+  std::string new_leader_uuid;
+  for (auto* ts : tablet->GetRemoteTabletServers()) {
+    if (ts != old_leader) {
+      new_leader_uuid = ts->permanent_uuid();
+    }
+  }
+  ASSERT_FALSE(new_leader_uuid.empty());
+
+  auto peers = ListTableTabletPeers(cluster_.get(), client_table2_.table()->id());
+  ASSERT_EQ(peers.size(), 3);
+  tablet::TabletPeerPtr old_leader_peer, new_leader_peer;
+  for (const auto& peer : peers) {
+    if (peer->permanent_uuid() == old_leader->permanent_uuid()) {
+      old_leader_peer = peer;
+    } else if (peer->permanent_uuid() == new_leader_uuid) {
+      new_leader_peer = peer;
+    }
+  }
+  ASSERT_TRUE(old_leader_peer && new_leader_peer);
+
+  ASSERT_OK(StepDown(old_leader_peer, new_leader_uuid, ForceStepDown::kTrue));
+  ASSERT_OK(WaitFor([&old_leader_peer, &new_leader_peer, &new_leader_uuid] {
+    return new_leader_peer->LeaderStatus() == consensus::LeaderStatus::LEADER_AND_READY &&
+           old_leader_peer->consensus()->ConsensusState(
+               consensus::CONSENSUS_CONFIG_ACTIVE).leader_uuid() == new_leader_uuid;
+  }, 10s, "Wait for leader change"));
+
+  auto not_leader_rejections = [&peers] {
+    int64_t result = 0;
+    for (const auto& peer : peers) {
+      result += peer->tablet()->metrics()->not_leader_rejections->value();
+    }
+    return result;
+  };
+  const auto rejections_start = not_leader_rejections();
+  const auto lookup_serial_start = client::internal::TEST_GetLookupSerial();
+
+  ASSERT_NO_FATALS(InsertTestRows(client_table2_, 1, /* first_row = */ 1));
+
+  // Only the old leader rejected the write.
+  ASSERT_EQ(not_leader_rejections(), rejections_start + 1);
+  ASSERT_EQ(client::internal::TEST_GetLookupSerial(), lookup_serial_start);
+  ASSERT_EQ(ASSERT_NOTNULL(tablet->LeaderTServer())->permanent_uuid(), new_leader_uuid);
+}
+
 class ClientTestWithHashAndRangePk : public ClientTest {
  public:
   void SetUp() override {
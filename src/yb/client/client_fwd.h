@@ -130,6 +130,7 @@ class WriteRpc;
 
 struct InFlightOp;
 struct InFlightOpsGroupsWithMetadata;
+struct PublishedTabletsByPartition;
 
 class RemoteTablet;
 typedef scoped_refptr<RemoteTablet> RemoteTabletPtr;
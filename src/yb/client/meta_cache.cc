@@ -894,6 +894,23 @@ class FullTableLookup : public ToStringable {
   const TableId& table_id_;
 };
 
+// Should be called under unique lock of MetaCache::mutex_, so snapshots are published in order.
+void PublishTabletsByPartition(const TableData& table_data) {
+  const auto& keys = table_data.partition_list->keys;
+  auto snapshot = std::make_shared<TabletsByPartitionSnapshot>();
+  snapshot->partition_list = table_data.partition_list;
+  snapshot->tablets.reserve(keys.size());
+  for (const auto& key : keys) {
+    auto it = table_data.tablets_by_partition.find(key);
+    snapshot->tablets.push_back(
+        it != table_data.tablets_by_partition.end() ? it->second : nullptr);
+  }
+  std::atomic_store_explicit(
+      &table_data.published->snapshot,
+      std::shared_ptr<const TabletsByPartitionSnapshot>(std::move(snapshot)),
+      std::memory_order_release);
+}
+
 } // namespace
 
 Status MetaCache::ProcessTabletLocations(
@@ -915,6 +932,13 @@ Status MetaCache::ProcessTabletLocations(
   {
     std::lock_guard<decltype(mutex_)> lock(mutex_);
     ProcessedTablesMap processed_tables;
+    // Tables with updated tablets_by_partition, that should be published.
+    std::unordered_set<const TableData*> updated_tables;
+    auto publish_updated_tables = ScopeExit([&updated_tables] {
+      for (const auto* table_data : updated_tables) {
+        PublishTabletsByPartition(*table_data);
+      }
+    });
 
     for (const TabletLocationsPB& loc : locations) {
       const std::string& tablet_id = loc.tablet_id();
@@ -982,6 +1006,7 @@ Status MetaCache::ProcessTabletLocations(
             // This only can happen for those LookupTabletById requests that don't specify table,
             // because they don't care about partitions changing.
             tablets_by_key = &table_data.tablets_by_partition;
+            updated_tables.insert(&table_data);
           }
         }
 
@@ -1107,9 +1132,13 @@ std::unordered_map<TableId, TableData>::iterator MetaCache::InitTableDataUnlocke
       "MetaCache initializing TableData ($0 tables) for table $1: $2, "
       "partition_list_version: $3",
       tables_.size(), table_id, tables_.count(table_id), partitions->version);
-  return tables_.emplace(
+  auto emplace_result = tables_.emplace(
       std::piecewise_construct, std::forward_as_tuple(table_id),
-      std::forward_as_tuple(partitions)).first;
+      std::forward_as_tuple(partitions));
+  if (emplace_result.second) {
+    PublishTabletsByPartition(emplace_result.first->second);
+  }
+  return emplace_result.first;
 }
 
 void MetaCache::InvalidateTableCache(const YBTable& table) {
@@ -1176,6 +1205,7 @@ void MetaCache::InvalidateTableCache(const YBTable& table) {
     // Only update partitions here after invalidating TableData cache to avoid inconsistencies.
     // See https://github.com/yugabyte/yugabyte-db/issues/6890.
     table_data.partition_list = table_partition_list;
+    PublishTabletsByPartition(table_data);
   }
   for (const auto& callback : to_notify) {
     const auto s = STATUS_EC_FORMAT(
@@ -1792,6 +1822,60 @@ RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(
   return nullptr;
 }
 
+const PublishedTabletsByPartition* MetaCache::PublishedTabletsOf(const YBTable& table) {
+  const auto* cached = table.published_tablets_.load(std::memory_order_acquire);
+  if (!cached) {
+    std::shared_ptr<PublishedTabletsByPartition> tablets;
+    {
+      SharedLock<decltype(mutex_)> lock(mutex_);
+      const auto it = tables_.find(table.id());
+      if (it == tables_.end()) {
+        return nullptr;
+      }
+      // TableData is never removed from tables_, so its published tablets stay the same.
+      tablets = it->second.published;
+    }
+    auto published = std::make_unique<YBTable::PublishedTablets>(
+        YBTable::PublishedTablets { this, std::move(tablets) });
+    if (table.published_tablets_.compare_exchange_strong(
+            cached, published.get(), std::memory_order_acq_rel)) {
+      cached = published.release();
+    }
+  }
+  return cached->meta_cache == this ? cached->tablets.get() : nullptr;
+}
+
+RemoteTabletPtr MetaCache::LookupTabletByKeyFromSnapshot(
+    const YBTable& table, const VersionedTablePartitionListPtr& partitions,
+    const PartitionKey& partition_key) {
+  const auto* published = PublishedTabletsOf(table);
+  if (!published) {
+    return nullptr;
+  }
+  const auto snapshot = std::atomic_load_explicit(&published->snapshot, std::memory_order_acquire);
+  if (!snapshot || snapshot->partition_list->version != partitions->version) {
+    return nullptr;
+  }
+
+  const auto idx = client::FindPartitionStartIndex(partitions->keys, partition_key);
+  if (idx >= snapshot->tablets.size()) {
+    return nullptr;
+  }
+  const auto& result = snapshot->tablets[idx];
+  if (!result || result->stale() || !result->HasLeader()) {
+    return nullptr;
+  }
+
+  // Same check as in LookupTabletByKeyFastPathUnlocked, the tablet could be a pre-split one.
+  const auto& partition_key_end = result->partition().partition_key_end();
+  if (!partition_key_end.empty() && partition_key_end.compare(partitions->keys[idx]) <= 0) {
+    return nullptr;
+  }
+
+  VLOG_WITH_PREFIX(5) << "Snapshot lookup: found tablet " << result->tablet_id();
+  return result;
+}
+
 boost::optional<std::vector<RemoteTabletPtr>> MetaCache::FastLookupAllTabletsUnlocked(
     const std::shared_ptr<const YBTable>& table) {
   auto tablets = std::vector<RemoteTabletPtr>();
@@ -1994,6 +2078,14 @@ void MetaCache::LookupTabletByKey(const std::shared_ptr<YBTable>& table,
   }
 
   const auto table_partition_list = table->GetVersionedPartitions();
+  {
+    auto tablet = LookupTabletByKeyFromSnapshot(*table, table_partition_list, partition_key);
+    if (tablet) {
+      callback(tablet);
+      return;
+    }
+  }
+
   const auto partition_start = client::FindPartitionStart(table_partition_list, partition_key);
   VLOG_WITH_PREFIX_AND_FUNC(5) << "Table: " << table->ToString()
                     << ", partition_list_version: " << table_partition_list->version
@@ -2182,7 +2274,8 @@ void LookupDataGroup::Finished(
 }
 
 TableData::TableData(const VersionedTablePartitionListPtr& partition_list_)
-    : partition_list(partition_list_) {
+    : partition_list(partition_list_),
+      published(std::make_shared<PublishedTabletsByPartition>()) {
   DCHECK_ONLY_NOTNULL(partition_list);
 }
 
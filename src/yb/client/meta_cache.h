@@ -436,6 +436,22 @@ struct LookupDataGroup {
   ~LookupDataGroup();
 };
 
+// Tablets serving partitions of the specific version of table partition list. It is immutable
+// once published, so lookups by key could use it without acquiring MetaCache::mutex_.
+struct TabletsByPartitionSnapshot {
+  VersionedTablePartitionListPtr partition_list;
+  // i-th entry is the tablet serving partition starting at partition_list->keys[i], nullptr when
+  // it is not known yet.
+  std::vector<RemoteTabletPtr> tablets;
+};
+
+// Latest TabletsByPartitionSnapshot of the table, snapshot should be accessed using atomic
+// operations. Those are not lock-free for std::shared_ptr, but take a mutex picked by address of
+// the snapshot field, so different tables rarely contend.
+struct PublishedTabletsByPartition {
+  std::shared_ptr<const TabletsByPartitionSnapshot> snapshot;
+};
+
 struct TableData {
   explicit TableData(const VersionedTablePartitionListPtr& partition_list_);
 
@@ -444,6 +460,8 @@ struct TableData {
   std::unordered_map<PartitionGroupStartKey, LookupDataGroup> tablet_lookups_by_group;
   std::vector<RemoteTabletPtr> all_tablets;
   LookupDataGroup full_table_lookups;
+  // Snapshot of partition_list and tablets_by_partition.
+  std::shared_ptr<PublishedTabletsByPartition> published;
   bool stale = false;
   // To resolve partition_key to tablet_id MetaCache uses client::FindPartitionStart with
   // TableData::partition_list and then translates partition_start to tablet_id based on
@@ -577,6 +595,18 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   RemoteTabletPtr LookupTabletByIdFastPathUnlocked(const TabletId& tablet_id)
       REQUIRES_SHARED(mutex_);
 
+  // Lookup the tablet serving partition_key using published snapshot of the table, without
+  // acquiring mutex_. Returns nullptr if snapshot does not match partitions or the tablet is not
+  // known, stale or has no leader.
+  RemoteTabletPtr LookupTabletByKeyFromSnapshot(
+      const YBTable& table, const VersionedTablePartitionListPtr& partitions,
+      const PartitionKey& partition_key);
+
+  // Returns published tablets of the table, caching them in the table on the first call, so only
+  // this call acquires mutex_. Returns nullptr when table is not known yet, or the table is used
+  // with a client other than the one that cached them.
+  const PublishedTabletsByPartition* PublishedTabletsOf(const YBTable& table) EXCLUDES(mutex_);
+
   // Update our information about the given tablet server.
   //
   // This is called when we get some response from the master which contains
@@ -26,6 +26,7 @@
 #include "yb/client/yb_op.h"
 
 #include "yb/common/ql_value.h"
+#include "yb/common/read_hybrid_time.h"
 #include "yb/common/schema.h"
 
 #include "yb/consensus/log.h"
@@ -69,12 +70,14 @@ DECLARE_bool(TEST_combine_batcher_errors);
 DECLARE_bool(allow_preempting_compactions);
 DECLARE_bool(detect_duplicates_for_retryable_requests);
 DECLARE_bool(enable_ondisk_compression);
+DECLARE_bool(flush_rocksdb_on_shutdown);
 DECLARE_double(TEST_respond_write_failed_probability);
 DECLARE_double(transaction_max_missed_heartbeat_periods);
 DECLARE_int32(TEST_max_write_waiters);
 DECLARE_int32(client_read_write_timeout_ms);
 DECLARE_int32(log_cache_size_limit_mb);
 DECLARE_int32(log_min_seconds_to_retain);
+DECLARE_int32(max_write_ops_to_pre_apply);
 DECLARE_int32(raft_heartbeat_interval_ms);
 DECLARE_int32(retryable_request_range_time_limit_secs);
 DECLARE_int32(rocksdb_level0_file_num_compaction_trigger);
@@ -767,6 +770,87 @@ TEST_F_EX(QLStressTest, SlowUpdateConsensus, QLStressTestSingleTablet) {
   ASSERT_LE(max_peak_consumption, 150_MB);
 }
 
+// Leader and followers write runs of committed operations to RocksDB with a single write batch.
+// Checks that each write becomes visible exactly at its hybrid time on every replica, both before
+// and after restart, i.e. that pre applied data does not leak before its operation is applied.
+TEST_F_EX(QLStressTest, PreApplyWrites, QLStressTestSingleTablet) {
+  constexpr int kNumKeys = NonTsanVsTsan(300, 50);
+  constexpr int kBackgroundKeysStart = 1000000;
+  constexpr int kNumBackgroundWriters = 8;
+
+  FLAGS_max_write_ops_to_pre_apply = 64;
+
+  // Background writers produce many small operations, so followers receive several committed
+  // operations per update.
+  std::atomic<int> background_key(kBackgroundKeysStart);
+  TestThreadHolder thread_holder;
+  for (int i = 0; i != kNumBackgroundWriters; ++i) {
+    AddWriter("bg_", &background_key, &thread_holder);
+  }
+
+  auto session = NewSession();
+  std::vector<HybridTime> write_times;
+  for (int key = 0; key != kNumKeys; ++key) {
+    ASSERT_OK(WriteRow(session, key, Format("value_$0", key)));
+    write_times.emplace_back(client_->GetLatestObservedHybridTime());
+  }
+
+  thread_holder.Stop();
+
+  int64_t max_pre_applied_op_index = 0;
+  for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kNonLeaders)) {
+    max_pre_applied_op_index = std::max(
+        max_pre_applied_op_index, peer->tablet()->TEST_pre_applied_op_index());
+  }
+  LOG(INFO) << "Max pre applied op index: " << max_pre_applied_op_index;
+  ASSERT_GT(max_pre_applied_op_index, 0);
+
+  for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kLeaders)) {
+    auto pre_applied_op_index = peer->tablet()->TEST_pre_applied_op_index();
+    LOG(INFO) << "Leader pre applied op index: " << pre_applied_op_index;
+    ASSERT_GT(pre_applied_op_index, 0);
+  }
+
+  auto check_reads = [this, &write_times] {
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+      auto leaders = ListTabletPeers(cluster_.get(), ListPeersFilter::kLeaders);
+      ASSERT_EQ(leaders.size(), 1);
+      if (leaders[0] != peer) {
+        ASSERT_OK(StepDown(leaders[0], peer->permanent_uuid(), ForceStepDown::kTrue));
+        ASSERT_OK(WaitForLeaderOfSingleTablet(
+            cluster_.get(), peer, 20s, "Leader for pre apply check"));
+      }
+      LOG(INFO) << "Checking reads on " << peer->permanent_uuid();
+      for (int key = 0; key != kNumKeys; ++key) {
+        auto read_session = NewSession();
+        read_session->SetReadPoint(ReadHybridTime::SingleTime(write_times[key]));
+        auto value = ASSERT_RESULT(ReadRow(read_session, key));
+        ASSERT_EQ(value.string_value(), Format("value_$0", key));
+        if (key + 1 != kNumKeys) {
+          auto next_value = ReadRow(read_session, key + 1);
+          ASSERT_NOK(next_value);
+          ASSERT_TRUE(next_value.status().IsNotFound()) << next_value.status();
+        }
+      }
+    }
+  };
+
+  ASSERT_NO_FATALS(check_reads());
+
+  // Restart without flushing, so pre applied operations are replayed by bootstrap.
+  FLAGS_flush_rocksdb_on_shutdown = false;
+  ASSERT_OK(cluster_->RestartSync());
+  ASSERT_OK(WaitAllReplicasReady(cluster_.get(), 20s));
+  ASSERT_OK(WaitFor([this] {
+    return ListTabletPeers(cluster_.get(), ListPeersFilter::kLeaders).size() == 1;
+  }, 20s, "Leader elected"));
+
+  ASSERT_NO_FATALS(check_reads());
+
+  ASSERT_OK(cluster_->FlushTablets());
+  ASSERT_NO_FATALS(VerifyFlushedFrontiers());
+}
+
 template <int kSoftLimit, int kHardLimit>
 class QLStressTestDelayWrite : public QLStressTestSingleTablet {
  public:
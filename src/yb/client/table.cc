@@ -14,6 +14,8 @@
 #include "yb/client/table.h"
 
 #include "yb/client/client.h"
+#include "yb/client/client-internal.h"
+#include "yb/client/meta_cache.h"
 #include "yb/client/table_info.h"
 #include "yb/client/yb_op.h"
 
@@ -73,6 +75,7 @@ YBTable::YBTable(const YBTableInfo& info, VersionedTablePartitionListPtr partiti
 }
 
 YBTable::~YBTable() {
+  delete published_tablets_.load(std::memory_order_acquire);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -242,7 +245,8 @@ void YBTable::RefreshPartitions(YBClient* client, StdStatusCallback callback) {
 
   VLOG_WITH_FUNC(2) << Format(
       "Calling FetchPartitions for table $0 ($1)", info_->table_name, info_->table_id);
-  FetchPartitions(client, info_->table_id, [this](const FetchPartitionsResult& result) {
+  FetchPartitionsWithLocations(client, info_->table_id, [this, client](
+      const FetchPartitionsResult& result, const master::GetTableLocationsResponsePB* resp) {
     if (!result.ok()) {
       InvokeRefreshPartitionsCallbacks(result.status());
       return;
@@ -263,6 +267,19 @@ void YBTable::RefreshPartitions(YBClient* client, StdStatusCallback callback) {
       partitions_ = partitions;
       partitions_are_stale_ = false;
     }
+    // The response already contains locations of all tablets, including children of recently
+    // split tablets. Put them into the meta cache, so lookups waiting for the refresh do not
+    // have to fetch them from the master partition group by partition group.
+    auto& meta_cache = *client->data_->meta_cache_;
+    meta_cache.InvalidateTableCache(*this);
+    auto status = meta_cache.ProcessTabletLocations(
+        resp->tablet_locations(), partitions->version, /* lookup_rpc = */ nullptr);
+    if (!status.ok()) {
+      // Partitions could be concurrently updated to a newer version, lookups will fetch
+      // locations from the master in this case.
+      VLOG_WITH_FUNC(1) << Format(
+          "Failed to warm up tablet locations of table $0: $1", id(), status);
+    }
     InvokeRefreshPartitionsCallbacks(Status::OK());
   });
 }
@@ -277,6 +294,16 @@ bool YBTable::ArePartitionsStale() const {
 
 void YBTable::FetchPartitions(
     YBClient* client, const TableId& table_id, FetchPartitionsCallback callback) {
+  FetchPartitionsWithLocations(
+      client, table_id,
+      [callback = std::move(callback)](
+          const FetchPartitionsResult& result, const master::GetTableLocationsResponsePB*) {
+        callback(result);
+      });
+}
+
+void YBTable::FetchPartitionsWithLocations(
+    YBClient* client, const TableId& table_id, FetchPartitionsWithLocationsCallback callback) {
   // TODO: fetch the schema from the master here once catalog is available.
   // TODO(tsplit): consider optimizing this to not wait for all tablets to be running in case
   // of some tablet has been split and post-split tablets are not yet running.
@@ -286,7 +313,7 @@ void YBTable::FetchPartitions(
       [table_id, callback = std::move(callback)]
           (const Result<master::GetTableLocationsResponsePB*>& result) {
         if (!result.ok()) {
-          callback(result.status());
+          callback(result.status(), nullptr);
           return;
         }
         const auto& resp = **result;
@@ -303,7 +330,7 @@ void YBTable::FetchPartitions(
         }
         std::sort(partitions->keys.begin(), partitions->keys.end());
 
-        callback(partitions);
+        callback(partitions, &resp);
       });
 }
 
@@ -20,6 +20,7 @@
 
 #include "yb/common/common_fwd.h"
 
+#include "yb/master/master_client.fwd.h"
 #include "yb/master/master_fwd.h"
 
 #include "yb/util/locks.h"
@@ -49,6 +50,10 @@ struct VersionedTablePartitionList {
 
 typedef Result<VersionedTablePartitionListPtr> FetchPartitionsResult;
 typedef std::function<void(const FetchPartitionsResult&)> FetchPartitionsCallback;
+// Also receives the GetTableLocations response partitions were built from, nullptr on failure.
+typedef std::function<void(
+    const FetchPartitionsResult&, const master::GetTableLocationsResponsePB*)>
+        FetchPartitionsWithLocationsCallback;
 
 // A YBTable represents a table on a particular cluster. It holds the current
 // schema of the table. Any given YBTable instance belongs to a specific YBClient
@@ -138,6 +143,17 @@ class YBTable : public std::enable_shared_from_this<YBTable> {
   friend class YBClient;
   friend class internal::GetTableSchemaRpc;
   friend class internal::GetColocatedTabletSchemaRpc;
+  friend class internal::MetaCache;
+
+  // Tablets of this table published by MetaCache of the client, see
+  // MetaCache::LookupTabletByKeyFromSnapshot.
+  struct PublishedTablets {
+    const internal::MetaCache* meta_cache;
+    std::shared_ptr<internal::PublishedTabletsByPartition> tablets;
+  };
+
+  static void FetchPartitionsWithLocations(
+      YBClient* client, const TableId& table_id, FetchPartitionsWithLocationsCallback callback);
 
   void InvokeRefreshPartitionsCallbacks(const Status& status);
 
@@ -151,6 +167,9 @@ class YBTable : public std::enable_shared_from_this<YBTable> {
 
   std::atomic<bool> partitions_are_stale_{false};
 
+  // Set once, when the table is looked up by key in MetaCache for the first time.
+  mutable std::atomic<const PublishedTablets*> published_tablets_{nullptr};
+
   std::mutex refresh_partitions_callbacks_mutex_;
   std::vector<StdStatusCallback> refresh_partitions_callbacks_
       GUARDED_BY(refresh_partitions_callbacks_mutex_);
@@ -291,6 +291,7 @@ Status TabletInvoker::FailToNewReplica(const Status& reason,
       .status = STATUS(IllegalState, "Not the leader"),
       .time = CoarseMonoClock::now()
     });
+    UseLeaderHint(reason);
   } else {
     VLOG(1) << "Failing " << command_->ToString() << " to a new replica: " << reason
             << ", old replica: " << yb::ToString(current_ts_);
@@ -312,6 +313,27 @@ Status TabletInvoker::FailToNewReplica(const Status& reason,
   return status;
 }
 
+void TabletInvoker::UseLeaderHint(const Status& status) {
+  auto leader_hint = tserver::TabletServerLeaderHint::ValueFromStatus(status);
+  if (!leader_hint || leader_hint->empty() || !tablet_) {
+    return;
+  }
+  const auto& leader_uuid = leader_hint->front();
+  for (auto* ts : tablet_->GetRemoteTabletServers()) {
+    if (ts->permanent_uuid() != leader_uuid) {
+      continue;
+    }
+    // Replica that already rejected this request is not trusted, leader will be looked up on
+    // master when all replicas are tried.
+    if (!followers_.count(ts) && tablet_->MarkTServerAsLeader(ts)) {
+      VLOG(1) << "Tablet " << tablet_id_ << ": using leader hint " << ts->ToString();
+    }
+    return;
+  }
+  VLOG(1) << "Tablet " << tablet_id_ << ": leader hint " << leader_uuid
+          << " is not among replicas: " << tablet_->ReplicasAsString();
+}
+
 bool TabletInvoker::Done(Status* status) {
   TRACE_TO(trace_, "Done($0)", status->ToString(false));
   ADOPT_TRACE(trace_);
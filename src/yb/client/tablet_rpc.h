@@ -127,6 +127,10 @@ class TabletInvoker {
   CHECKED_STATUS FailToNewReplica(const Status& reason,
                                   const tserver::TabletServerErrorPB* error_code = nullptr);
 
+  // If NOT_THE_LEADER response contains leader hint, marks the hinted replica as leader of the
+  // tablet, so the retry goes directly to it without looking up tablet locations on master.
+  void UseLeaderHint(const Status& status);
+
   // Called when we finish a lookup (to find the new consensus leader). Retries
   // the rpc after a short delay.
   void LookupTabletCb(const Result<RemoteTabletPtr>& result);
@@ -14,6 +14,8 @@
 #ifndef YB_CONSENSUS_CONSENSUS_CONTEXT_H
 #define YB_CONSENSUS_CONSENSUS_CONTEXT_H
 
+#include <vector>
+
 #include "yb/common/common_fwd.h"
 
 #include "yb/consensus/consensus_fwd.h"
@@ -46,6 +48,12 @@ class ConsensusContext {
 
   virtual bool ShouldApplyWrite() = 0;
 
+  // Called before applying the specified sequence of committed write operations, that are
+  // guaranteed to be applied right after this call. Implementation could write data of all of
+  // them to the storage at once, and skip writing it while applying each operation.
+  // Invoked without holding the replica state lock.
+  virtual void PreApplyWrites(const std::vector<const ReplicateMsg*>& replicate_msgs) = 0;
+
   // Performs steps to prepare request for peer.
   // For instance it could enqueue some operations to the Raft.
   //
@@ -601,7 +601,8 @@ Status RaftConsensus::DoStartElection(const LeaderElectionData& data, PreElected
       const auto required_id = !data.must_be_committed_opid
           ? state_->GetPendingElectionOpIdUnlocked() : data.must_be_committed_opid;
       const Status advance_committed_index_status = ResultToStatus(
-          state_->AdvanceCommittedOpIdUnlocked(required_id, CouldStop::kFalse));
+          state_->AdvanceCommittedOpIdUnlocked(
+              required_id, CouldStop::kFalse, DeferWrites::kFalse));
       if (!advance_committed_index_status.ok()) {
         LOG(WARNING) << "Starting an " << election_name << " but the latest committed OpId is not "
                         "present in this peer's log: "
@@ -1363,6 +1364,23 @@ void RaftConsensus::UpdateMajorityReplicated(
     return;
   }
 
+  if (state_->HasDeferredWritesUnlocked()) {
+    // Write data of committed write operations, whose apply was deferred, without holding the
+    // replica state lock. Operations are applied after that, so committed op id is refreshed.
+    lock.unlock();
+    state_->PreApplyDeferredWrites();
+    s = state_->LockForMajorityReplicatedIndexUpdate(&lock);
+    if (PREDICT_FALSE(!s.ok())) {
+      LOG_WITH_PREFIX(WARNING)
+          << "Unable to take state lock after writing deferred operations: " << s;
+      return;
+    }
+    const auto& new_committed_op_id = state_->GetCommittedOpIdUnlocked();
+    committed_index_changed = committed_index_changed || new_committed_op_id != *committed_op_id;
+    *committed_op_id = new_committed_op_id;
+    *last_applied_op_id = state_->GetLastAppliedOpIdUnlocked();
+  }
+
   majority_num_sst_files_.store(majority_replicated_data.num_sst_files, std::memory_order_release);
 
   if (!majority_replicated_data.peer_got_all_ops.empty() &&
@@ -1526,6 +1544,10 @@ Status RaftConsensus::Update(ConsensusRequestPB* request,
     }
   }
 
+  // Write data of committed write operations, whose apply was deferred by UpdateReplica, without
+  // holding the replica state lock.
+  state_->PreApplyDeferredWrites();
+
   // Release the lock while we wait for the log append to finish so that commits can go through.
   if (!result.wait_for_op_id.empty()) {
     RETURN_NOT_OK(WaitForWrites(result.current_term, result.wait_for_op_id));
@@ -2019,7 +2041,8 @@ Status RaftConsensus::EarlyCommitUnlocked(const ConsensusRequestPB& request,
 
   VLOG_WITH_PREFIX(1) << "Early marking committed up to " << early_apply_up_to;
   TRACE("Early marking committed up to $0.$1", early_apply_up_to.term, early_apply_up_to.index);
-  return ResultToStatus(state_->AdvanceCommittedOpIdUnlocked(early_apply_up_to, CouldStop::kTrue));
+  return ResultToStatus(state_->AdvanceCommittedOpIdUnlocked(
+      early_apply_up_to, CouldStop::kTrue, DeferWrites::kTrue));
 }
 
 Result<bool> RaftConsensus::EnqueuePreparesUnlocked(const ConsensusRequestPB& request,
@@ -2207,7 +2230,8 @@ Status RaftConsensus::MarkOperationsAsCommittedUnlocked(const ConsensusRequestPB
 
   VLOG_WITH_PREFIX(1) << "Marking committed up to " << apply_up_to;
   TRACE(Format("Marking committed up to $0", apply_up_to));
-  return ResultToStatus(state_->AdvanceCommittedOpIdUnlocked(apply_up_to, CouldStop::kTrue));
+  return ResultToStatus(state_->AdvanceCommittedOpIdUnlocked(
+      apply_up_to, CouldStop::kTrue, DeferWrites::kTrue));
 }
 
 void RaftConsensus::FillConsensusResponseOKUnlocked(ConsensusResponsePB* response) {
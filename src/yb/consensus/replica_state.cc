@@ -65,6 +65,13 @@ DEFINE_int32(inject_delay_commit_pre_voter_to_voter_secs, 0,
 TAG_FLAG(inject_delay_commit_pre_voter_to_voter_secs, unsafe);
 TAG_FLAG(inject_delay_commit_pre_voter_to_voter_secs, hidden);
 
+DEFINE_int32(max_write_ops_to_pre_apply, 64,
+             "Max number of consecutive committed write operations, whose data is written to the "
+             "storage with a single write before applying them. Values less than 2 disable "
+             "batching.");
+TAG_FLAG(max_write_ops_to_pre_apply, runtime);
+TAG_FLAG(max_write_ops_to_pre_apply, advanced);
+
 namespace yb {
 namespace consensus {
 
@@ -711,7 +718,7 @@ Status ReplicaState::UpdateMajorityReplicatedUnlocked(
   // then 'committed_op_id' is simply equal to majority replicated.
   if (last_committed_op_id_.term == GetCurrentTermUnlocked()) {
     *committed_op_id_changed = VERIFY_RESULT(AdvanceCommittedOpIdUnlocked(
-        majority_replicated, CouldStop::kFalse));
+        majority_replicated, CouldStop::kFalse, DeferWrites::kTrue));
     *committed_op_id = last_committed_op_id_;
     *last_applied_op_id = GetLastAppliedOpIdUnlocked();
     return Status::OK();
@@ -723,7 +730,7 @@ Status ReplicaState::UpdateMajorityReplicatedUnlocked(
   if (majority_replicated.term == GetCurrentTermUnlocked()) {
     auto previous = last_committed_op_id_;
     *committed_op_id_changed = VERIFY_RESULT(AdvanceCommittedOpIdUnlocked(
-        majority_replicated, CouldStop::kFalse));
+        majority_replicated, CouldStop::kFalse, DeferWrites::kTrue));
     *committed_op_id = last_committed_op_id_;
     *last_applied_op_id = GetLastAppliedOpIdUnlocked();
     LOG_WITH_PREFIX(INFO)
@@ -763,7 +770,8 @@ Status ReplicaState::InitCommittedOpIdUnlocked(const yb::OpId& committed_op_id)
 
   if (!pending_operations_.empty() &&
       committed_op_id.index >= pending_operations_.front()->id().index) {
-    RETURN_NOT_OK(ApplyPendingOperationsUnlocked(committed_op_id, CouldStop::kFalse));
+    RETURN_NOT_OK(ApplyPendingOperationsUnlocked(
+        committed_op_id, CouldStop::kFalse, DeferWrites::kFalse));
   }
 
   SetLastCommittedIndexUnlocked(committed_op_id);
@@ -784,7 +792,7 @@ void ReplicaState::CheckPendingOperationsHead() const {
 }
 
 Result<bool> ReplicaState::AdvanceCommittedOpIdUnlocked(
-    const yb::OpId& committed_op_id, CouldStop could_stop) {
+    const yb::OpId& committed_op_id, CouldStop could_stop, DeferWrites defer_writes) {
   DCHECK(IsLocked());
   // If we already committed up to (or past) 'id' return.
   // This can happen in the case that multiple UpdateConsensus() calls end
@@ -811,7 +819,7 @@ Result<bool> ReplicaState::AdvanceCommittedOpIdUnlocked(
 
   auto old_index = last_committed_op_id_.index;
 
-  auto status = ApplyPendingOperationsUnlocked(committed_op_id, could_stop);
+  auto status = ApplyPendingOperationsUnlocked(committed_op_id, could_stop, defer_writes);
   if (!status.ok()) {
     return status;
   }
@@ -820,7 +828,7 @@ Result<bool> ReplicaState::AdvanceCommittedOpIdUnlocked(
 }
 
 Status ReplicaState::ApplyPendingOperationsUnlocked(
-    const yb::OpId& committed_op_id, CouldStop could_stop) {
+    const yb::OpId& committed_op_id, CouldStop could_stop, DeferWrites defer_writes) {
   DCHECK(IsLocked());
   VLOG_WITH_PREFIX(1) << "Last triggered apply was: " <<  last_committed_op_id_;
 
@@ -838,6 +846,13 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
   OpIds applied_op_ids;
   applied_op_ids.reserve(committed_op_id.index - prev_id.index);
 
+  if (!defer_writes) {
+    // Operations could not be deferred, so they are applied as usual, after concurrent
+    // PreApplyDeferredWrites completes.
+    WaitPreApplyWritesUnlocked();
+    writes_to_pre_apply_.clear();
+  }
+
   Status status;
 
   while (!pending_operations_.empty()) {
@@ -857,11 +872,16 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
     // For write operations we block rocksdb flush, until appropriate records are written to the
     // log file. So we could apply them before adding to log.
     if (type == OperationType::WRITE_OP) {
-      if (could_stop && !context_->ShouldApplyWrite()) {
-        YB_LOG_EVERY_N_SECS(WARNING, 5) << LogPrefix()
-            << "Stop apply pending operations, because of write delay required, last applied: "
-            << prev_id << " of " << committed_op_id;
-        break;
+      if (current_id.index > pre_applied_index_) {
+        if (could_stop && !context_->ShouldApplyWrite()) {
+          YB_LOG_EVERY_N_SECS(WARNING, 5) << LogPrefix()
+              << "Stop apply pending operations, because of write delay required, last applied: "
+              << prev_id << " of " << committed_op_id;
+          break;
+        }
+        if (defer_writes && DeferPreApplyWritesUnlocked(committed_op_id, could_stop)) {
+          break;
+        }
       }
     } else if (current_id.index > max_allowed_op_id.index ||
                current_id.term > max_allowed_op_id.term) {
@@ -908,6 +928,85 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
   return status;
 }
 
+bool ReplicaState::DeferPreApplyWritesUnlocked(
+    const yb::OpId& committed_op_id, CouldStop could_stop) {
+  if (pre_applying_writes_ || !writes_to_pre_apply_.empty()) {
+    // Head of pending operations is already being written by PreApplyDeferredWrites, that will
+    // apply operations up to committed_op_id after that.
+    op_id_to_apply_after_pre_apply_ = std::max(op_id_to_apply_after_pre_apply_, committed_op_id);
+    could_stop_after_pre_apply_ = CouldStop(could_stop_after_pre_apply_ && could_stop);
+    return true;
+  }
+
+  const size_t max_ops = std::max(FLAGS_max_write_ops_to_pre_apply, 0);
+  std::vector<ConsensusRoundPtr> rounds;
+  for (const auto& round : pending_operations_) {
+    if (rounds.size() >= max_ops || round->id().index > committed_op_id.index ||
+        round->replicate_msg()->op_type() != OperationType::WRITE_OP) {
+      break;
+    }
+    // ShouldApplyWrite was already checked by the caller for the head of pending operations.
+    if (could_stop && !rounds.empty() && !context_->ShouldApplyWrite()) {
+      break;
+    }
+    rounds.push_back(round);
+  }
+  // Single write operation is applied as usual.
+  if (rounds.size() < 2) {
+    return false;
+  }
+  writes_to_pre_apply_ = std::move(rounds);
+  op_id_to_apply_after_pre_apply_ = committed_op_id;
+  could_stop_after_pre_apply_ = could_stop;
+  return true;
+}
+
+void ReplicaState::WaitPreApplyWritesUnlocked() {
+  DCHECK(IsLocked());
+  if (!pre_applying_writes_) {
+    return;
+  }
+  // update_lock_ is held by the caller, so adopt it for waiting and keep it locked after that.
+  UniqueLock lock(update_lock_, std::adopt_lock);
+  pre_apply_cond_.wait(lock, [this] { return !pre_applying_writes_; });
+  lock.release();
+}
+
+void ReplicaState::PreApplyDeferredWrites() {
+  UniqueLock lock(update_lock_);
+  while (!writes_to_pre_apply_.empty() && !pre_applying_writes_ && state_ == kRunning) {
+    auto rounds = std::move(writes_to_pre_apply_);
+    writes_to_pre_apply_.clear();
+    pre_applying_writes_ = true;
+    lock.unlock();
+
+    std::vector<const ReplicateMsg*> replicate_msgs;
+    replicate_msgs.reserve(rounds.size());
+    for (const auto& round : rounds) {
+      replicate_msgs.push_back(round->replicate_msg().get());
+    }
+    // Operations could not be applied or aborted while pre_applying_writes_ is set, so it is safe
+    // to write their data without holding the lock.
+    context_->PreApplyWrites(replicate_msgs);
+
+    lock.lock();
+    pre_applying_writes_ = false;
+    pre_applied_index_ = rounds.back()->id().index;
+    pre_apply_cond_.notify_all();
+    auto op_id = op_id_to_apply_after_pre_apply_;
+    auto could_stop = could_stop_after_pre_apply_;
+    op_id_to_apply_after_pre_apply_ = yb::OpId();
+    could_stop_after_pre_apply_ = CouldStop::kTrue;
+    if (state_ != kRunning) {
+      break;
+    }
+    // Could defer the next run of write operations, so it is written in the next iteration.
+    WARN_NOT_OK(
+        ResultToStatus(AdvanceCommittedOpIdUnlocked(op_id, could_stop, DeferWrites::kTrue)),
+        "Failed to apply pre applied operations");
+  }
+}
+
 void ReplicaState::ApplyConfigChangeUnlocked(const ConsensusRoundPtr& round) {
   DCHECK(round->replicate_msg()->change_config_record().has_old_config());
   DCHECK(round->replicate_msg()->change_config_record().has_new_config());
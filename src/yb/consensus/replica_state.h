@@ -33,6 +33,7 @@
 #define YB_CONSENSUS_REPLICA_STATE_H
 
 #include <atomic>
+#include <condition_variable>
 #include <deque>
 #include <mutex>
 #include <string>
@@ -68,6 +69,7 @@ YB_DEFINE_ENUM(SetMajorityReplicatedLeaseExpirationFlag,
                (kResetOldLeaderLease)(kResetOldLeaderHtLease));
 
 YB_STRONGLY_TYPED_BOOL(CouldStop);
+YB_STRONGLY_TYPED_BOOL(DeferWrites);
 
 // Whether we add pending operation while running as leader or follower.
 YB_DEFINE_ENUM(OperationMode, (kLeader)(kFollower));
@@ -289,7 +291,20 @@ class ReplicaState {
   // Advances the committed index.
   // This is a no-op if the committed index has not changed.
   // Returns in whether the operation actually advanced the index.
-  Result<bool> AdvanceCommittedOpIdUnlocked(const yb::OpId& committed_op_id, CouldStop could_stop);
+  Result<bool> AdvanceCommittedOpIdUnlocked(
+      const yb::OpId& committed_op_id, CouldStop could_stop, DeferWrites defer_writes);
+
+  // Applying committed operations with DeferWrites::kTrue could stop before a run of consecutive
+  // write operations, so their data is written to the storage with a single write.
+  // This method performs that write with the update lock released, then applies the operations.
+  // Should be called without holding the update lock.
+  void PreApplyDeferredWrites();
+
+  // Whether there are deferred write operations, that should be written by PreApplyDeferredWrites.
+  bool HasDeferredWritesUnlocked() const {
+    DCHECK(IsLocked());
+    return !writes_to_pre_apply_.empty();
+  }
 
   // Initializes the committed index.
   // Function checks that we are in initial state, then updates committed index.
@@ -433,10 +448,18 @@ class ReplicaState {
   // Apply pending operations beginning at iter up to and including committed_op_id.
   // Updates last_committed_op_id_ to committed_op_id.
   CHECKED_STATUS ApplyPendingOperationsUnlocked(
-      const yb::OpId& committed_op_id, CouldStop could_stop);
+      const yb::OpId& committed_op_id, CouldStop could_stop, DeferWrites defer_writes);
 
   void SetLastCommittedIndexUnlocked(const yb::OpId& committed_op_id);
 
+  // Collects consecutive committed write operations from the head of pending operations up to
+  // committed_op_id, to be written by PreApplyDeferredWrites.
+  // Returns true if applying should stop before the head of pending operations.
+  bool DeferPreApplyWritesUnlocked(const yb::OpId& committed_op_id, CouldStop could_stop);
+
+  // Waits until PreApplyDeferredWrites finishes writing data with the update lock released.
+  void WaitPreApplyWritesUnlocked();
+
   // Applies committed config change.
   void ApplyConfigChangeUnlocked(const ConsensusRoundPtr& round);
 
@@ -466,6 +489,25 @@ class ReplicaState {
   // Queue of pending operations. Ordered by growing operation index.
   PendingOperations pending_operations_;
 
+  // Consecutive committed write operations from the head of pending operations, whose data should
+  // be written by PreApplyDeferredWrites before they are applied.
+  std::vector<ConsensusRoundPtr> writes_to_pre_apply_;
+
+  // Operations up to this op id should be applied after writes_to_pre_apply_ are written.
+  yb::OpId op_id_to_apply_after_pre_apply_;
+
+  // Whether applying operations after writes_to_pre_apply_ are written could stop. It could not,
+  // if any of callers that deferred them could not.
+  CouldStop could_stop_after_pre_apply_ = CouldStop::kTrue;
+
+  // Whether PreApplyDeferredWrites is writing data with the update lock released.
+  bool pre_applying_writes_ = false;
+  std::condition_variable pre_apply_cond_;
+
+  // Index of the last operation written by PreApplyDeferredWrites. ShouldApplyWrite was checked
+  // for operations up to this index before writing them.
+  int64_t pre_applied_index_ = 0;
+
   // When we receive a message from a remote peer telling us to start a operation, we use
   // this factory to start it.
   ConsensusContext* context_;
@@ -0,0 +1,129 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "yb/consensus/consensus.pb.h"
+#include "yb/consensus/retryable_requests.h"
+
+#include "yb/tablet/operations.pb.h"
+
+#include "yb/util/mem_tracker.h"
+#include "yb/util/opid.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+DECLARE_int32(retryable_request_timeout_secs);
+
+namespace yb {
+namespace consensus {
+
+class RetryableRequestsTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    parent_tracker_ = MemTracker::CreateTracker("RetryableRequestsTest");
+  }
+
+  // Adds replicated write request of the specified client, as it is done during bootstrap.
+  void Bootstrap(uint64_t client, RetryableRequestId request_id) {
+    ReplicateMsg msg;
+    ++last_op_index_;
+    msg.mutable_id()->set_term(1);
+    msg.mutable_id()->set_index(last_op_index_);
+    auto* write = msg.mutable_write();
+    write->set_client_id1(client);
+    write->set_client_id2(client);
+    write->set_request_id(request_id);
+    write->set_min_running_request_id(1);
+    requests_.Bootstrap(msg, requests_.Clock().Now());
+  }
+
+  int64_t Consumption() {
+    auto tracker = parent_tracker_->FindChild("RetryableRequests");
+    return tracker ? tracker->consumption() : 0;
+  }
+
+  // Cleans all replicated requests and clients, since all of them are expired.
+  void CleanExpired() {
+    FLAGS_retryable_request_timeout_secs = 0;
+    // Client is removed by the cleanup after the one that found it empty.
+    for (int i = 0; i != 2; ++i) {
+      std::this_thread::sleep_for(100ms);
+      requests_.CleanExpiredReplicatedAndGetMinOpId();
+    }
+  }
+
+  MemTrackerPtr parent_tracker_;
+  RetryableRequests requests_{"RetryableRequestsTest: "};
+  int64_t last_op_index_ = 0;
+};
+
+TEST_F(RetryableRequestsTest, MemTracker) {
+  requests_.SetMemTracker(parent_tracker_);
+  ASSERT_EQ(Consumption(), 0);
+
+  Bootstrap(/* client = */ 1, /* request_id = */ 1);
+  const auto single_range = Consumption();
+  ASSERT_GT(single_range, 0);
+
+  // Request that continues the range does not use additional memory.
+  Bootstrap(/* client = */ 1, /* request_id = */ 2);
+  ASSERT_EQ(Consumption(), single_range);
+
+  // Gap in request ids starts a new range.
+  Bootstrap(/* client = */ 1, /* request_id = */ 4);
+  const auto two_ranges = Consumption();
+  ASSERT_GT(two_ranges, single_range);
+
+  // New client with a single range uses more memory than a new range of the existing client.
+  Bootstrap(/* client = */ 2, /* request_id = */ 1);
+  ASSERT_GT(Consumption() - two_ranges, two_ranges - single_range);
+  ASSERT_EQ(requests_.TEST_Counts().replicated, 3);
+  ASSERT_EQ(parent_tracker_->consumption(), Consumption());
+
+  CleanExpired();
+  ASSERT_EQ(requests_.TEST_Counts().replicated, 0);
+  ASSERT_EQ(Consumption(), 0);
+  ASSERT_EQ(parent_tracker_->consumption(), 0);
+}
+
+TEST_F(RetryableRequestsTest, MemTrackerAfterBootstrap) {
+  for (RetryableRequestId request_id : {1, 3, 5}) {
+    Bootstrap(/* client = */ 1, request_id);
+  }
+  ASSERT_EQ(Consumption(), 0);
+
+  // Memory used during bootstrap is reported once the tracker is attached.
+  requests_.SetMemTracker(parent_tracker_);
+  const auto consumption = Consumption();
+  ASSERT_GT(consumption, 0);
+  ASSERT_EQ(parent_tracker_->consumption(), consumption);
+
+  // Attaching the tracker again does not report the same memory twice.
+  requests_.SetMemTracker(parent_tracker_);
+  ASSERT_EQ(Consumption(), consumption);
+  ASSERT_EQ(parent_tracker_->consumption(), consumption);
+
+  // Destroying retryable requests releases their memory.
+  requests_ = RetryableRequests();
+  ASSERT_EQ(Consumption(), 0);
+  ASSERT_EQ(parent_tracker_->consumption(), 0);
+}
+
+} // namespace consensus
+} // namespace yb
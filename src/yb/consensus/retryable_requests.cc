@@ -27,6 +27,7 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/format.h"
 #include "yb/util/logging.h"
+#include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
 #include "yb/util/opid.h"
 #include "yb/util/result.h"
@@ -148,6 +149,26 @@ struct ClientRetryableRequests {
   RestartSafeCoarseTimePoint empty_since;
 };
 
+// Approximate memory used by a single entry of each kind, including container node overhead.
+// Running requests are stored in a hashed index, replicated ranges in two ordered indexes.
+constexpr int64_t kClientMemoryUsage =
+    sizeof(ClientId) + sizeof(ClientRetryableRequests) + 2 * sizeof(void*);
+constexpr int64_t kRunningRequestMemoryUsage =
+    sizeof(RunningRetryableRequest) + 2 * sizeof(void*);
+constexpr int64_t kReplicatedRangeMemoryUsage =
+    sizeof(ReplicatedRetryableRequestRange) + 2 * 3 * sizeof(void*);
+
+// Returns iterator to the first replicated range with last_id >= request_id.
+// Clients send requests with increasing ids, so a request usually goes after all replicated
+// ranges. Check the last range first to avoid a tree lookup in this case.
+ReplicatedRetryableRequestRangesByLastId::iterator FindReplicatedRange(
+    RetryableRequestId request_id, ReplicatedRetryableRequestRangesByLastId* replicated) {
+  if (replicated->empty() || replicated->rbegin()->last_id < request_id) {
+    return replicated->end();
+  }
+  return replicated->lower_bound(request_id);
+}
+
 std::chrono::seconds RangeTimeLimit() {
   return std::chrono::seconds(FLAGS_retryable_request_range_time_limit_secs);
 }
@@ -213,6 +234,10 @@ class RetryableRequests::Impl {
     VLOG_WITH_PREFIX(1) << "Start";
   }
 
+  ~Impl() {
+    ReleaseMemTracker();
+  }
+
   bool Register(const ConsensusRoundPtr& round, RestartSafeCoarseTimePoint entry_time) {
     auto data = ReplicateData::FromMsg(*round->replicate_msg());
     if (!data) {
@@ -223,7 +248,7 @@ class RetryableRequests::Impl {
       entry_time = clock_.Now();
     }
 
-    ClientRetryableRequests& client_retryable_requests = clients_[data.client_id()];
+    ClientRetryableRequests& client_retryable_requests = FindOrCreateClient(data.client_id());
 
     CleanupReplicatedRequests(
         data.write().min_running_request_id(), &client_retryable_requests);
@@ -240,7 +265,7 @@ class RetryableRequests::Impl {
     }
 
     auto& replicated_indexed_by_last_id = client_retryable_requests.replicated.get<LastIdIndex>();
-    auto it = replicated_indexed_by_last_id.lower_bound(data.request_id());
+    auto it = FindReplicatedRange(data.request_id(), &replicated_indexed_by_last_id);
     if (it != replicated_indexed_by_last_id.end() && it->first_id <= data.request_id()) {
       round->NotifyReplicationFinished(
           STATUS(AlreadyPresent, "Duplicate request"), round->bound_term(),
@@ -256,9 +281,7 @@ class RetryableRequests::Impl {
     }
 
     VLOG_WITH_PREFIX(4) << "Running added " << data;
-    if (running_requests_gauge_) {
-      running_requests_gauge_->Increment();
-    }
+    ChangeRunningRequests(1);
 
     return true;
   }
@@ -276,9 +299,7 @@ class RetryableRequests::Impl {
         ++it;
         ++count;
       }
-      if (replicated_request_ranges_gauge_) {
-        replicated_request_ranges_gauge_->DecrementBy(count);
-      }
+      ChangeReplicatedRanges(-count);
       if (it != op_id_index.end()) {
         result = std::min(result, it->min_op_id);
         op_id_index.erase(op_id_index.begin(), it);
@@ -292,6 +313,7 @@ class RetryableRequests::Impl {
           client_retryable_requests.empty_since = now;
         } else if (client_retryable_requests.empty_since < clean_start) {
           ci = clients_.erase(ci);
+          ChangeMemoryUsage(-kClientMemoryUsage);
           continue;
         }
       }
@@ -308,7 +330,7 @@ class RetryableRequests::Impl {
       return;
     }
 
-    auto& client_retryable_requests = clients_[data.client_id()];
+    auto& client_retryable_requests = FindOrCreateClient(data.client_id());
     auto& running_indexed_by_request_id = client_retryable_requests.running.get<RequestIdIndex>();
     auto running_it = running_indexed_by_request_id.find(data.request_id());
     if (running_it == running_indexed_by_request_id.end()) {
@@ -330,9 +352,7 @@ class RetryableRequests::Impl {
     }
     auto entry_time = running_it->time;
     running_indexed_by_request_id.erase(running_it);
-    if (running_requests_gauge_) {
-      running_requests_gauge_->Decrement();
-    }
+    ChangeRunningRequests(-1);
 
     if (status.ok()) {
       AddReplicated(
@@ -347,7 +367,7 @@ class RetryableRequests::Impl {
       return;
     }
 
-    auto& client_retryable_requests = clients_[data.client_id()];
+    auto& client_retryable_requests = FindOrCreateClient(data.client_id());
     auto& running_indexed_by_request_id = client_retryable_requests.running.get<RequestIdIndex>();
     if (running_indexed_by_request_id.count(data.request_id()) != 0) {
 #ifndef NDEBUG
@@ -376,6 +396,12 @@ class RetryableRequests::Impl {
         metric_entity, 0);
   }
 
+  void SetMemTracker(const MemTrackerPtr& parent_tracker) {
+    ReleaseMemTracker();
+    mem_tracker_ = MemTracker::FindOrCreateTracker("RetryableRequests", parent_tracker);
+    mem_tracker_->Consume(memory_usage_);
+  }
+
   RetryableRequestsCounts TEST_Counts() {
     RetryableRequestsCounts result;
     for (const auto& p : clients_) {
@@ -410,10 +436,7 @@ class RetryableRequests::Impl {
           it->first_id < new_min_running_request_id) {
         it->first_id = new_min_running_request_id;
       }
-      if (replicated_request_ranges_gauge_) {
-        replicated_request_ranges_gauge_->DecrementBy(
-            std::distance(replicated_indexed_by_last_id.begin(), it));
-      }
+      ChangeReplicatedRanges(-std::distance(replicated_indexed_by_last_id.begin(), it));
       // Remove all intervals that has ids below write_request.min_running_request_id().
       replicated_indexed_by_last_id.erase(replicated_indexed_by_last_id.begin(), it);
       client_retryable_requests->min_running_request_id = new_min_running_request_id;
@@ -424,7 +447,7 @@ class RetryableRequests::Impl {
                      ClientRetryableRequests* client) {
     auto request_id = data.request_id();
     auto& replicated_indexed_by_last_id = client->replicated.get<LastIdIndex>();
-    auto request_it = replicated_indexed_by_last_id.lower_bound(request_id);
+    auto request_it = FindReplicatedRange(request_id, &replicated_indexed_by_last_id);
     if (request_it != replicated_indexed_by_last_id.end() && request_it->first_id <= request_id) {
 #ifndef NDEBUG
       LOG_WITH_PREFIX(ERROR)
@@ -455,9 +478,7 @@ class RetryableRequests::Impl {
     }
 
     client->replicated.emplace(request_id, op_id, time);
-    if (replicated_request_ranges_gauge_) {
-      replicated_request_ranges_gauge_->Increment();
-    }
+    ChangeReplicatedRanges(1);
   }
 
   void UpdateMinOpId(
@@ -496,9 +517,7 @@ class RetryableRequests::Impl {
     min_op_id = std::min(min_op_id, request_prev_it->min_op_id);
     request_it->PrepareJoinWithPrev(*request_prev_it);
     replicated_indexed_by_last_id->erase(request_prev_it);
-    if (replicated_request_ranges_gauge_) {
-      replicated_request_ranges_gauge_->Decrement();
-    }
+    ChangeReplicatedRanges(-1);
     UpdateMinOpId(request_it, min_op_id, replicated_indexed_by_last_id);
 
     return true;
@@ -536,6 +555,48 @@ class RetryableRequests::Impl {
     return true;
   }
 
+  ClientRetryableRequests& FindOrCreateClient(const ClientId& client_id) {
+    auto it = clients_.find(client_id);
+    if (it != clients_.end()) {
+      return it->second;
+    }
+    ChangeMemoryUsage(kClientMemoryUsage);
+    return clients_[client_id];
+  }
+
+  void ChangeRunningRequests(int64_t delta) {
+    if (running_requests_gauge_) {
+      running_requests_gauge_->IncrementBy(delta);
+    }
+    ChangeMemoryUsage(delta * kRunningRequestMemoryUsage);
+  }
+
+  void ChangeReplicatedRanges(int64_t delta) {
+    if (replicated_request_ranges_gauge_) {
+      replicated_request_ranges_gauge_->IncrementBy(delta);
+    }
+    ChangeMemoryUsage(delta * kReplicatedRangeMemoryUsage);
+  }
+
+  void ChangeMemoryUsage(int64_t delta) {
+    memory_usage_ += delta;
+    if (!mem_tracker_) {
+      return;
+    }
+    if (delta > 0) {
+      mem_tracker_->Consume(delta);
+    } else if (delta < 0) {
+      mem_tracker_->Release(-delta);
+    }
+  }
+
+  void ReleaseMemTracker() {
+    if (mem_tracker_) {
+      mem_tracker_->Release(memory_usage_);
+      mem_tracker_ = nullptr;
+    }
+  }
+
   const std::string& LogPrefix() const {
     return log_prefix_;
   }
@@ -545,6 +606,9 @@ class RetryableRequests::Impl {
   RestartSafeCoarseMonoClock clock_;
   scoped_refptr<AtomicGauge<int64_t>> running_requests_gauge_;
   scoped_refptr<AtomicGauge<int64_t>> replicated_request_ranges_gauge_;
+  // Approximate memory used by clients_, see k*MemoryUsage constants.
+  int64_t memory_usage_ = 0;
+  MemTrackerPtr mem_tracker_;
 };
 
 RetryableRequests::RetryableRequests(std::string log_prefix)
@@ -596,5 +660,9 @@ void RetryableRequests::SetMetricEntity(const scoped_refptr<MetricEntity>& metri
   impl_->SetMetricEntity(metric_entity);
 }
 
+void RetryableRequests::SetMemTracker(const std::shared_ptr<MemTracker>& parent_tracker) {
+  impl_->SetMemTracker(parent_tracker);
+}
+
 } // namespace consensus
 } // namespace yb
@@ -22,6 +22,7 @@
 
 namespace yb {
 
+class MemTracker;
 class MetricEntity;
 struct OpId;
 
@@ -66,6 +67,10 @@ class RetryableRequests {
 
   void SetMetricEntity(const scoped_refptr<MetricEntity>& metric_entity);
 
+  // Reports memory used by retryable requests to a child tracker of the specified tracker.
+  // Memory used before this call, e.g. during bootstrap, is reported immediately.
+  void SetMemTracker(const std::shared_ptr<MemTracker>& parent_tracker);
+
  private:
   class Impl;
   std::unique_ptr<Impl> impl_;
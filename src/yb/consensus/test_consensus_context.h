@@ -27,6 +27,8 @@ class TestConsensusContext : public ConsensusContext {
 
   bool ShouldApplyWrite() override { return true; }
 
+  void PreApplyWrites(const std::vector<const ReplicateMsg*>& replicate_msgs) override {}
+
   Result<HybridTime> PreparePeerRequest() override { return HybridTime(); }
 
   void MajorityReplicated() override {}
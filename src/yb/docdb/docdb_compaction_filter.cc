@@ -371,6 +371,15 @@ unique_ptr<CompactionFilter> DocDBCompactionFilterFactory::CreateCompactionFilte
       key_bounds_);
 }
 
+Slice DocDBCompactionFilterFactory::SubcompactionBoundary(const Slice& user_key) const {
+  auto doc_key_size = DocKey::EncodedSize(user_key, DocKeyPart::kWholeDocKey);
+  if (!doc_key_size.ok()) {
+    // Not a document key, e.g. transaction apply state, so don't split here.
+    return Slice();
+  }
+  return user_key.Prefix(*doc_key_size);
+}
+
 const char* DocDBCompactionFilterFactory::Name() const {
   return "DocDBCompactionFilterFactory";
 }
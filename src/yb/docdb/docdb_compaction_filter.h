@@ -178,6 +178,11 @@ class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
   ~DocDBCompactionFilterFactory() override;
   std::unique_ptr<rocksdb::CompactionFilter> CreateCompactionFilter(
       const rocksdb::CompactionFilter::Context& context) override;
+
+  // DocDBCompactionFilter tracks overwrites across all subkeys of a document, so subcompactions
+  // are split only at document key boundaries.
+  Slice SubcompactionBoundary(const Slice& user_key) const override;
+
   const char* Name() const override;
 
  private:
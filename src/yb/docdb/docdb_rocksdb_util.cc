@@ -81,6 +81,11 @@ DEFINE_uint64(rocksdb_universal_compaction_always_include_size_threshold, 64_MB,
              "Always include files of smaller or equal size in a compaction.");
 DEFINE_int32(rocksdb_universal_compaction_min_merge_width, 4,
              "The minimum number of files in a single compaction run.");
+DEFINE_int32(rocksdb_max_subcompactions, 1,
+             "Maximum number of key range subcompactions a single regular DB compaction could be "
+             "split into and run in parallel. Subcompactions are split at document key boundaries "
+             "and each gets at least rocksdb_min_subcompaction_size_bytes of input data. "
+             "1 disables subcompactions.");
 DEFINE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec, 256_MB,
              "Use to control write rate of flush and compaction.");
 DEFINE_string(rocksdb_compact_flush_rate_limit_sharing_mode, "none",
@@ -606,6 +611,7 @@ void InitRocksDBOptions(
   // Set block cache options.
   if (tablet_options.block_cache) {
     table_options.block_cache = tablet_options.block_cache;
+    table_options.secondary_block_cache = tablet_options.secondary_block_cache;
     // Cache the bloom filters in the block cache.
     table_options.cache_index_and_filter_blocks = true;
   } else {
@@ -663,8 +669,13 @@ void InitRocksDBOptions(
     options->compaction_options_universal.min_merge_width =
         FLAGS_rocksdb_universal_compaction_min_merge_width;
     options->compaction_size_threshold_bytes = FLAGS_rocksdb_compaction_size_threshold_bytes;
-    options->rate_limiter = tablet_options.rate_limiter ? tablet_options.rate_limiter
-                                                        : CreateRocksDBRateLimiter();
+    options->max_subcompactions =
+        static_cast<uint32_t>(std::max(FLAGS_rocksdb_max_subcompactions, 1));
+    // Shared rate limiter is accessed through a per tablet share, so compactions of a single
+    // tablet could not starve other tablets.
+    options->rate_limiter = tablet_options.rate_limiter
+        ? rocksdb::NewRateLimiterShare(tablet_options.rate_limiter)
+        : CreateRocksDBRateLimiter();
   } else {
     options->level0_slowdown_writes_trigger = std::numeric_limits<int>::max();
     options->level0_stop_writes_trigger = std::numeric_limits<int>::max();
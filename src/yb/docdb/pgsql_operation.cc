@@ -37,6 +37,7 @@
 #include "yb/docdb/primitive_value_util.h"
 #include "yb/docdb/ql_storage_interface.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/result.h"
 #include "yb/util/scope_exit.h"
@@ -69,6 +70,14 @@ DEFINE_bool(pgsql_consistent_transactional_paging, true,
             "be stale. The latter is preferable for long scans. The data returned for the first "
             "page of results is never stale regardless of this flag.");
 
+DEFINE_int32(ysql_batch_ybctid_shared_iterator_min_keys, 16,
+             "Min number of ybctids in a batched read request to read all of them using a single "
+             "iterator, that is seeked to each ybctid. Smaller batches create a separate "
+             "iterator per ybctid, that could use bloom filters. Negative value disables "
+             "shared iterator.");
+TAG_FLAG(ysql_batch_ybctid_shared_iterator_min_keys, advanced);
+TAG_FLAG(ysql_batch_ybctid_shared_iterator_min_keys, runtime);
+
 DEFINE_test_flag(int32, slowdown_pgsql_aggregate_read_ms, 0,
                  "If set > 0, slows down the response to pgsql aggregate read by this amount.");
 
@@ -995,11 +1004,17 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const YQLStorageIf& ql_storage,
   bool scan_time_exceeded = false;
   CoarseTimePoint stop_scan = deadline - FLAGS_ysql_scan_deadline_margin_ms * 1ms;
 
+  // Rows are not split between pages, so the last row could make the page bigger than the limit.
+  bool size_limit_exceeded = false;
+  const size_t result_size_limit =
+      request_.size_limit() > 0 ? result_buffer->size() + request_.size_limit()
+                                : std::numeric_limits<size_t>::max();
+
   // Fetching data.
   int match_count = 0;
   QLTableRow row;
   while (fetched_rows < row_count_limit && VERIFY_RESULT(iter->HasNext()) &&
-         !scan_time_exceeded) {
+         !scan_time_exceeded && !size_limit_exceeded) {
     row.Clear();
 
     // If there is an index request, fetch ybbasectid from the index and use it as ybctid
@@ -1029,6 +1044,7 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const YQLStorageIf& ql_storage,
       } else {
         RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
         ++fetched_rows;
+        size_limit_exceeded = result_buffer->size() >= result_size_limit;
       }
     }
 
@@ -1039,6 +1055,7 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const YQLStorageIf& ql_storage,
   VLOG(1) << "Stopped iterator after " << match_count << " matches, "
           << fetched_rows << " rows fetched";
   VLOG(1) << "Deadline is " << (scan_time_exceeded ? "" : "not ") << "exceeded";
+  VLOG(1) << "Size limit is " << (size_limit_exceeded ? "" : "not ") << "exceeded";
 
   if (request_.is_aggregate() && match_count > 0) {
     RETURN_NOT_OK(PopulateAggregate(row, result_buffer));
@@ -1051,7 +1068,7 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const YQLStorageIf& ql_storage,
   }
 
   RETURN_NOT_OK(SetPagingStateIfNecessary(
-      iter, fetched_rows, row_count_limit, scan_time_exceeded, scan_schema,
+      iter, fetched_rows, row_count_limit, scan_time_exceeded || size_limit_exceeded, scan_schema,
       read_time, has_paging_state));
   return fetched_rows;
 }
@@ -1067,20 +1084,41 @@ Result<size_t> PgsqlReadOperation::ExecuteBatchYbctid(const YQLStorageIf& ql_sto
 
   QLTableRow row;
   size_t row_count = 0;
-  for (const PgsqlBatchArgumentPB& batch_argument : request_.batch_arguments()) {
-    // Get the row.
-    RETURN_NOT_OK(ql_storage.GetIterator(request_.stmt_id(), projection, schema, txn_op_context_,
-                                         deadline, read_time, batch_argument.ybctid().value(),
-                                         &table_iter_));
+  const auto min_keys_for_shared_iterator =
+      GetAtomicFlag(&FLAGS_ysql_batch_ybctid_shared_iterator_min_keys);
+  if (min_keys_for_shared_iterator >= 0 &&
+      request_.batch_arguments_size() >= min_keys_for_shared_iterator) {
+    // Creating an iterator per ybctid is expensive for big batches, i.e. index lookups that fetch
+    // thousands of rows from the base table. So create single iterator and seek it to each ybctid.
+    RETURN_NOT_OK(ql_storage.CreateIterator(
+        projection, schema, txn_op_context_, deadline, read_time, &table_iter_));
+    for (const PgsqlBatchArgumentPB& batch_argument : request_.batch_arguments()) {
+      if (VERIFY_RESULT(table_iter_->SeekTuple(batch_argument.ybctid().value().binary_value()))) {
+        row.Clear();
+        RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
+
+        // Populate result set.
+        RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
+        response_.add_batch_orders(batch_argument.order());
+        row_count++;
+      }
+    }
+  } else {
+    for (const PgsqlBatchArgumentPB& batch_argument : request_.batch_arguments()) {
+      // Get the row.
+      RETURN_NOT_OK(ql_storage.GetIterator(request_.stmt_id(), projection, schema,
+                                           txn_op_context_, deadline, read_time,
+                                           batch_argument.ybctid().value(), &table_iter_));
 
-    if (VERIFY_RESULT(table_iter_->HasNext())) {
-      row.Clear();
-      RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
+      if (VERIFY_RESULT(table_iter_->HasNext())) {
+        row.Clear();
+        RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
 
-      // Populate result set.
-      RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
-      response_.add_batch_orders(batch_argument.order());
-      row_count++;
+        // Populate result set.
+        RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
+        response_.add_batch_orders(batch_argument.order());
+        row_count++;
+      }
     }
   }
 
@@ -195,7 +195,8 @@ class PgsqlReadOperation : public DocExprExecutor {
                                    faststring *result_buffer);
 
   // Checks whether we have processed enough rows for a page and sets the appropriate paging
-  // state in the response object.
+  // state in the response object. scan_time_exceeded should be true when scan was stopped before
+  // reaching row_count_limit, because of time or page size limit.
   CHECKED_STATUS SetPagingStateIfNecessary(const YQLRowwiseIteratorIf* iter,
                                            size_t fetched_rows,
                                            const size_t row_count_limit,
@@ -109,6 +109,7 @@ Status QLRocksDBStorage::CreateIterator(const Schema& projection,
                                         YQLRowwiseIteratorIf::UniPtr* iter) const {
   auto doc_iter = std::make_unique<DocRowwiseIterator>(
       projection, schema, txn_op_context, doc_db_, deadline, read_time);
+  RETURN_NOT_OK(doc_iter->Init(TableType::PGSQL_TABLE_TYPE));
   *iter = std::move(doc_iter);
   return Status::OK();
 }
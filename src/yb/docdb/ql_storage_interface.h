@@ -68,6 +68,9 @@ class YQLStorageIf {
   // - Create and init can be used to create iterator once and initialize with different ybctid for
   //   different execution.
   // - Doc_key needs to be changed to allow reusing iterator.
+  //
+  // Iterator returned by CreateIterator covers the whole table, so it could be reused to read rows
+  // by ybctid using SeekTuple.
   virtual CHECKED_STATUS CreateIterator(const Schema& projection,
                                         const Schema& schema,
                                         const TransactionOperationContext& txn_op_context,
@@ -13,6 +13,8 @@
 
 #include <chrono>
 #include <regex>
+#include <thread>
+#include <unordered_set>
 
 #include "yb/client/table.h"
 
@@ -28,6 +30,7 @@
 #include "yb/rpc/rpc_fwd.h"
 
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/tablet_peer.h"
 
 #include "yb/tserver/mini_tablet_server.h"
@@ -43,8 +46,12 @@
 using namespace std::literals;
 
 DECLARE_bool(flush_rocksdb_on_shutdown);
+DECLARE_bool(TEST_pretend_memory_exceeded_enforce_flush);
 DECLARE_int64(global_memstore_size_percentage);
 DECLARE_int64(global_memstore_size_mb_max);
+DECLARE_int32(memstore_flush_max_parallel_tablets);
+DECLARE_int32(memstore_flush_max_small_memtables_per_round);
+DECLARE_int32(memstore_flush_small_memtable_min_age_sec);
 DECLARE_int32(memstore_size_mb);
 DECLARE_int32(rocksdb_level0_file_num_compaction_trigger);
 DECLARE_int32(rocksdb_max_background_flushes);
@@ -240,6 +247,28 @@ class FlushITest : public YBTest {
 
   void TestFlushPicksOldestInactiveTabletAfterCompaction(bool with_restart);
 
+  // Runs a single round of global memstore limit enforcement, as if the limit was exceeded, and
+  // returns tablets that flushes were started for.
+  std::vector<TabletId> RunFlushRound() {
+    const auto flushed_before = tablet_manager_listener_->GetFlushedTablets().size();
+    FLAGS_TEST_pretend_memory_exceeded_enforce_flush = true;
+    cluster_->GetTabletManager(0)->tablet_memory_manager()->FlushTabletIfLimitExceeded();
+    FLAGS_TEST_pretend_memory_exceeded_enforce_flush = false;
+    auto flushed = tablet_manager_listener_->GetFlushedTablets();
+    flushed.erase(flushed.begin(), flushed.begin() + flushed_before);
+    return flushed;
+  }
+
+  std::unordered_set<TabletId> TabletsOfTable(const client::YBTableName& table_name) {
+    std::unordered_set<TabletId> result;
+    for (auto& peer : cluster_->GetTabletPeers(0)) {
+      if (peer->tablet()->metadata()->table_name() == table_name.table_name()) {
+        result.insert(peer->tablet_id());
+      }
+    }
+    return result;
+  }
+
   const int32_t kServerLimitMB = 2;
   // Used to set memstore limit to value higher than server limit, so flushes are only being
   // triggered by memory monitor which we want to test.
@@ -265,6 +294,8 @@ TEST_F(FlushITest, TestFlushHappens) {
 }
 
 void FlushITest::TestFlushPicksOldestInactiveTabletAfterCompaction(bool with_restart) {
+  // Treat all small memtables of inactive tablets as idle, so they are flushed oldest first.
+  FLAGS_memstore_flush_small_memtable_min_age_sec = 0;
   // Trigger compaction early.
   FLAGS_rocksdb_level0_file_num_compaction_trigger = 2;
 
@@ -381,5 +412,51 @@ TEST_F(FlushITest, TestFlushPicksOldestInactiveTabletAfterCompactionWithRestart)
   TestFlushPicksOldestInactiveTabletAfterCompaction(true /* with_restart */);
 }
 
+// Small idle memtables of all tablets are flushed in a single round, while the number of other
+// memtables flushed in a round is limited.
+TEST_F(FlushITest, TestFlushScoringSingleRound) {
+  FLAGS_memstore_flush_small_memtable_min_age_sec = 0;
+  WriteAtLeast(kServerLimitMB * 1_MB / 8);
+  const auto tablets = TabletsOfTable(TestWorkloadOptions::kDefaultTableName);
+  ASSERT_EQ(tablets.size(), static_cast<size_t>(kNumTablets));
+
+  auto flushed = RunFlushRound();
+  ASSERT_EQ(std::unordered_set<TabletId>(flushed.begin(), flushed.end()), tablets);
+  ASSERT_EQ(flushed.size(), tablets.size());
+
+  ASSERT_OK(LoggedWaitFor(
+      [this] { return NumRunningFlushes() == 0; }, 30s, "Waiting for flushes to complete ...",
+      kWaitDelay));
+
+  FLAGS_memstore_flush_max_small_memtables_per_round = 0;
+  FLAGS_memstore_flush_max_parallel_tablets = 1;
+  WriteAtLeast(BytesWritten() + kServerLimitMB * 1_MB / 8);
+  flushed = RunFlushRound();
+  // Memory limit is not actually exceeded, so flushing the best scored memtable is enough.
+  ASSERT_EQ(flushed.size(), 1U);
+  ASSERT_EQ(tablets.count(flushed[0]), 1U);
+}
+
+// Memtable that holds more memory and is not being written to anymore, is flushed before the one
+// that has just started to fill.
+TEST_F(FlushITest, TestFlushScoringPrefersLargerIdleMemtable) {
+  FLAGS_memstore_flush_small_memtable_min_age_sec = 3600;
+  FLAGS_memstore_flush_max_parallel_tablets = 1;
+
+  WriteAtLeast(kServerLimitMB * 1_MB / 4);
+  const auto large_tablets = TabletsOfTable(TestWorkloadOptions::kDefaultTableName);
+  std::this_thread::sleep_for(1s);
+
+  const auto small_table_name = GetTableName(1);
+  SetupWorkload(small_table_name);
+  WriteAtLeast(kServerLimitMB * 1_MB / 64);
+  ASSERT_EQ(TabletsOfTable(small_table_name).size(), static_cast<size_t>(kNumTablets));
+
+  auto flushed = RunFlushRound();
+  ASSERT_EQ(flushed.size(), 1U);
+  ASSERT_EQ(large_tablets.count(flushed[0]), 1U)
+      << "Flushed tablet " << flushed[0] << " of recently written table";
+}
+
 } // namespace tserver
 } // namespace yb
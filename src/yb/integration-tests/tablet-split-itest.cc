@@ -12,10 +12,13 @@
 //
 
 #include <chrono>
+#include <future>
+#include <set>
 #include <thread>
 
 #include <gtest/gtest.h>
 
+#include "yb/client/meta_cache.h"
 #include "yb/client/table.h"
 
 #include "yb/common/entity_ids_types.h"
@@ -780,6 +783,52 @@ TEST_F(TabletSplitITest, DifferentYBTableInstances) {
   ASSERT_EQ(rows_count, kNumRows);
 }
 
+// Checks that refresh of stale partitions puts locations of split children into the meta cache, so
+// lookups of the children do not go to master.
+TEST_F(TabletSplitITest, RefreshPartitionsWarmsUpMetaCache) {
+  constexpr auto kNumRows = kDefaultNumRows;
+  const auto kLookupTimeout = 10s * kTimeMultiplier;
+
+  CreateSingleTablet();
+
+  // Separate client, whose meta cache is not updated by the split validation below.
+  auto client = ASSERT_RESULT(cluster_->CreateClient());
+  client::TableHandle table;
+  ASSERT_OK(table.Open(client::kTableName, client.get()));
+  auto parent = ASSERT_RESULT(client->LookupTabletByKeyFuture(
+      table.table(), /* partition_key = */ "", CoarseMonoClock::now() + kLookupTimeout).get());
+
+  const auto split_hash_code = ASSERT_RESULT(WriteRowsAndGetMiddleHashCode(kNumRows));
+  const auto source_tablet_id = ASSERT_RESULT(SplitTabletAndValidate(split_hash_code, kNumRows));
+  ASSERT_EQ(parent->tablet_id(), source_tablet_id);
+  ASSERT_OK(WaitForTabletSplitCompletion(/* expected_non_split_tablets =*/ 2));
+
+  table->MarkPartitionsAsStale();
+  std::promise<Status> refresh_promise;
+  table->RefreshPartitions(client.get(), [&refresh_promise](const Status& status) {
+    refresh_promise.set_value(status);
+  });
+  ASSERT_OK(refresh_promise.get_future().get());
+  const auto partitions = table->GetVersionedPartitions();
+  ASSERT_EQ(partitions->keys.size(), 2);
+
+  const auto lookup_serial_start = client::internal::TEST_GetLookupSerial();
+  std::set<TabletId> children;
+  for (const auto& partition_key : partitions->keys) {
+    auto tablet = ASSERT_RESULT(client->LookupTabletByKeyFuture(
+        table.table(), partition_key, CoarseMonoClock::now() + kLookupTimeout).get());
+    ASSERT_NE(tablet->tablet_id(), source_tablet_id);
+    ASSERT_EQ(tablet->partition().partition_key_start(), partition_key);
+    children.insert(tablet->tablet_id());
+  }
+  ASSERT_EQ(children.size(), 2);
+  ASSERT_EQ(client::internal::TEST_GetLookupSerial(), lookup_serial_start);
+
+  auto session = client->NewSession();
+  session->SetTimeout(60s * kTimeMultiplier);
+  ASSERT_EQ(ASSERT_RESULT(SelectRowsCount(session, table)), kNumRows);
+}
+
 TEST_F(TabletSplitITest, SplitSingleTabletLongTransactions) {
   constexpr auto kNumRows = 1000;
   constexpr auto kNumApplyLargeTxnBatches = 10;
@@ -38,6 +38,7 @@
 
 #include <stdint.h>
 
+#include <functional>
 #include <memory>
 
 #include "yb/rocksdb/statistics.h"
@@ -68,6 +69,15 @@ extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits);
 extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                                      bool strict_capacity_limit);
 
+// Create a new cache with the same sharding and capacity semantics as NewLRUCache, but using the
+// CLOCK eviction policy. Lookups do not take the shard mutex exclusively and do not reorder any
+// lists, so this cache scales better under concurrent read-heavy load. The single-touch/multi-touch
+// split is preserved, entries are promoted to multi-touch lazily, when the clock hand reaches them.
+extern shared_ptr<Cache> NewClockCache(size_t capacity);
+extern shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits);
+extern shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits,
+                                       bool strict_capacity_limit);
+
 using QueryId = int64_t;
 // Query ids to represent values for the default query id.
 constexpr QueryId kDefaultQueryId = 0;
@@ -76,6 +86,11 @@ constexpr QueryId kInMultiTouchId = -1;
 // Query ids to represent values that should not be in any cache.
 constexpr QueryId kNoCacheQueryId = -2;
 
+// Invoked for each entry that is evicted from the cache to free space, right before its deleter.
+// Entries removed by Erase or replaced by Insert are not reported.
+using CacheEvictionListener = std::function<void(
+    const Slice& key, void* value, void (*deleter)(const Slice& key, void* value))>;
+
 class Cache {
  public:
   Cache() { }
@@ -191,6 +206,10 @@ class Cache {
   // Tries to evict specified amount of bytes from cache.
   virtual size_t Evict(size_t required) { return 0; }
 
+  // Sets listener that is notified about evicted entries, could be used to admit them to the
+  // secondary cache tier. Should be called before the cache is used.
+  virtual void SetEvictionListener(CacheEvictionListener listener) {}
+
   // Returns the single-touch and multi-touch cache usages for each of the shard.
   virtual std::vector<std::pair<size_t, size_t>> TEST_GetIndividualUsages() = 0;
 
@@ -164,6 +164,13 @@ class CompactionFilterFactory {
   virtual std::unique_ptr<CompactionFilter> CreateCompactionFilter(
       const CompactionFilter::Context& context) = 0;
 
+  // Subcompactions of the same compaction are processed by different compaction filters.
+  // Returns the key that should be used as a boundary between subcompactions instead of the
+  // candidate user_key, so that keys that have to be processed by the same filter are never split
+  // between subcompactions. The result should be less than or equal to user_key and point into
+  // user_key memory. Empty result means that no boundary could be placed at user_key.
+  virtual Slice SubcompactionBoundary(const Slice& user_key) const { return user_key; }
+
   // Returns a name that identifies this compaction filter factory.
   virtual const char* Name() const = 0;
 };
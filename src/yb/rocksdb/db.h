@@ -881,6 +881,24 @@ class DB {
     return AddFile(DefaultColumnFamily(), file_info, move_file);
   }
 
+  // Same as above, but allow_overlap skips requirement (1). It could be used only when the same
+  // user key is never written with different values, for instance when user keys contain unique
+  // write time.
+  virtual Status AddFile(ColumnFamilyHandle* column_family,
+                         const ExternalSstFileInfo* file_info,
+                         bool move_file,
+                         bool allow_overlap) {
+    if (allow_overlap) {
+      return STATUS(NotSupported, "Adding file with overlapping key range is not supported");
+    }
+    return AddFile(column_family, file_info, move_file);
+  }
+  virtual Status AddFile(const ExternalSstFileInfo* file_info,
+                         bool move_file,
+                         bool allow_overlap) {
+    return AddFile(DefaultColumnFamily(), file_info, move_file, allow_overlap);
+  }
+
 #endif  // ROCKSDB_LITE
 
   // Sets the globally unique ID created at database creation time by invoking
@@ -591,7 +591,9 @@ bool Compaction::ShouldFormSubcompactions() const {
   if (cfd_->ioptions()->compaction_style == kCompactionStyleLevel) {
     return start_level_ == 0 && !IsOutputLevelEmpty();
   } else if (IsCompactionStyleUniversal()) {
-    return number_levels_ > 1 && output_level_ > 0;
+    // With a single level the output goes to level 0. Subcompactions produce several non
+    // overlapping files there, which CompactionJob installs as a single sorted run.
+    return number_levels_ == 1 || output_level_ > 0;
   } else {
     return false;
   }
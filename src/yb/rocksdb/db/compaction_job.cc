@@ -33,6 +33,8 @@
 #include <algorithm>
 #include <cmath>
 #include <functional>
+#include <iterator>
+#include <limits>
 #include <list>
 #include <memory>
 #include <set>
@@ -51,6 +53,7 @@
 #include "yb/rocksdb/db/memtable.h"
 #include "yb/rocksdb/db/memtable_list.h"
 #include "yb/rocksdb/db/merge_helper.h"
+#include "yb/rocksdb/db/table_cache.h"
 #include "yb/rocksdb/db/version_set.h"
 #include "yb/rocksdb/port/likely.h"
 #include "yb/rocksdb/port/port.h"
@@ -61,6 +64,7 @@
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/table/internal_iterator.h"
 #include "yb/rocksdb/table/table_builder.h"
+#include "yb/rocksdb/table/table_reader.h"
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/log_buffer.h"
@@ -72,12 +76,30 @@
 #include "yb/util/stats/perf_step_timer.h"
 #include "yb/rocksdb/util/sync_point.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/result.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/stats/iostats_context_imp.h"
 #include "yb/util/string_util.h"
 
+using namespace yb::size_literals;
+
+DEFINE_uint64(rocksdb_min_subcompaction_size_bytes, 1_GB,
+              "Minimal amount of input data per subcompaction, when compaction output files are "
+              "not limited in size, i.e. for single level universal compactions.");
+TAG_FLAG(rocksdb_min_subcompaction_size_bytes, runtime);
+TAG_FLAG(rocksdb_min_subcompaction_size_bytes, advanced);
+
 namespace rocksdb {
 
+namespace {
+
+// Number of keys sampled from each input file per subcompaction, used to find subcompaction
+// boundaries when input files cover the whole key range.
+constexpr size_t kSplitKeysPerSubcompaction = 4;
+
+} // namespace
+
 // Maintains state for each sub-compaction
 struct CompactionJob::SubcompactionState {
   Compaction* compaction;
@@ -122,6 +144,8 @@ struct CompactionJob::SubcompactionState {
   uint64_t num_output_records;
   CompactionJobStats compaction_job_stats;
   uint64_t approx_size;
+  // Largest user frontier provided by the compaction filter of this subcompaction.
+  UserFrontierPtr largest_user_frontier;
 
   SubcompactionState(Compaction* c, Slice* _start, Slice* _end,
                      uint64_t size = 0)
@@ -154,6 +178,7 @@ struct CompactionJob::SubcompactionState {
     num_output_records = std::move(o.num_output_records);
     compaction_job_stats = std::move(o.compaction_job_stats);
     approx_size = std::move(o.approx_size);
+    largest_user_frontier = std::move(o.largest_user_frontier);
     return *this;
   }
 
@@ -372,6 +397,13 @@ void CompactionJob::GenSubcompactionBoundaries() {
     }
   }
 
+  if (c->number_levels() == 1 &&
+      c->CalculateTotalInputSize() >= 2 * FLAGS_rocksdb_min_subcompaction_size_bytes) {
+    // All files are sorted runs covering the whole key range, so their smallest and largest keys
+    // are not enough to split the compaction.
+    AddInputFilesSplitKeys(&bounds);
+  }
+
   std::sort(bounds.begin(), bounds.end(),
     [cfd_comparator] (const Slice& a, const Slice& b) -> bool {
       return cfd_comparator->Compare(ExtractUserKey(a), ExtractUserKey(b)) < 0;
@@ -403,9 +435,17 @@ void CompactionJob::GenSubcompactionBoundaries() {
 
   // Group the ranges into subcompactions
   const double min_file_fill_percent = 4.0 / 5;
-  uint64_t max_output_files = static_cast<uint64_t>(std::ceil(
-      sum / min_file_fill_percent /
-      cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl)));
+  const auto max_output_file_size =
+      cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl);
+  uint64_t max_output_files;
+  if (max_output_file_size == std::numeric_limits<uint64_t>::max()) {
+    // There is no limit on output file size, so use the subcompaction size limit instead.
+    max_output_files = std::max<uint64_t>(
+        sum / std::max<uint64_t>(FLAGS_rocksdb_min_subcompaction_size_bytes, 1), 1);
+  } else {
+    max_output_files = static_cast<uint64_t>(std::ceil(
+        sum / min_file_fill_percent / max_output_file_size));
+  }
   uint64_t subcompactions =
       std::min({static_cast<uint64_t>(ranges.size()),
                 static_cast<uint64_t>(db_options_.max_subcompactions),
@@ -414,6 +454,11 @@ void CompactionJob::GenSubcompactionBoundaries() {
   double mean = subcompactions != 0 ? sum * 1.0 / subcompactions
                                     : std::numeric_limits<double>::max();
 
+  // When a compaction filter is created by the factory, each subcompaction gets its own filter
+  // instance, so the factory decides where boundaries could be placed.
+  const auto* filter_factory = cfd->ioptions()->compaction_filter == nullptr
+      ? cfd->ioptions()->compaction_filter_factory : nullptr;
+
   if (subcompactions > 1) {
     // Greedily add ranges to the subcompaction until the sum of the ranges'
     // sizes becomes >= the expected mean size of a subcompaction
@@ -426,7 +471,17 @@ void CompactionJob::GenSubcompactionBoundaries() {
         continue;
       }
       if (sum >= mean) {
-        boundaries_.emplace_back(ExtractUserKey(ranges[i].range.limit));
+        auto boundary = ExtractUserKey(ranges[i].range.limit);
+        if (filter_factory) {
+          boundary = filter_factory->SubcompactionBoundary(boundary);
+          // Boundary should not be empty and should be strictly increasing after adjustment.
+          if (boundary.empty() ||
+              (!boundaries_.empty() &&
+               cfd_comparator->Compare(boundary, boundaries_.back()) <= 0)) {
+            continue;
+          }
+        }
+        boundaries_.emplace_back(boundary);
         sizes_.emplace_back(sum);
         subcompactions--;
         sum = 0;
@@ -439,6 +494,37 @@ void CompactionJob::GenSubcompactionBoundaries() {
   }
 }
 
+void CompactionJob::AddInputFilesSplitKeys(std::vector<Slice>* bounds) {
+  auto* c = compact_->compaction;
+  auto* cfd = c->column_family_data();
+  const size_t keys_per_file = db_options_.max_subcompactions * kSplitKeysPerSubcompaction;
+  for (size_t lvl_idx = 0; lvl_idx < c->num_input_levels(); lvl_idx++) {
+    const LevelFilesBrief* flevel = c->input_levels(lvl_idx);
+    for (size_t i = 0; i < flevel->num_files; i++) {
+      const auto& fd = flevel->files[i].fd;
+      auto split_keys = [&]() -> Result<std::vector<std::string>> {
+        const auto trwh = VERIFY_RESULT(cfd->table_cache()->GetTableReader(
+            env_options_, cfd->internal_comparator(), fd, kDefaultQueryId, /* no_io =*/ false,
+            /* file_read_hist =*/ nullptr, /* skip_filters =*/ true));
+        return trwh.table_reader->GetSplitKeys(keys_per_file);
+      }();
+      if (!split_keys.ok()) {
+        RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+            "[%s] [JOB %d] Failed to get split keys of file %" PRIu64 ": %s",
+            cfd->GetName().c_str(), job_id_, fd.GetNumber(),
+            split_keys.status().ToString().c_str());
+        continue;
+      }
+      std::move(split_keys->begin(), split_keys->end(),
+                std::back_inserter(input_files_split_keys_));
+    }
+  }
+  // Slices are added after all keys are collected, since vector could reallocate its strings.
+  for (const auto& key : input_files_split_keys_) {
+    bounds->emplace_back(key);
+  }
+}
+
 Result<FileNumbersHolder> CompactionJob::Run() {
   TEST_SYNC_POINT("CompactionJob::Run():Start");
   log_buffer_->FlushBufferToLog();
@@ -483,6 +569,13 @@ Result<FileNumbersHolder> CompactionJob::Run() {
     }
   }
 
+  for (const auto& state : compact_->sub_compact_states) {
+    if (state.largest_user_frontier) {
+      UpdateUserFrontier(
+          &largest_user_frontier_, state.largest_user_frontier, UpdateUserValueType::kLargest);
+    }
+  }
+
   TablePropertiesCollection tp;
   for (const auto& state : compact_->sub_compact_states) {
     for (const auto& output : state.outputs) {
@@ -610,7 +703,7 @@ void CompactionJob::ProcessKeyValueCompaction(
   if (compaction_filter) {
     // This is used to persist the history cutoff hybrid time chosen for the DocDB compaction
     // filter.
-    largest_user_frontier_ = compaction_filter->GetLargestUserFrontier();
+    sub_compact->largest_user_frontier = compaction_filter->GetLargestUserFrontier();
   }
 
   MergeHelper merge(
@@ -921,9 +1014,26 @@ Status CompactionJob::InstallCompactionResults(
   // Add compaction outputs
   compaction->AddInputDeletions(compaction->edit());
 
+  // Several level 0 outputs of the same compaction do not overlap, so they are installed as a
+  // single sorted run identified by the number of its first file.
+  uint64_t sorted_run_id = 0;
+  if (compaction->output_level() == 0 && compact_->NumOutputFiles() > 1) {
+    for (const auto& sub_compact : compact_->sub_compact_states) {
+      if (!sub_compact.outputs.empty()) {
+        sorted_run_id = sub_compact.outputs.front().meta.fd.GetNumber();
+        break;
+      }
+    }
+  }
   for (const auto& sub_compact : compact_->sub_compact_states) {
     for (const auto& out : sub_compact.outputs) {
-      compaction->edit()->AddFile(compaction->output_level(), out.meta);
+      if (sorted_run_id == 0) {
+        compaction->edit()->AddFile(compaction->output_level(), out.meta);
+      } else {
+        auto meta = out.meta;
+        meta.sorted_run_id = sorted_run_id;
+        compaction->edit()->AddFile(compaction->output_level(), meta);
+      }
     }
   }
   if (largest_user_frontier_) {
@@ -105,6 +105,8 @@ class CompactionJob {
 
   void AggregateStatistics();
   void GenSubcompactionBoundaries();
+  // Adds keys splitting input files of a single level compaction to bounds.
+  void AddInputFilesSplitKeys(std::vector<Slice>* bounds);
 
   // update the thread status for starting a compaction.
   void ReportStartedCompaction(Compaction* compaction);
@@ -178,6 +180,8 @@ class CompactionJob {
   bool measure_io_stats_;
   // Stores the Slices that designate the boundaries for each subcompaction
   std::vector<Slice> boundaries_;
+  // Stores keys sampled from input files, that are referenced by boundaries_.
+  std::vector<std::string> input_files_split_keys_;
   // Stores the approx size of keys covered in the range of each subcompaction
   std::vector<uint64_t> sizes_;
 
@@ -485,6 +485,21 @@ void CompactionPicker::MarkL0FilesForDeletion(
   }
 }
 
+uint32_t CompactionPicker::AdjustOutputPathId(
+    const std::vector<CompactionInputFiles>& inputs, uint32_t path_id) const {
+  if (!ioptions_.cold_compaction_output || ioptions_.db_paths.size() < 2) {
+    return path_id;
+  }
+  std::vector<FileMetaData*> input_files;
+  for (const auto& level_inputs : inputs) {
+    input_files.insert(input_files.end(), level_inputs.files.begin(), level_inputs.files.end());
+  }
+  if (input_files.empty() || !(*ioptions_.cold_compaction_output)(input_files)) {
+    return path_id;
+  }
+  return static_cast<uint32_t>(ioptions_.db_paths.size() - 1);
+}
+
 std::unique_ptr<Compaction> CompactionPicker::CompactRange(
     const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
     VersionStorageInfo* vstorage, int input_level, int output_level,
@@ -535,6 +550,7 @@ std::unique_ptr<Compaction> CompactionPicker::CompactRange(
         return nullptr;
       }
     }
+    output_path_id = AdjustOutputPathId(inputs, output_path_id);
     auto c = Compaction::Create(
         vstorage, mutable_cf_options, std::move(inputs), output_level,
         mutable_cf_options.MaxFileSizeForLevel(output_level),
@@ -1184,16 +1200,16 @@ bool UniversalCompactionPicker::NeedsCompaction(
 }
 
 struct UniversalCompactionPicker::SortedRun {
-  SortedRun(int _level, FileMetaData* _file, uint64_t _size,
+  SortedRun(int _level, std::vector<FileMetaData*> _files, uint64_t _size,
             uint64_t _compensated_file_size, bool _being_compacted)
       : level(_level),
-        file(_file),
+        files(std::move(_files)),
         size(_size),
         compensated_file_size(_compensated_file_size),
         being_compacted(_being_compacted) {
     assert(compensated_file_size > 0);
-    // Allowed either one of level and file.
-    assert((level != 0) != (file != nullptr));
+    // Allowed either one of level and files.
+    assert((level != 0) != !files.empty());
   }
 
   void Dump(char* out_buf, size_t out_buf_size,
@@ -1210,16 +1226,24 @@ struct UniversalCompactionPicker::SortedRun {
   }
 
   bool delete_after_compaction() const {
-    return file ? file->delete_after_compaction : false;
+    if (files.empty()) {
+      return false;
+    }
+    for (auto* file : files) {
+      if (!file->delete_after_compaction) {
+        return false;
+      }
+    }
+    return true;
   }
 
   int level;
-  // `file` Will be null for level > 0. For level = 0, the sorted run is
-  // for this file.
-  FileMetaData* file;
-  // For level > 0, `size` and `compensated_file_size` are sum of sizes all
-  // files in the level. `being_compacted` should be the same for all files
-  // in a non-zero level. Use the value here.
+  // `files` will be empty for level > 0. For level = 0, the sorted run is for these files,
+  // usually a single one. Several files are only present when a compaction wrote its level 0
+  // output as a few non overlapping files, see FileMetaData::sorted_run_id.
+  std::vector<FileMetaData*> files;
+  // `size` and `compensated_file_size` are sum of sizes of all files in the sorted run.
+  // `being_compacted` should be the same for all files in a non-zero level. Use the value here.
   uint64_t size;
   uint64_t compensated_file_size;
   bool being_compacted;
@@ -1229,8 +1253,12 @@ void UniversalCompactionPicker::SortedRun::Dump(char* out_buf,
                                                 size_t out_buf_size,
                                                 bool print_path) const {
   if (level == 0) {
-    assert(file != nullptr);
-    if (file->fd.GetPathId() == 0 || !print_path) {
+    assert(!files.empty());
+    auto* file = files.front();
+    if (files.size() > 1) {
+      snprintf(out_buf, out_buf_size, "files %" PRIu64 "(+%" ROCKSDB_PRIszt ")",
+               file->fd.GetNumber(), files.size() - 1);
+    } else if (file->fd.GetPathId() == 0 || !print_path) {
       snprintf(out_buf, out_buf_size, "file %" PRIu64, file->fd.GetNumber());
     } else {
       snprintf(out_buf, out_buf_size, "file %" PRIu64
@@ -1246,13 +1274,12 @@ void UniversalCompactionPicker::SortedRun::Dump(char* out_buf,
 void UniversalCompactionPicker::SortedRun::DumpSizeInfo(
     char* out_buf, size_t out_buf_size, size_t sorted_run_count) const {
   if (level == 0) {
-    assert(file != nullptr);
+    assert(!files.empty());
     snprintf(out_buf, out_buf_size,
              "file %" PRIu64 "[%" ROCKSDB_PRIszt
              "] "
              "with size %" PRIu64 " (compensated size %" PRIu64 ")",
-             file->fd.GetNumber(), sorted_run_count, file->fd.GetTotalFileSize(),
-             file->compensated_file_size);
+             files.front()->fd.GetNumber(), sorted_run_count, size, compensated_file_size);
   } else {
     snprintf(out_buf, out_buf_size,
              "level %d[%" ROCKSDB_PRIszt
@@ -1269,12 +1296,42 @@ std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
   std::vector<std::vector<SortedRun>> ret(1);
   MarkL0FilesForDeletion(&vstorage, &ioptions);
 
+  // Consecutive level 0 files with the same sorted run id are a single sorted run.
+  std::vector<std::vector<FileMetaData*>> level0_runs;
   for (FileMetaData* f : vstorage.LevelFiles(0)) {
+    if (f->sorted_run_id == 0 || level0_runs.empty() ||
+        level0_runs.back().back()->sorted_run_id != f->sorted_run_id) {
+      level0_runs.emplace_back();
+    }
+    level0_runs.back().push_back(f);
+  }
+
+  int64_t last_time_window = 0;
+  for (auto& files : level0_runs) {
+    uint64_t total_size = 0;
+    uint64_t total_compensated_size = 0;
+    bool being_compacted = false;
+    bool delete_after_compaction = true;
+    for (FileMetaData* f : files) {
+      total_size += f->fd.GetTotalFileSize();
+      total_compensated_size += f->compensated_file_size;
+      being_compacted = being_compacted || f->being_compacted;
+      delete_after_compaction = delete_after_compaction && f->delete_after_compaction;
+    }
     // Any files that can be directly removed during compaction can be included, even if they
     // exceed the "max file size for compaction."
-    if (f->fd.GetTotalFileSize() <= max_file_size || f->delete_after_compaction) {
-      ret.back().emplace_back(0, f, f->fd.GetTotalFileSize(), f->compensated_file_size,
-          f->being_compacted);
+    if (total_size <= max_file_size || delete_after_compaction) {
+      // Files from different time windows are never compacted together, so start new sequence
+      // when time window changes.
+      if (ioptions.compaction_time_window) {
+        const auto time_window = (*ioptions.compaction_time_window)(*files.front());
+        if (!ret.back().empty() && time_window != last_time_window) {
+          ret.emplace_back();
+        }
+        last_time_window = time_window;
+      }
+      ret.back().emplace_back(
+          0, std::move(files), total_size, total_compensated_size, being_compacted);
     // If last sequence is empty it means that there are multiple too-large-to-compact files in
     // a row. So we just don't start new sequence in this case.
     } else if (!ret.back().empty()) {
@@ -1308,7 +1365,9 @@ std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
       }
     }
     if (total_compensated_size > 0) {
-      ret.back().emplace_back(level, nullptr, total_size, total_compensated_size, being_compacted);
+      ret.back().emplace_back(
+          level, std::vector<FileMetaData*>(), total_size, total_compensated_size,
+          being_compacted);
     }
   }
 
@@ -1759,8 +1818,8 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
   for (size_t i = start_index; i < first_index_after; i++) {
     auto& picking_sr = sorted_runs[i];
     if (picking_sr.level == 0) {
-      FileMetaData* picking_file = picking_sr.file;
-      inputs[0].files.push_back(picking_file);
+      inputs[0].files.insert(
+          inputs[0].files.end(), picking_sr.files.begin(), picking_sr.files.end());
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
@@ -1779,6 +1838,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
   } else {
     compaction_reason = CompactionReason::kUniversalSizeRatio;
   }
+  path_id = AdjustOutputPathId(inputs, path_id);
   return Compaction::Create(
       vstorage, mutable_cf_options, std::move(inputs), output_level,
       mutable_cf_options.MaxFileSizeForLevel(output_level), LLONG_MAX, path_id,
@@ -1812,8 +1872,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalDe
     const auto sr = &sorted_runs[loop];
 
     if (!sr->being_compacted && sr->delete_after_compaction()) {
-      FileMetaData* f = sr->file;
-      input_files.files.push_back(f);
+      input_files.files.insert(input_files.files.end(), sr->files.begin(), sr->files.end());
 
       char file_num_buf[kFormatFileSizeInfoBufSize];
       sr->DumpSizeInfo(file_num_buf, sizeof(file_num_buf), loop);
@@ -1950,8 +2009,8 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
   for (size_t loop = start_index; loop < sorted_runs.size(); loop++) {
     auto& picking_sr = sorted_runs[loop];
     if (picking_sr.level == 0) {
-      FileMetaData* f = picking_sr.file;
-      inputs[0].files.push_back(f);
+      inputs[0].files.insert(
+          inputs[0].files.end(), picking_sr.files.begin(), picking_sr.files.end());
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
@@ -1964,6 +2023,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
                 cf_name.c_str(), file_num_buf);
   }
 
+  path_id = AdjustOutputPathId(inputs, path_id);
   return Compaction::Create(
       vstorage, mutable_cf_options, std::move(inputs), vstorage->num_levels() - 1,
       mutable_cf_options.MaxFileSizeForLevel(vstorage->num_levels() - 1),
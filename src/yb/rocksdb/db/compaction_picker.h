@@ -137,6 +137,11 @@ class CompactionPicker {
  protected:
   int NumberLevels() const { return ioptions_.num_levels; }
 
+  // Returns the last path ID when ioptions_.cold_compaction_output reports that compaction of
+  // specified inputs produces only cold data, otherwise returns path_id.
+  uint32_t AdjustOutputPathId(
+      const std::vector<CompactionInputFiles>& inputs, uint32_t path_id) const;
+
   // Stores the minimal range that covers all entries in inputs in
   // *smallest, *largest.
   // REQUIRES: inputs is not empty
@@ -293,7 +298,8 @@ class UniversalCompactionPicker : public CompactionPicker {
       const std::vector<SortedRun>& sorted_runs, LogBuffer* log_buffer);
 
   // At level 0 we could compact only continuous sequence of files.
-  // Since there could be too-large-to-compact files, we could get several such sequences.
+  // Since there could be too-large-to-compact files or files from different time windows
+  // (see compaction_time_window option), we could get several such sequences.
   // Files from one sequence are compacted together, and files from different sequences are not
   // compacted.
   // One sequence is std::vector<SortedRun>.
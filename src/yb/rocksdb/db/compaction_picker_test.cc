@@ -482,6 +482,43 @@ TEST_F(CompactionPickerTest, CompactionUniversalPickForFilesBeingCompacted) {
   ASSERT_EQ(compaction->inputs(0)->size(), 2);
 }
 
+TEST_F(CompactionPickerTest, CompactionUniversalTimeWindows) {
+  const uint64_t kFileSize = 100000;
+
+  // Files 1-3 belong to the older time window, files 4-6 to the newer one.
+  ioptions_.compaction_time_window = std::make_shared<std::function<int64_t(const FileMetaData&)>>(
+      [](const FileMetaData& file) {
+        return file.fd.GetNumber() <= 3 ? 0 : 1;
+      });
+  ioptions_.compaction_style = kCompactionStyleUniversal;
+  ioptions_.num_levels = 1;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 2;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, icmp_.get());
+
+  NewVersionStorage(1, kCompactionStyleUniversal);
+  for (uint32_t file_number = 6; file_number > 0; --file_number) {
+    Add(0, file_number, "100", "200", kFileSize, 0, file_number * 100, file_number * 100 + 99);
+  }
+  UpdateVersionStorageInfo();
+
+  auto compaction = universal_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_);
+  ASSERT_NE(compaction, nullptr);
+  ASSERT_EQ(compaction->inputs(0)->size(), 3);
+  for (auto* file : *compaction->inputs(0)) {
+    ASSERT_GT(file->fd.GetNumber(), 3);
+  }
+
+  // Newer window is being compacted, so the older one is picked independently.
+  auto older_compaction = universal_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_);
+  ASSERT_NE(older_compaction, nullptr);
+  ASSERT_EQ(older_compaction->inputs(0)->size(), 3);
+  for (auto* file : *older_compaction->inputs(0)) {
+    ASSERT_LE(file->fd.GetNumber(), 3);
+  }
+}
+
 // Tests if the files can be trivially moved in multi level
 // universal compaction when allow_trivial_move option is set
 // In this test as the input files overlaps, they cannot
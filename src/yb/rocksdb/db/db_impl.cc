@@ -4212,6 +4212,11 @@ Status DBImpl::AddFile(ColumnFamilyHandle* column_family,
   return AddFile(column_family, &file_info, move_file);
 }
 
+Status DBImpl::AddFile(ColumnFamilyHandle* column_family,
+                       const ExternalSstFileInfo* file_info, bool move_file) {
+  return AddFile(column_family, file_info, move_file, false /* allow_overlap */);
+}
+
 namespace {
 
 // Helper function for copying file from src_path to dst_path. If try_hard_link is true it tries
@@ -4244,7 +4249,8 @@ void DeleteFile(Env* env, const std::string& path, const shared_ptr<Logger>& inf
 } // namespace
 
 Status DBImpl::AddFile(ColumnFamilyHandle* column_family,
-                       const ExternalSstFileInfo* file_info, bool move_file) {
+                       const ExternalSstFileInfo* file_info, bool move_file,
+                       bool allow_overlap) {
   Status status;
   auto cfh = down_cast<ColumnFamilyHandleImpl*>(column_family);
   ColumnFamilyData* cfd = cfh->cfd();
@@ -4273,6 +4279,10 @@ Status DBImpl::AddFile(ColumnFamilyHandle* column_family,
     return STATUS(InvalidArgument,
         "Non zero sequence numbers are not supported");
   }
+  if (file_info->user_frontiers) {
+    meta.smallest.user_frontier = file_info->user_frontiers->Smallest().Clone();
+    meta.largest.user_frontier = file_info->user_frontiers->Largest().Clone();
+  }
 
   std::string db_base_fname;
   std::string db_data_fname;
@@ -4316,7 +4326,7 @@ Status DBImpl::AddFile(ColumnFamilyHandle* column_family,
             STATUS(NotSupported, "Cannot add a file while holding snapshots");
       }
 
-      if (status.ok()) {
+      if (status.ok() && !allow_overlap) {
         // Verify that added file key range dont overlap with any keys in DB
         SuperVersion* sv = cfd->GetSuperVersion()->Ref();
         Arena arena;
@@ -7469,6 +7469,40 @@ TEST_F(DBTest, AddExternalSstFile) {
                          kSkipFIFOCompaction));
 }
 
+TEST_F(DBTest, AddExternalSstFileAllowOverlap) {
+  std::string sst_files_folder = test::TmpDir(env_) + "/sst_files/";
+  ASSERT_OK(env_->CreateDirIfMissing(sst_files_folder));
+  Options options = CurrentOptions();
+  options.env = env_;
+  DestroyAndReopen(options);
+  const ImmutableCFOptions ioptions(options);
+
+  // Even keys are written through the mem table, odd keys are added with external file.
+  for (int k = 0; k < 100; k += 2) {
+    ASSERT_OK(Put(Key(k), Key(k) + "_val"));
+  }
+
+  SstFileWriter sst_file_writer(EnvOptions(), ioptions, options.comparator);
+  std::string file = sst_files_folder + "file_odd.sst";
+  ASSERT_OK(sst_file_writer.Open(file));
+  for (int k = 1; k < 100; k += 2) {
+    ASSERT_OK(sst_file_writer.Add(Key(k), Key(k) + "_val"));
+  }
+  ExternalSstFileInfo file_info;
+  ASSERT_OK(sst_file_writer.Finish(&file_info));
+
+  ASSERT_NOK(db_->AddFile(&file_info));
+  ASSERT_OK(db_->AddFile(&file_info, false /* move_file */, true /* allow_overlap */));
+
+  for (int i = 0; i < 2; i++) {
+    for (int k = 0; k < 100; k++) {
+      ASSERT_EQ(Get(Key(k)), Key(k) + "_val");
+    }
+    ASSERT_OK(Flush());
+    ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  }
+}
+
 // This test reporduce a bug that can happen in some cases if the DB started
 // purging obsolete files when we are adding an external sst file.
 // This situation may result in deleting the file while it's being added.
@@ -694,15 +694,19 @@ std::string DBHolder::AllEntriesFor(const Slice& user_key, int cf) {
 
 #ifndef ROCKSDB_LITE
 int DBHolder::NumSortedRuns(int cf) {
-  ColumnFamilyMetaData cf_meta;
-  if (cf == 0) {
-    db_->GetColumnFamilyMetaData(&cf_meta);
-  } else {
-    db_->GetColumnFamilyMetaData(handles_[cf], &cf_meta);
+  std::vector<std::vector<FileMetaData>> files;
+  dbfull()->TEST_GetFilesMetaData(cf == 0 ? db_->DefaultColumnFamily() : handles_[cf], &files);
+  int num_sr = 0;
+  uint64_t last_sorted_run_id = 0;
+  // Consecutive level 0 files with the same sorted run id form a single sorted run.
+  for (const auto& f : files[0]) {
+    if (f.sorted_run_id == 0 || f.sorted_run_id != last_sorted_run_id) {
+      num_sr++;
+    }
+    last_sorted_run_id = f.sorted_run_id;
   }
-  int num_sr = static_cast<int>(cf_meta.levels[0].files.size());
-  for (size_t i = 1U; i < cf_meta.levels.size(); i++) {
-    if (cf_meta.levels[i].files.size() > 0) {
+  for (size_t i = 1U; i < files.size(); i++) {
+    if (files[i].size() > 0) {
       num_sr++;
     }
   }
@@ -21,6 +21,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
+#include <set>
+
 #include "yb/rocksdb/db/db_test_util.h"
 #include "yb/rocksdb/db/job_context.h"
 #include "yb/rocksdb/port/stack_trace.h"
@@ -28,6 +30,8 @@
 #include "yb/rocksdb/util/file_util.h"
 #include "yb/rocksdb/util/sync_point.h"
 
+DECLARE_uint64(rocksdb_min_subcompaction_size_bytes);
+
 namespace rocksdb {
 
 static std::string CompressibleString(Random* rnd, int len) {
@@ -1259,6 +1263,59 @@ TEST_P(DBTestUniversalCompactionWithParam, UniversalCompactionSecondPathRatio) {
   Destroy(options);
 }
 
+TEST_P(DBTestUniversalCompactionWithParam, UniversalCompactionColdOutputPath) {
+  std::atomic<bool> cold(false);
+  Options options;
+  options.db_paths.emplace_back(dbname_, std::numeric_limits<uint64_t>::max());
+  options.db_paths.emplace_back(dbname_ + "_cold", std::numeric_limits<uint64_t>::max());
+  options.cold_compaction_output =
+      std::make_shared<std::function<bool(const std::vector<FileMetaData*>&)>>(
+          [&cold](const std::vector<FileMetaData*>&) {
+            return cold.load();
+          });
+  options.compaction_style = kCompactionStyleUniversal;
+  options.write_buffer_size = 110 << 10;  // 105KB
+  options.arena_block_size = 4 << 10;
+  options.level0_file_num_compaction_trigger = 2;
+  options.num_levels = num_levels_;
+  options.memtable_factory.reset(
+      new SpecialSkipListFactory(KNumKeysByGenerateNewFile - 1));
+  options = CurrentOptions(options);
+
+  ASSERT_OK(DeleteRecursively(env_, options.db_paths[1].path));
+  Reopen(options);
+
+  Random rnd(301);
+  int key_idx = 0;
+
+  // Hot compaction output stays in the first path.
+  for (int num = 0; num < 4; num++) {
+    GenerateNewFile(&rnd, &key_idx);
+  }
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_EQ(0, GetSstFileCount(options.db_paths[1].path));
+
+  // Cold compaction output goes to the last path.
+  cold = true;
+  for (int num = 0; num < 4; num++) {
+    GenerateNewFile(&rnd, &key_idx);
+  }
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_GE(GetSstFileCount(options.db_paths[1].path), 1);
+
+  for (int i = 0; i < key_idx; i++) {
+    ASSERT_NE(Get(Key(i)), "NOT_FOUND");
+  }
+
+  Reopen(options);
+
+  for (int i = 0; i < key_idx; i++) {
+    ASSERT_NE(Get(Key(i)), "NOT_FOUND");
+  }
+
+  Destroy(options);
+}
+
 INSTANTIATE_TEST_CASE_P(UniversalCompactionNumLevels, DBTestUniversalCompactionWithParam,
                         ::testing::Combine(::testing::Values(1, 3, 5),
                                            ::testing::Bool()));
@@ -1464,6 +1521,113 @@ TEST_F(DBTestUniversalCompaction, IncludeFilesSmallerThanThreshold) {
   GenerateFilesAndCheckCompactionResult(options, file_sizes, value_size, 1);
 }
 
+namespace {
+
+// Allows subcompaction boundaries only between groups of 10 keys, i.e. keys are kept together
+// when they differ only in the last digit.
+class KeyGroupFilterFactory : public CompactionFilterFactory {
+ public:
+  std::unique_ptr<CompactionFilter> CreateCompactionFilter(
+      const CompactionFilter::Context& context) override {
+    ++num_created_filters;
+    return std::make_unique<KeepFilter>();
+  }
+
+  Slice SubcompactionBoundary(const Slice& user_key) const override {
+    return user_key.Prefix(user_key.size() - 1);
+  }
+
+  const char* Name() const override { return "KeyGroupFilterFactory"; }
+
+  std::atomic<int> num_created_filters{0};
+};
+
+} // namespace
+
+TEST_F(DBTestUniversalCompaction, SingleLevelSubcompactions) {
+  google::FlagSaver flag_saver;
+  FLAGS_rocksdb_min_subcompaction_size_bytes = 1;
+
+  constexpr int kNumFiles = 3;
+  constexpr int kNumKeys = 1000;
+  constexpr int kMaxSubcompactions = 4;
+
+  auto filter_factory = std::make_shared<KeyGroupFilterFactory>();
+  Options options;
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.max_subcompactions = kMaxSubcompactions;
+  options.write_buffer_size = 10_MB;
+  options.disable_auto_compactions = true;
+  options.compaction_filter_factory = filter_factory;
+  options = CurrentOptions(options);
+  DestroyAndReopen(options);
+
+  // Every file covers the whole key range, so only keys sampled from files could split it.
+  Random rnd(301);
+  std::vector<std::string> values(kNumKeys);
+  for (int file = 0; file < kNumFiles; ++file) {
+    for (int i = 0; i < kNumKeys; ++i) {
+      values[i] = RandomString(&rnd, 1_KB);
+      ASSERT_OK(Put(Key(i), values[i]));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(kNumFiles, NumTableFilesAtLevel(0));
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  const auto num_output_files = NumTableFilesAtLevel(0);
+  ASSERT_GT(num_output_files, 1);
+  ASSERT_LE(num_output_files, kMaxSubcompactions);
+  ASSERT_EQ(num_output_files, filter_factory->num_created_filters.load());
+
+  std::vector<LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  for (const auto& file : files) {
+    if (file.smallest.key != Key(0)) {
+      ASSERT_EQ('0', file.smallest.key.back()) << file.smallest.key;
+    }
+  }
+
+  for (int i = 0; i < kNumKeys; ++i) {
+    ASSERT_EQ(values[i], Get(Key(i)));
+  }
+
+  // Output files are installed as a single sorted run.
+  auto check_output_run = [this, num_output_files] {
+    std::vector<std::vector<FileMetaData>> metadata;
+    dbfull()->TEST_GetFilesMetaData(db_->DefaultColumnFamily(), &metadata);
+    std::set<uint64_t> run_ids;
+    int num_run_files = 0;
+    for (const auto& file : metadata[0]) {
+      if (file.sorted_run_id != 0) {
+        run_ids.insert(file.sorted_run_id);
+        ++num_run_files;
+      }
+    }
+    ASSERT_EQ(1, run_ids.size());
+    ASSERT_EQ(num_output_files, num_run_files);
+  };
+  ASSERT_EQ(1, NumSortedRuns());
+  ASSERT_NO_FATALS(check_output_run());
+
+  // Sorted run survives restart, and is not compacted again with a new file, because there are
+  // only 2 sorted runs, while the number of files reaches the trigger.
+  options.disable_auto_compactions = false;
+  options.level0_file_num_compaction_trigger = num_output_files + 1;
+  Reopen(options);
+  ASSERT_EQ(1, NumSortedRuns());
+  ASSERT_NO_FATALS(check_output_run());
+
+  ASSERT_OK(Put(Key(0), values[0]));
+  ASSERT_OK(Flush());
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_EQ(num_output_files + 1, NumTableFilesAtLevel(0));
+  ASSERT_EQ(2, NumSortedRuns());
+  ASSERT_NO_FATALS(check_output_run());
+}
+
 }  // namespace rocksdb
 
 #endif  // !defined(ROCKSDB_LITE)
@@ -136,22 +136,25 @@ Status TableCache::DoGetTableReader(
     const InternalKeyComparatorPtr& internal_comparator, const FileDescriptor& fd,
     bool sequential_mode, bool record_read_stats, HistogramImpl* file_read_hist,
     unique_ptr<TableReader>* table_reader, bool skip_filters) {
-  const std::string base_fname = TableFileName(ioptions_.db_paths, fd.GetNumber(), fd.GetPathId());
-
-  Status s;
-  {
-    unique_ptr<RandomAccessFileReader> base_file_reader;
+  std::string base_fname = TableFileName(ioptions_.db_paths, fd.GetNumber(), fd.GetPathId());
+  unique_ptr<RandomAccessFileReader> base_file_reader;
+  Status s = NewFileReader(ioptions_, env_options, base_fname, sequential_mode, record_read_stats,
+      file_read_hist, &base_file_reader);
+  if (s.IsNotFound() && fd.GetPathId() != 0) {
+    // Checkpoint places all table files to its directory, regardless of the path they had in
+    // the original DB. So DB restored from checkpoint could have them in the first path.
+    base_fname = MakeTableFileName(ioptions_.db_paths[0].path, fd.GetNumber());
     s = NewFileReader(ioptions_, env_options, base_fname, sequential_mode, record_read_stats,
         file_read_hist, &base_file_reader);
-    if (!s.ok()) {
-      return s;
-    }
-    s = ioptions_.table_factory->NewTableReader(
-        TableReaderOptions(ioptions_, env_options, internal_comparator, skip_filters),
-        std::move(base_file_reader), fd.GetBaseFileSize(), table_reader);
-    if (!s.ok()) {
-      return s;
-    }
+  }
+  if (!s.ok()) {
+    return s;
+  }
+  s = ioptions_.table_factory->NewTableReader(
+      TableReaderOptions(ioptions_, env_options, internal_comparator, skip_filters),
+      std::move(base_file_reader), fd.GetBaseFileSize(), table_reader);
+  if (!s.ok()) {
+    return s;
   }
 
   if ((*table_reader)->IsSplitSst()) {
@@ -151,7 +151,9 @@ class VersionBuilder::Rep {
           assert(f1->largest.seqno > f2->largest.seqno ||
                  // We can have multiple files with seqno = 0 as a result of
                  // using DB::AddFile()
-                 (f1->largest.seqno == 0 && f2->largest.seqno == 0));
+                 (f1->largest.seqno == 0 && f2->largest.seqno == 0) ||
+                 // Files of the same sorted run have overlapping seqno ranges.
+                 (f1->sorted_run_id != 0 && f1->sorted_run_id == f2->sorted_run_id));
         } else {
           assert(level_nonzero_cmp_(f1, f2));
 
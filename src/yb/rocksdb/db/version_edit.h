@@ -109,6 +109,10 @@ struct FileMetaData {
   BoundaryValues smallest;     // The smallest values in this file
   BoundaryValues largest;      // The largest values in this file
   bool imported = false;       // Was this file imported from another DB.
+  // Level 0 files produced by the same compaction from non overlapping key ranges form a single
+  // sorted run. They share the number of the first file of the run here, 0 means that the file
+  // is a sorted run by itself.
+  uint64_t sorted_run_id = 0;
 
   // Needs to be disposed when refs becomes 0.
   Cache::Handle* table_reader_handle;
@@ -215,6 +219,7 @@ class VersionEdit {
     nf.largest = f.largest;
     nf.marked_for_compaction = f.marked_for_compaction;
     nf.imported = f.imported;
+    nf.sorted_run_id = f.sorted_run_id;
     new_files_.emplace_back(level, std::move(nf));
   }
 
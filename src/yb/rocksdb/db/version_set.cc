@@ -1246,11 +1246,16 @@ void VersionStorageInfo::ComputeCompactionScore(
       // overwrites/deletions).
       int num_sorted_runs = 0;
       uint64_t total_size = 0;
+      uint64_t last_sorted_run_id = 0;
       for (auto* f : files_[level]) {
         if (!f->being_compacted) {
           total_size += f->compensated_file_size;
-          num_sorted_runs++;
+          // Consecutive files with the same sorted run id are counted as a single sorted run.
+          if (f->sorted_run_id == 0 || f->sorted_run_id != last_sorted_run_id) {
+            num_sorted_runs++;
+          }
         }
+        last_sorted_run_id = f->sorted_run_id;
       }
       if (compaction_style_ == kCompactionStyleUniversal) {
         // For universal compaction, we use level0 score to indicate
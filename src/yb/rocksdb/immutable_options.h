@@ -136,6 +136,10 @@ struct ImmutableCFOptions {
   std::shared_ptr<IteratorReplacer> iterator_replacer;
 
   CompactionFileFilterFactory* compaction_file_filter_factory;
+
+  std::shared_ptr<std::function<bool(const std::vector<FileMetaData*>&)>> cold_compaction_output;
+
+  std::shared_ptr<std::function<int64_t(const FileMetaData&)>> compaction_time_window;
 };
 
 }  // namespace rocksdb
@@ -1358,6 +1358,17 @@ struct DBOptions {
   // The filters are currently used to expire files in time-series DBs that have
   // completely expired based on their table and/or column TTL.
   std::shared_ptr<CompactionFileFilterFactory> compaction_file_filter_factory;
+
+  // Checks whether the output of compaction with specified input files contains only cold data.
+  // Such output is placed to the last entry of db_paths, instead of the path picked based on
+  // db_paths target sizes.
+  // Supported only for universal style compactions.
+  std::shared_ptr<std::function<bool(const std::vector<FileMetaData*>&)>> cold_compaction_output;
+
+  // Returns time window of the specified file. Universal compaction never merges level 0 files
+  // from different time windows, so data of each window is compacted independently, and whole
+  // window could be dropped by compaction_file_filter_factory after expiration.
+  std::shared_ptr<std::function<int64_t(const FileMetaData&)>> compaction_time_window;
 };
 
 // Options to control the behavior of a database (passed to DB::Open)
@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "yb/rocksdb/env.h"
 
 namespace rocksdb {
@@ -75,4 +77,15 @@ extern RateLimiter* NewGenericRateLimiter(
     int64_t refill_period_us = 100 * 1000,
     int32_t fairness = 10);
 
+// Creates a share of the base rate limiter, created by NewGenericRateLimiter, that is intended
+// to be used by a single RocksDB instance (or a group of closely related ones).
+// Waiting requests of the same priority from different shares are granted in round robin order,
+// so an instance with many concurrent requests, e.g. a big compaction split into subcompactions,
+// could not starve other instances sharing the base rate limiter.
+// SetBytesPerSecond on a share changes the rate of the base rate limiter.
+extern std::shared_ptr<RateLimiter> NewRateLimiterShare(std::shared_ptr<RateLimiter> base);
+
+// Returns the base rate limiter if rate_limiter is a share, otherwise returns rate_limiter.
+extern RateLimiter* GetBaseRateLimiter(RateLimiter* rate_limiter);
+
 }  // namespace rocksdb
@@ -0,0 +1,107 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_ROCKSDB_SECONDARY_BLOCK_CACHE_H
+#define YB_ROCKSDB_SECONDARY_BLOCK_CACHE_H
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/rocksdb/status.h"
+
+#include "yb/util/size_literals.h"
+#include "yb/util/slice.h"
+
+namespace yb {
+
+class MemTracker;
+class MetricEntity;
+
+}
+
+namespace rocksdb {
+
+class Cache;
+class Env;
+
+// Second tier of the block cache, that is checked before reading the block from the SST file.
+// Blocks are admitted when they are evicted from the primary (in-memory) block cache, see
+// ConnectSecondaryBlockCache.
+//
+// Secondary cache is best effort: admission could silently drop blocks and lookup treats any
+// failure as a miss.
+class SecondaryBlockCache {
+ public:
+  virtual ~SecondaryBlockCache() = default;
+
+  // Schedules asynchronous admission of the uncompressed block contents under the specified key.
+  // Contents are copied, so the caller does not have to keep them alive.
+  virtual void Insert(const Slice& key, const Slice& contents) = 0;
+
+  // Returns true and fills data and size if block with the specified key is present.
+  virtual bool Lookup(const Slice& key, std::unique_ptr<char[]>* data, size_t* size) = 0;
+
+  // Returns the number of bytes currently stored in the cache.
+  virtual size_t GetUsage() const = 0;
+
+  // Waits until all admissions scheduled so far are processed.
+  virtual void TEST_WaitForPendingInserts() = 0;
+};
+
+struct FileSecondaryBlockCacheOptions {
+  Env* env = nullptr;
+
+  // Directory where cache files are stored, all existing cache files in this directory are
+  // removed when the cache is created.
+  std::string path;
+
+  // Total size of the cache files.
+  size_t capacity = 0;
+
+  // Size of a single cache file. Eviction happens at file granularity, oldest file first.
+  size_t file_size = 64_MB;
+
+  // Blocks are dropped instead of being queued for admission when there are so many bytes
+  // waiting to be written.
+  size_t max_pending_bytes = 32_MB;
+
+  scoped_refptr<yb::MetricEntity> metric_entity;
+
+  // DRAM used by the index and by blocks waiting for admission is charged to a child of this
+  // tracker.
+  std::shared_ptr<yb::MemTracker> parent_mem_tracker;
+
+  // Blocks are stored decrypted. While this function returns true, for instance because
+  // encryption at rest is enabled, blocks are not admitted, lookups miss and already stored
+  // blocks are removed from disk.
+  std::function<bool()> encryption_enabled;
+};
+
+// Creates secondary block cache that stores blocks in files on a local (preferably fast) disk.
+// Blocks are appended to the current cache file by a background thread, and whole files are
+// evicted in FIFO order when the cache is over capacity.
+Status NewFileSecondaryBlockCache(
+    const FileSecondaryBlockCacheOptions& options, std::shared_ptr<SecondaryBlockCache>* result);
+
+// Makes data blocks evicted from block_cache to be admitted into secondary_block_cache.
+// The same secondary cache should be specified in BlockBasedTableOptions of tables that use
+// block_cache, so it would be checked on block cache misses.
+void ConnectSecondaryBlockCache(
+    Cache* block_cache, std::shared_ptr<SecondaryBlockCache> secondary_block_cache);
+
+}  // namespace rocksdb
+
+#endif  // YB_ROCKSDB_SECONDARY_BLOCK_CACHE_H
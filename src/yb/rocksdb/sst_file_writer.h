@@ -29,6 +29,7 @@
 namespace rocksdb {
 
 class Comparator;
+class UserFrontiers;
 
 // Table Properties that are specific to tables created by SstFileWriter.
 struct ExternalSstFilePropertyNames {
@@ -65,6 +66,9 @@ struct ExternalSstFileInfo {
   bool is_split_sst;               // is SST split into metadata and data file(s)
   uint64_t num_entries;            // number of entries in file
   int32_t version;                 // file version
+  // Optional user frontiers that DB::AddFile assigns to the added file, not filled by
+  // SstFileWriter.
+  const UserFrontiers* user_frontiers = nullptr;
 };
 
 // SstFileWriter is used to create sst files that can be added to database later
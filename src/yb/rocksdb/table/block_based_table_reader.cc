@@ -23,6 +23,8 @@
 
 #include "yb/rocksdb/table/block_based_table_reader.h"
 
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <utility>
 
@@ -35,6 +37,7 @@
 #include "yb/rocksdb/filter_policy.h"
 #include "yb/rocksdb/iterator.h"
 #include "yb/rocksdb/options.h"
+#include "yb/rocksdb/secondary_block_cache.h"
 #include "yb/rocksdb/statistics.h"
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/table/block.h"
@@ -61,13 +64,36 @@
 #include "yb/rocksdb/util/stop_watch.h"
 
 #include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/stats/perf_step_timer.h"
 #include "yb/util/status_format.h"
 #include "yb/util/string_util.h"
 
+using namespace yb::size_literals;
+
+DEFINE_int32(rocksdb_iterator_sequential_blocks_for_readahead, 2,
+             "Number of consecutive data blocks an SST file iterator has to read before it starts "
+             "prefetching the following blocks on block cache misses. 0 disables readahead.");
+TAG_FLAG(rocksdb_iterator_sequential_blocks_for_readahead, runtime);
+TAG_FLAG(rocksdb_iterator_sequential_blocks_for_readahead, advanced);
+
+DEFINE_int64(rocksdb_iterator_initial_readahead_size, 64_KB,
+             "Size of the first prefetch issued by an SST file iterator reading data blocks "
+             "sequentially. Every following prefetch of the same iterator doubles the size up to "
+             "rocksdb_iterator_max_readahead_size.");
+TAG_FLAG(rocksdb_iterator_initial_readahead_size, runtime);
+TAG_FLAG(rocksdb_iterator_initial_readahead_size, advanced);
+
+DEFINE_int64(rocksdb_iterator_max_readahead_size, 2_MB,
+             "Maximum size of a single prefetch issued by an SST file iterator reading data "
+             "blocks sequentially.");
+TAG_FLAG(rocksdb_iterator_max_readahead_size, runtime);
+TAG_FLAG(rocksdb_iterator_max_readahead_size, advanced);
+
 namespace rocksdb {
 
 extern const uint64_t kBlockBasedTableMagicNumber;
@@ -92,6 +118,21 @@ void DeleteCachedEntry(const Slice& key, void* value) {
   delete entry;
 }
 
+// Data blocks are deleted by a separate function, so ConnectSecondaryBlockCache could tell them
+// apart from index blocks, that are cached as Block as well.
+void DeleteCachedDataBlock(const Slice& key, void* value) {
+  DeleteCachedEntry<Block>(key, value);
+}
+
+typedef void (*CacheEntryDeleter)(const Slice& key, void* value);
+
+CacheEntryDeleter BlockDeleter(BlockType block_type) {
+  if (block_type == BlockType::kData) {
+    return &DeleteCachedDataBlock;
+  }
+  return &DeleteCachedEntry<Block>;
+}
+
 // Release the cached entry and decrement its ref count.
 void ReleaseCachedEntry(void* arg, void* h) {
   Cache* cache = reinterpret_cast<Cache*>(arg);
@@ -244,6 +285,59 @@ struct BlockBasedTable::Rep {
   yb::MemTrackerPtr mem_tracker;
 };
 
+class BlockBasedTable::DataBlockReadahead {
+ public:
+  // Should be invoked for every data block the iterator switches to.
+  void BlockAccessed(const BlockHandle& handle) {
+    if (handle.offset() == next_block_offset_) {
+      ++num_sequential_blocks_;
+    } else {
+      num_sequential_blocks_ = 0;
+      readahead_size_ = 0;
+      readahead_limit_ = 0;
+    }
+    next_block_offset_ = handle.offset() + handle.size() + kBlockTrailerSize;
+  }
+
+  // Should be invoked before reading the last accessed block from the file.
+  void BeforeFileRead(RandomAccessFile* file) {
+    const auto sequential_blocks_for_readahead =
+        FLAGS_rocksdb_iterator_sequential_blocks_for_readahead;
+    if (sequential_blocks_for_readahead <= 0 ||
+        num_sequential_blocks_ < implicit_cast<size_t>(sequential_blocks_for_readahead)) {
+      return;
+    }
+    // Keep at least half of the current window prefetched in front of the iterator, so that the
+    // device is busy with the next blocks while the current ones are being processed.
+    if (next_block_offset_ + readahead_size_ / 2 < readahead_limit_) {
+      return;
+    }
+    const size_t max_readahead_size = std::max<int64_t>(
+        FLAGS_rocksdb_iterator_max_readahead_size, 0);
+    const size_t initial_readahead_size = std::min<size_t>(
+        std::max<int64_t>(FLAGS_rocksdb_iterator_initial_readahead_size, 0), max_readahead_size);
+    readahead_size_ = readahead_size_ == 0
+        ? initial_readahead_size : std::min(readahead_size_ * 2, max_readahead_size);
+    if (readahead_size_ == 0) {
+      return;
+    }
+    const auto start = std::max(next_block_offset_, readahead_limit_);
+    readahead_limit_ = next_block_offset_ + readahead_size_;
+    if (start < readahead_limit_) {
+      file->Prefetch(start, readahead_limit_ - start);
+    }
+  }
+
+ private:
+  // Offset right after the last accessed block, i.e. where the next block is expected to start
+  // when blocks are read sequentially.
+  uint64_t next_block_offset_ = std::numeric_limits<uint64_t>::max();
+  size_t num_sequential_blocks_ = 0;
+  size_t readahead_size_ = 0;
+  // File offset up to which data was already requested to be prefetched.
+  uint64_t readahead_limit_ = 0;
+};
+
 // BlockEntryIteratorState doesn't actually store any iterator state and is only used as an adapter
 // to BlockBasedTable. It is used by TwoLevelIterator and MultiLevelIterator to call BlockBasedTable
 // functions in order to check if prefix may match or to create a secondary iterator.
@@ -259,7 +353,14 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
         block_type_(block_type) {}
 
   InternalIterator* NewSecondaryIterator(const Slice& index_value) override {
-    return table_->NewDataBlockIterator(read_options_, index_value, block_type_);
+    return table_->NewDataBlockIterator(
+        read_options_, index_value, block_type_, /* input_iter = */ nullptr, readahead_.get());
+  }
+
+  // Enables prefetching of data blocks. Should be used only when the state is owned by a single
+  // iterator, since readahead tracks the blocks accessed by that iterator.
+  void EnableReadahead() {
+    readahead_ = std::make_unique<DataBlockReadahead>();
   }
 
   bool PrefixMayMatch(const Slice& internal_key) override {
@@ -277,6 +378,7 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
   const ReadOptions read_options_;
   const bool skip_filters_;
   const BlockType block_type_;
+  std::unique_ptr<DataBlockReadahead> readahead_;
 };
 
 
@@ -811,7 +913,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
     if (block_cache != nullptr && block->value->cachable() &&
         read_options.fill_cache) {
       s = block_cache->Insert(block_cache_key, read_options.query_id, block->value,
-                              block->value->usable_size(), &DeleteCachedEntry<Block>,
+                              block->value->usable_size(), BlockDeleter(block_type),
                               &block->cache_handle, statistics);
       if (!s.ok()) {
         delete block->value;
@@ -830,7 +932,7 @@ Status BlockBasedTable::PutDataBlockToCache(
     Cache* block_cache, Cache* block_cache_compressed,
     const ReadOptions& read_options, Statistics* statistics,
     CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    BlockType block_type, const std::shared_ptr<yb::MemTracker>& mem_tracker) {
   assert(raw_block->compression_type() == kNoCompression ||
          block_cache_compressed != nullptr);
 
@@ -874,7 +976,7 @@ Status BlockBasedTable::PutDataBlockToCache(
   if (block_cache != nullptr && block->value->cachable()) {
     s = block_cache->Insert(block_cache_key, read_options.query_id, block->value,
                             block->value->usable_size(),
-                            &DeleteCachedEntry<Block>, &block->cache_handle, statistics);
+                            BlockDeleter(block_type), &block->cache_handle, statistics);
     if (!s.ok()) {
       delete block->value;
       block->value = nullptr;
@@ -884,6 +986,21 @@ Status BlockBasedTable::PutDataBlockToCache(
   return s;
 }
 
+std::unique_ptr<Block> BlockBasedTable::GetBlockFromSecondaryCache(const Slice& block_cache_key) {
+  SecondaryBlockCache* secondary_block_cache = rep_->table_options.secondary_block_cache.get();
+  if (secondary_block_cache == nullptr || block_cache_key.empty()) {
+    return nullptr;
+  }
+  std::unique_ptr<char[]> data;
+  size_t size = 0;
+  if (!secondary_block_cache->Lookup(block_cache_key, &data, &size)) {
+    return nullptr;
+  }
+  return std::make_unique<Block>(
+      BlockContents(std::move(data), size, /* cachable= */ true, kNoCompression,
+                    rep_->mem_tracker));
+}
+
 Status BlockBasedTable::CreateFilterIndexReader(std::unique_ptr<IndexReader>* filter_index_reader) {
   auto base_file_reader = rep_->base_reader_with_cache_prefix->reader.get();
   auto env = rep_->ioptions.env;
@@ -1166,7 +1283,8 @@ InternalIterator* BlockBasedTable::NewIndexIterator(
 // If input_iter is null, new a iterator
 // If input_iter is not null, update this iter and return it
 InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
-    const Slice& index_value, BlockType block_type, BlockIter* input_iter) {
+    const Slice& index_value, BlockType block_type, BlockIter* input_iter,
+    DataBlockReadahead* readahead) {
   PERF_TIMER_GUARD(new_table_block_iter_nanos);
 
   const bool no_io = (ro.read_tier == kBlockCacheTier);
@@ -1191,6 +1309,9 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   }
 
   FileReaderWithCachePrefix* reader = GetBlockReader(block_type);
+  if (readahead) {
+    readahead->BlockAccessed(handle);
+  }
 
   // If either block cache is enabled, we'll try to read from it.
   if (block_cache != nullptr || block_cache_compressed != nullptr) {
@@ -1214,8 +1335,15 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
         rep_->table_options.format_version, block_type, rep_->mem_tracker);
 
     if (block.value == nullptr && !no_io && ro.fill_cache) {
+      // Only data blocks are admitted to the secondary block cache.
       std::unique_ptr<Block> raw_block;
-      {
+      if (block_type == BlockType::kData) {
+        raw_block = GetBlockFromSecondaryCache(key);
+      }
+      if (!raw_block) {
+        if (readahead) {
+          readahead->BeforeFileRead(reader->reader->file());
+        }
         StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
         s = block_based_table::ReadBlockFromFile(
             reader->reader.get(), rep_->footer, ro, handle, &raw_block, rep_->ioptions.env,
@@ -1225,7 +1353,8 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
       if (s.ok()) {
         s = PutDataBlockToCache(key, ckey, block_cache, block_cache_compressed,
                                 ro, statistics, &block, raw_block.release(),
-                                rep_->table_options.format_version, rep_->mem_tracker);
+                                rep_->table_options.format_version, block_type,
+                                rep_->mem_tracker);
       }
     }
   }
@@ -1241,6 +1370,9 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
         return NewErrorInternalIterator(ReturnNoIOError());
       }
     }
+    if (readahead) {
+      readahead->BeforeFileRead(reader->reader->file());
+    }
     std::unique_ptr<Block> block_value;
     s = block_based_table::ReadBlockFromFile(
         reader->reader.get(), rep_->footer, ro, handle, &block_value, rep_->ioptions.env,
@@ -1374,6 +1506,7 @@ InternalIterator* BlockBasedTable::NewIterator(const ReadOptions& read_options,
                                                bool skip_filters) {
   auto state = std::make_unique<BlockEntryIteratorState>(
       this, read_options, skip_filters, BlockType::kData);
+  state->EnableReadahead();
   // TODO: unify the semantics across NewIterator callsites, so that we can pass an arena across
   // them, and decide the free / no free based on that. This callsite, for example, allows us to
   // put the top level iterator on the arena and potentially even the State object, however, not
@@ -1935,4 +2068,64 @@ yb::Result<std::string> BlockBasedTable::GetMiddleKey() {
   return iter->key().ToBuffer();
 }
 
+yb::Result<std::vector<std::string>> BlockBasedTable::GetSplitKeys(size_t num_keys) {
+  auto index_reader = VERIFY_RESULT(GetIndexReader(ReadOptions::kDefault));
+
+  // TODO: remove this trick after https://github.com/yugabyte/yugabyte-db/issues/4720 is resolved.
+  auto se = yb::ScopeExit([this, &index_reader] {
+    index_reader.Release(rep_->table_options.block_cache.get());
+  });
+
+  // Only the top level of the index is sampled, so lower level index blocks are not read.
+  std::unique_ptr<InternalIterator> index_iter(index_reader.value->NewTopLevelIterator());
+  size_t num_entries = 0;
+  for (index_iter->SeekToFirst(); index_iter->Valid(); index_iter->Next()) {
+    ++num_entries;
+  }
+  RETURN_NOT_OK(index_iter->status());
+
+  std::vector<std::string> result;
+  if (num_keys == 0 || num_entries < 2) {
+    return result;
+  }
+  const auto entries_per_part = std::max<size_t>(num_entries / (num_keys + 1), 1);
+
+  std::unique_ptr<InternalIterator> iter(
+      NewIterator(ReadOptions::kDefault, nullptr, /* skip_filters =*/ true));
+  size_t entry_idx = 0;
+  for (index_iter->SeekToFirst(); index_iter->Valid() && result.size() < num_keys;
+       index_iter->Next()) {
+    if (++entry_idx % entries_per_part != 0) {
+      continue;
+    }
+    // Index keys could be shortened, so use the first key actually written to SST file after it.
+    iter->Seek(index_iter->key());
+    if (!iter->Valid()) {
+      break;
+    }
+    if (result.empty() || iter->key() != Slice(result.back())) {
+      result.push_back(iter->key().ToBuffer());
+    }
+  }
+  RETURN_NOT_OK(index_iter->status());
+  RETURN_NOT_OK(iter->status());
+  return result;
+}
+
+void ConnectSecondaryBlockCache(
+    Cache* block_cache, std::shared_ptr<SecondaryBlockCache> secondary_block_cache) {
+  block_cache->SetEvictionListener(
+      [secondary_block_cache = std::move(secondary_block_cache)](
+          const Slice& key, void* value, void (*deleter)(const Slice& key, void* value)) {
+    // Only data blocks are admitted. Index and filter blocks are few and are read on every
+    // lookup, so they stay in the primary cache, and other entries are not plain bytes.
+    if (deleter != &DeleteCachedDataBlock) {
+      return;
+    }
+    auto* block = static_cast<Block*>(value);
+    // Blocks in the block cache are always uncompressed, see PutDataBlockToCache.
+    secondary_block_cache->Insert(key, Slice(block->data(), block->size()));
+  });
+}
+
 }  // namespace rocksdb
@@ -179,15 +179,22 @@ class BlockBasedTable : public TableReader {
   // convert SST file to a human readable form
   CHECKED_STATUS DumpTable(WritableFile* out_file) override;
 
+  // Tracks data block reads of a single iterator and prefetches the following blocks of the file
+  // once the iterator is detected to read blocks sequentially.
+  class DataBlockReadahead;
+
   // input_iter: if it is not null, update this one and return it as Iterator
+  // readahead: if it is not null, used to prefetch subsequent blocks on block cache misses.
   InternalIterator* NewDataBlockIterator(
       const ReadOptions& ro, const Slice& index_value, BlockType block_type,
-      BlockIter* input_iter = nullptr);
+      BlockIter* input_iter = nullptr, DataBlockReadahead* readahead = nullptr);
 
   const ImmutableCFOptions& ioptions();
 
   yb::Result<std::string> GetMiddleKey() override;
 
+  yb::Result<std::vector<std::string>> GetSplitKeys(size_t num_keys) override;
+
   ~BlockBasedTable();
 
   bool TEST_filter_block_preloaded() const;
@@ -266,7 +273,11 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed,
       const ReadOptions& read_options, Statistics* statistics,
       CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      BlockType block_type, const std::shared_ptr<yb::MemTracker>& mem_tracker);
+
+  // Returns uncompressed block with the specified block cache key from the secondary block cache,
+  // or nullptr if secondary block cache is not configured or does not contain this block.
+  std::unique_ptr<Block> GetBlockFromSecondaryCache(const Slice& block_cache_key);
 
   // Calls (*handle_result)(arg, ...) repeatedly, starting with the entry found
   // after a call to Seek(key), until handle_result returns false.
@@ -62,6 +62,10 @@ class IndexReader {
   // written into the index (see ShortenedIndexBuilder).
   virtual Result<Slice> GetMiddleKey() = 0;
 
+  // Creates an iterator over the top level of the index, which is the whole index for single level
+  // indexes. Allows to sample keys from the index without reading lower index levels.
+  virtual InternalIterator* NewTopLevelIterator() = 0;
+
   // The size of the index.
   virtual size_t size() const = 0;
   // Memory usage of the index block
@@ -114,6 +118,10 @@ class BinarySearchIndexReader : public IndexReader {
 
   Result<Slice> GetMiddleKey() override;
 
+  InternalIterator* NewTopLevelIterator() override {
+    return index_block_->NewIndexIterator(comparator_.get());
+  }
+
  private:
   BinarySearchIndexReader(const ComparatorPtr& comparator,
                           std::unique_ptr<Block>&& index_block)
@@ -160,6 +168,10 @@ class HashIndexReader : public IndexReader {
 
   Result<Slice> GetMiddleKey() override;
 
+  InternalIterator* NewTopLevelIterator() override {
+    return index_block_->NewIndexIterator(comparator_.get());
+  }
+
  private:
   HashIndexReader(const ComparatorPtr& comparator, std::unique_ptr<Block>&& index_block)
       : IndexReader(comparator), index_block_(std::move(index_block)) {
@@ -201,6 +213,10 @@ class MultiLevelIndexReader : public IndexReader {
 
   Result<Slice> GetMiddleKey() override;
 
+  InternalIterator* NewTopLevelIterator() override {
+    return top_level_index_block_->NewIndexIterator(comparator_.get());
+  }
+
  private:
   size_t size() const override { return top_level_index_block_->size(); }
 
@@ -124,6 +124,12 @@ class TableReader {
   virtual yb::Result<std::string> GetMiddleKey() {
     return STATUS(NotSupported, "GetMiddleKey() not supported");
   }
+
+  // Returns up to num_keys internal keys in increasing order, which divide SST file into parts
+  // containing roughly the same amount of data.
+  virtual yb::Result<std::vector<std::string>> GetSplitKeys(size_t num_keys) {
+    return STATUS(NotSupported, "GetSplitKeys() not supported");
+  }
 };
 
 }  // namespace rocksdb
@@ -66,10 +66,15 @@
 #include "yb/rocksdb/util/testutil.h"
 
 #include "yb/util/enums.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/string_util.h"
 #include "yb/util/test_macros.h"
 
 DECLARE_double(cache_single_touch_ratio);
+DECLARE_int64(rocksdb_iterator_initial_readahead_size);
+DECLARE_int64(rocksdb_iterator_max_readahead_size);
+
+using namespace yb::size_literals;
 
 namespace rocksdb {
 
@@ -336,8 +341,8 @@ class TableConstructor: public Constructor {
 
     // Open the table
     uniq_id_ = cur_uniq_id_++;
-    file_reader_.reset(test::GetRandomAccessFileReader(new test::StringSource(
-        GetSink()->contents(), uniq_id_, ioptions.allow_mmap_reads)));
+    source_ = new test::StringSource(GetSink()->contents(), uniq_id_, ioptions.allow_mmap_reads);
+    file_reader_.reset(test::GetRandomAccessFileReader(source_));
     return ioptions.table_factory->NewTableReader(
         TableReaderOptions(ioptions, soptions, internal_comparator),
         std::move(file_reader_), GetSink()->contents().size(), &table_reader_);
@@ -358,8 +363,8 @@ class TableConstructor: public Constructor {
   }
 
   virtual Status Reopen(const ImmutableCFOptions& ioptions) {
-    file_reader_.reset(test::GetRandomAccessFileReader(new test::StringSource(
-        GetSink()->contents(), uniq_id_, ioptions.allow_mmap_reads)));
+    source_ = new test::StringSource(GetSink()->contents(), uniq_id_, ioptions.allow_mmap_reads);
+    file_reader_.reset(test::GetRandomAccessFileReader(source_));
     return ioptions.table_factory->NewTableReader(
         TableReaderOptions(ioptions, soptions, last_internal_key_),
         std::move(file_reader_), GetSink()->contents().size(), &table_reader_);
@@ -369,6 +374,11 @@ class TableConstructor: public Constructor {
     return table_reader_.get();
   }
 
+  // Returns the file the current table reader reads from, it is owned by the table reader.
+  test::StringSource* GetSource() {
+    return source_;
+  }
+
   bool AnywayDeleteIterator() const override {
     return convert_to_internal_key_;
   }
@@ -382,6 +392,7 @@ class TableConstructor: public Constructor {
  private:
   void Reset() {
     uniq_id_ = 0;
+    source_ = nullptr;
     table_reader_.reset();
     file_writer_.reset();
     file_reader_.reset();
@@ -395,6 +406,7 @@ class TableConstructor: public Constructor {
   unique_ptr<WritableFileWriter> file_writer_;
   unique_ptr<RandomAccessFileReader> file_reader_;
   unique_ptr<TableReader> table_reader_;
+  test::StringSource* source_ = nullptr;
   bool convert_to_internal_key_;
 
   TableConstructor();
@@ -1587,6 +1599,58 @@ TEST_F(BlockBasedTableTest, NumBlockStat) {
             c.GetTableReader()->GetTableProperties()->num_data_blocks);
 }
 
+TEST_F(BlockBasedTableTest, IteratorReadahead) {
+  google::FlagSaver flag_saver;
+  FLAGS_rocksdb_iterator_initial_readahead_size = 4_KB;
+  FLAGS_rocksdb_iterator_max_readahead_size = 16_KB;
+
+  Random rnd(test::RandomSeed());
+  TableConstructor c(BytewiseComparator());
+  Options options;
+  options.compression = kNoCompression;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1000;
+  table_options.no_block_cache = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  constexpr int kNumKeys = 200;
+  for (int i = 0; i < kNumKeys; ++i) {
+    // Every block holds roughly one key/value pair.
+    c.Add(RandomString(&rnd, 900), "val");
+  }
+
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options,
+           GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+  auto* source = c.GetSource();
+  const auto data_size = c.GetTableReader()->GetTableProperties()->data_size;
+
+  // Point reads with a fresh iterator each should not trigger readahead.
+  for (const auto& key : keys) {
+    unique_ptr<InternalIterator> iter(c.NewIterator());
+    iter->Seek(key);
+    ASSERT_TRUE(iter->Valid());
+  }
+  ASSERT_EQ(0, source->total_prefetches());
+
+  // A full scan should prefetch almost all data, with the readahead window growing up to the max.
+  {
+    unique_ptr<InternalIterator> iter(c.NewIterator());
+    int num_keys = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ++num_keys;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(kNumKeys, num_keys);
+  }
+  ASSERT_GT(source->total_prefetches(), 0);
+  ASSERT_LT(source->total_prefetches(), kNumKeys / 4);
+  ASSERT_GE(source->total_prefetched_bytes(), data_size / 2);
+  ASSERT_LE(source->total_prefetched_bytes(), data_size + 16_KB);
+}
+
 // A simple tool that takes the snapshot of block cache statistics.
 class BlockCachePropertiesSnapshot {
  public:
@@ -24,6 +24,9 @@
 #include <assert.h>
 #include <stdio.h>
 
+#include <atomic>
+#include <mutex>
+
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/statistics.h"
@@ -34,6 +37,7 @@
 
 #include "yb/util/cache_metrics.h"
 #include "yb/util/enums.h"
+#include "yb/util/locks.h"
 #include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
 
@@ -134,15 +138,16 @@ struct LRUHandle {
 // table implementations in some of the compiler/runtime combinations
 // we have tested.  E.g., readrandom speeds up by ~5% over the g++
 // 4.4.3's builtin hashtable.
+template <class HandleType>
 class HandleTable {
  public:
   HandleTable() :
       length_(0), elems_(0), list_(nullptr), metrics_(nullptr) { Resize(); }
 
   template <typename T>
-  void ApplyToAllCacheEntries(T func) {
+  void ApplyToAllCacheEntries(T func) const {
     for (uint32_t i = 0; i < length_; i++) {
-      LRUHandle* h = list_[i];
+      HandleType* h = list_[i];
       while (h != nullptr) {
         auto n = h->next_hash;
         assert(h->in_cache);
@@ -153,7 +158,7 @@ class HandleTable {
   }
 
   ~HandleTable() {
-    ApplyToAllCacheEntries([this](LRUHandle* h) {
+    ApplyToAllCacheEntries([this](HandleType* h) {
       if (h->refs == 1) {
         h->Free(metrics_.get());
       }
@@ -161,7 +166,7 @@ class HandleTable {
     delete[] list_;
   }
 
-  LRUHandle* Lookup(const Slice& key, uint32_t hash) const {
+  HandleType* Lookup(const Slice& key, uint32_t hash) const {
     return *FindPointer(key, hash);
   }
 
@@ -170,12 +175,12 @@ class HandleTable {
   // Checks if the newly created handle is a candidate to be inserted into the multi touch cache.
   // It checks to see if the same value is in the multi touch cache, or if it is in the single
   // touch cache, checks to see if the query ids are different.
-  SubCacheType GetSubCacheTypeCandidate(LRUHandle* h) {
+  SubCacheType GetSubCacheTypeCandidate(HandleType* h) {
     if (h->GetSubCacheType() == MULTI_TOUCH) {
       return MULTI_TOUCH;
     }
 
-    LRUHandle* val = Lookup(h->key(), h->hash);
+    HandleType* val = Lookup(h->key(), h->hash);
     if (val != nullptr && (val->GetSubCacheType() == MULTI_TOUCH || val->query_id != h->query_id)) {
       h->query_id = kInMultiTouchId;
       return MULTI_TOUCH;
@@ -183,9 +188,9 @@ class HandleTable {
     return SINGLE_TOUCH;
   }
 
-  LRUHandle* Insert(LRUHandle* h) {
-    LRUHandle** ptr = FindPointer(h->key(), h->hash);
-    LRUHandle* old = *ptr;
+  HandleType* Insert(HandleType* h) {
+    HandleType** ptr = FindPointer(h->key(), h->hash);
+    HandleType* old = *ptr;
     h->next_hash = (old == nullptr ? nullptr : old->next_hash);
     *ptr = h;
     if (old == nullptr) {
@@ -199,9 +204,9 @@ class HandleTable {
     return old;
   }
 
-  LRUHandle* Remove(const Slice& key, uint32_t hash) {
-    LRUHandle** ptr = FindPointer(key, hash);
-    LRUHandle* result = *ptr;
+  HandleType* Remove(const Slice& key, uint32_t hash) {
+    HandleType** ptr = FindPointer(key, hash);
+    HandleType* result = *ptr;
     if (result != nullptr) {
       *ptr = result->next_hash;
       --elems_;
@@ -214,14 +219,14 @@ class HandleTable {
   // a linked list of cache entries that hash into the bucket.
   uint32_t length_;
   uint32_t elems_;
-  LRUHandle** list_;
+  HandleType** list_;
   shared_ptr<yb::CacheMetrics> metrics_;
 
   // Return a pointer to slot that points to a cache entry that
   // matches key/hash.  If there is no such cache entry, return a
   // pointer to the trailing slot in the corresponding linked list.
-  LRUHandle** FindPointer(const Slice& key, uint32_t hash) const {
-    LRUHandle** ptr = &list_[hash & (length_ - 1)];
+  HandleType** FindPointer(const Slice& key, uint32_t hash) const {
+    HandleType** ptr = &list_[hash & (length_ - 1)];
     while (*ptr != nullptr &&
            ((*ptr)->hash != hash || key != (*ptr)->key())) {
       ptr = &(*ptr)->next_hash;
@@ -234,12 +239,12 @@ class HandleTable {
     while (new_length < elems_ * 1.5) {
       new_length *= 2;
     }
-    LRUHandle** new_list = new LRUHandle*[new_length];
+    HandleType** new_list = new HandleType*[new_length];
     memset(new_list, 0, sizeof(new_list[0]) * new_length);
     uint32_t count = 0;
-    LRUHandle* h;
-    LRUHandle* next;
-    LRUHandle** ptr;
+    HandleType* h;
+    HandleType* next;
+    HandleType** ptr;
     uint32_t hash;
     for (uint32_t i = 0; i < length_; i++) {
       h = list_[i];
@@ -346,33 +351,54 @@ void LRUSubCache::LRU_Append(LRUHandle *e) {
   lru_usage_ += e->charge;
 }
 
-class LRUHandleDeleter {
+template <class HandleType>
+class CacheHandleDeleter {
  public:
-  explicit LRUHandleDeleter(yb::CacheMetrics* metrics) : metrics_(metrics) {}
+  explicit CacheHandleDeleter(
+      yb::CacheMetrics* metrics, const CacheEvictionListener* eviction_listener = nullptr)
+      : metrics_(metrics), eviction_listener_(eviction_listener) {}
 
-  void Add(LRUHandle* handle) {
+  void Add(HandleType* handle) {
     handles_.push_back(handle);
   }
 
+  // Adds handle that was evicted to free space, eviction listener is notified about such handles.
+  void AddEvicted(HandleType* handle) {
+    evicted_handles_.push_back(handle);
+  }
+
   size_t TotalCharge() const {
     size_t result = 0;
-    for (LRUHandle* handle : handles_) {
+    for (HandleType* handle : handles_) {
+      result += handle->charge;
+    }
+    for (HandleType* handle : evicted_handles_) {
       result += handle->charge;
     }
     return result;
   }
 
-  ~LRUHandleDeleter() {
-    for (LRUHandle* handle : handles_) {
+  ~CacheHandleDeleter() {
+    for (HandleType* handle : evicted_handles_) {
+      if (eviction_listener_ != nullptr && *eviction_listener_) {
+        (*eviction_listener_)(handle->key(), handle->value, handle->deleter);
+      }
+      handle->Free(metrics_);
+    }
+    for (HandleType* handle : handles_) {
       handle->Free(metrics_);
     }
   }
 
  private:
   yb::CacheMetrics* metrics_;
-  autovector<LRUHandle*> handles_;
+  const CacheEvictionListener* eviction_listener_;
+  autovector<HandleType*> handles_;
+  autovector<HandleType*> evicted_handles_;
 };
 
+using LRUHandleDeleter = CacheHandleDeleter<LRUHandle>;
+
 // A single shard of sharded cache.
 class LRUCache {
  public:
@@ -389,6 +415,10 @@ class LRUCache {
     table_.SetMetrics(metrics);
   }
 
+  void SetEvictionListener(const CacheEvictionListener* listener) {
+    eviction_listener_ = listener;
+  }
+
   // Set the flag to reject insertion if cache if full.
   void SetStrictCapacityLimit(bool strict_capacity_limit);
 
@@ -468,9 +498,11 @@ class LRUCache {
   // don't mind mutex_ invoking the non-const actions.
   mutable port::Mutex mutex_;
 
-  HandleTable table_;
+  HandleTable<LRUHandle> table_;
 
   shared_ptr<yb::CacheMetrics> metrics_;
+
+  const CacheEvictionListener* eviction_listener_ = nullptr;
 };
 
 LRUCache::LRUCache() {}
@@ -548,12 +580,12 @@ void LRUCache::EvictFromLRU(const size_t charge,
     old->in_cache = false;
     Unref(old);
     sub_cache->DecrementUsage(old->charge);
-    deleted->Add(old);
+    deleted->AddEvicted(old);
   }
 }
 
 void LRUCache::SetCapacity(size_t capacity) {
-  LRUHandleDeleter last_reference_list(metrics_.get());
+  LRUHandleDeleter last_reference_list(metrics_.get(), eviction_listener_);
 
   {
     MutexLock l(&mutex_);
@@ -576,6 +608,9 @@ void LRUCache::SetStrictCapacityLimit(bool strict_capacity_limit) {
 
 Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
                                 Statistics* statistics)  {
+  // Declared before the lock, so evicted entries are passed to the eviction listener after the
+  // mutex is released.
+  LRUHandleDeleter multi_touch_eviction_list(metrics_.get(), eviction_listener_);
   MutexLock l(&mutex_);
   LRUHandle* e = table_.Lookup(key, hash);
   if (e != nullptr) {
@@ -590,10 +625,7 @@ Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash, const QueryId q
     // Now the handle will be added to the multi touch pool only if it exists.
     if (FLAGS_cache_single_touch_ratio < 1 && e->GetSubCacheType() != MULTI_TOUCH &&
         e->query_id != query_id) {
-      {
-        LRUHandleDeleter multi_touch_eviction_list(metrics_.get());
-        EvictFromLRU(e->charge, &multi_touch_eviction_list, MULTI_TOUCH);
-      }
+      EvictFromLRU(e->charge, &multi_touch_eviction_list, MULTI_TOUCH);
       // Cannot have any single touch elements in this case.
       assert(FLAGS_cache_single_touch_ratio != 0);
       if (!strict_capacity_limit_ ||
@@ -689,7 +721,7 @@ void LRUCache::Release(Cache::Handle* handle) {
 }
 
 size_t LRUCache::Evict(size_t required) {
-  LRUHandleDeleter evicted(metrics_.get());
+  LRUHandleDeleter evicted(metrics_.get(), eviction_listener_);
   {
     MutexLock l(&mutex_);
     EvictFromLRU(required, &evicted, SINGLE_TOUCH);
@@ -713,7 +745,7 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
   LRUHandle* e = reinterpret_cast<LRUHandle*>(
                     new char[sizeof(LRUHandle) - 1 + key.size()]);
   Status s;
-  LRUHandleDeleter last_reference_list(metrics_.get());
+  LRUHandleDeleter last_reference_list(metrics_.get(), eviction_listener_);
 
   e->value = value;
   e->deleter = deleter;
@@ -838,11 +870,731 @@ void LRUCache::Erase(const Slice& key, uint32_t hash) {
   }
 }
 
+// Clock cache implementation
+//
+// Alternative to LRUCache that keeps the same single-touch/multi-touch split for scan resistance,
+// but replaces the LRU lists with two CLOCK rings, in the spirit of S3-FIFO:
+//   - New entries go to the single-touch ring, or straight to the multi-touch ring when the key is
+//     re-inserted by a different query, same as in LRUCache.
+//   - Lookup only holds the per-CPU reader lock while it finds the entry in the hash table, all
+//     bookkeeping is done with relaxed atomic stores into the handle. So lookups from different
+//     threads do not serialize on the shard mutex and never modify the rings.
+//   - When the single-touch clock hand reaches an entry that was looked up by a query other than
+//     the one that inserted it, the entry is moved to the multi-touch ring. Otherwise it is
+//     evicted, so entries touched by a single scan never displace the multi-touch working set.
+//   - The multi-touch ring gives referenced entries a second chance.
+//
+// Insert, Erase and eviction take the plain shard mutex, that is never taken by Lookup. The hash
+// table could be read concurrently with its modification, so entries removed from the table keep
+// the cache reference until all lookups that could have found them are done. Release is lock free.
+//
+// Differences from LRUCache:
+//   - Promotion into the multi-touch ring happens lazily, when the clock hand visits the entry,
+//     so GetSubCacheType could return SINGLE_TOUCH for an entry that is already multi-touch
+//     candidate.
+//   - Usage only accounts entries that are present in the hash table.
+struct ClockHandle {
+  void* value;
+  void (*deleter)(const Slice&, void* value);
+  // Written while holding the shard mutex, read by concurrent lookups.
+  std::atomic<ClockHandle*> next_hash;
+  // Links in the clock ring, protected by the shard mutex.
+  ClockHandle* next;
+  ClockHandle* prev;
+  size_t charge;
+  size_t key_length;
+  // Number of references to this entry, cache itself is counted as 1 while the entry is in the
+  // hash table and until removed entry is retired, see ClockCache::FreeRetired.
+  std::atomic<uint32_t> refs;
+  bool in_cache;      // true, if this entry is referenced by the hash table
+  // Set by Lookup, cleared by the clock hand.
+  std::atomic<bool> referenced;
+  // Set by Lookup from a query other than the one that added the value to the cache.
+  std::atomic<bool> touched_by_other_query;
+  uint32_t hash;      // Hash of key(); used for fast sharding and comparisons
+  std::atomic<QueryId> query_id;  // Query id that added the value to the cache.
+  char key_data[1];   // Beginning of key
+
+  Slice key() const {
+    return Slice(key_data, key_length);
+  }
+
+  void Free(yb::CacheMetrics* metrics) {
+    (*deleter)(key(), value);
+    if (metrics != nullptr) {
+      if (GetSubCacheType() == MULTI_TOUCH) {
+        metrics->multi_touch_cache_usage->DecrementBy(charge);
+      } else {
+        metrics->single_touch_cache_usage->DecrementBy(charge);
+      }
+      metrics->cache_usage->DecrementBy(charge);
+    }
+    this->~ClockHandle();
+    delete[] reinterpret_cast<char*>(this);
+  }
+
+  SubCacheType GetSubCacheType() const {
+    return query_id.load(std::memory_order_relaxed) == kInMultiTouchId ? MULTI_TOUCH
+                                                                          : SINGLE_TOUCH;
+  }
+
+  // Sets the flag only when it is not yet set, to avoid dirtying the cache line on every lookup.
+  static void SetFlag(std::atomic<bool>* flag) {
+    if (!flag->load(std::memory_order_relaxed)) {
+      flag->store(true, std::memory_order_relaxed);
+    }
+  }
+};
+
+using ClockHandleDeleter = CacheHandleDeleter<ClockHandle>;
+
+struct ClockBuckets {
+  explicit ClockBuckets(uint32_t length_)
+      : length(length_), list(new std::atomic<ClockHandle*>[length_]) {
+    for (uint32_t i = 0; i != length; ++i) {
+      list[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  const uint32_t length;
+  std::unique_ptr<std::atomic<ClockHandle*>[]> list;
+};
+
+// Entries and bucket arrays that were removed from the hash table, but could still be accessed by
+// concurrent lookups.
+struct ClockRetiredList {
+  // Entry and whether it was evicted to free space.
+  autovector<std::pair<ClockHandle*, bool>> handles;
+  std::vector<std::unique_ptr<ClockBuckets>> buckets;
+
+  bool empty() const {
+    return handles.empty() && buckets.empty();
+  }
+
+  size_t TotalCharge() const {
+    size_t result = 0;
+    for (const auto& p : handles) {
+      result += p.first->charge;
+    }
+    return result;
+  }
+};
+
+// Same as HandleTable, but Lookup could run concurrently with modifications, that should be
+// serialized by the caller. Removed entries are not touched, so a concurrent lookup that reached
+// them could continue walking the chain. A concurrent lookup could miss an entry while the table
+// is being resized, that is fine for a cache.
+class ClockHandleTable {
+ public:
+  ClockHandleTable() : buckets_(new ClockBuckets(16)) {}
+
+  ~ClockHandleTable() {
+    ApplyToAllCacheEntries([this](ClockHandle* h) {
+      if (h->refs == 1) {
+        h->Free(metrics_.get());
+      }
+    });
+    delete buckets_.load(std::memory_order_acquire);
+  }
+
+  template <typename T>
+  void ApplyToAllCacheEntries(T func) const {
+    const auto* buckets = buckets_.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < buckets->length; i++) {
+      ClockHandle* h = buckets->list[i].load(std::memory_order_acquire);
+      while (h != nullptr) {
+        auto n = h->next_hash.load(std::memory_order_acquire);
+        assert(h->in_cache);
+        func(h);
+        h = n;
+      }
+    }
+  }
+
+  ClockHandle* Lookup(const Slice& key, uint32_t hash) const {
+    const auto* buckets = buckets_.load(std::memory_order_acquire);
+    ClockHandle* h = buckets->list[hash & (buckets->length - 1)].load(std::memory_order_acquire);
+    while (h != nullptr && (h->hash != hash || key != h->key())) {
+      h = h->next_hash.load(std::memory_order_acquire);
+    }
+    return h;
+  }
+
+  void SetMetrics(shared_ptr<yb::CacheMetrics> metrics) { metrics_ = metrics; }
+
+  // Same as HandleTable::GetSubCacheTypeCandidate.
+  SubCacheType GetSubCacheTypeCandidate(ClockHandle* h) {
+    if (h->GetSubCacheType() == MULTI_TOUCH) {
+      return MULTI_TOUCH;
+    }
+
+    ClockHandle* val = Lookup(h->key(), h->hash);
+    if (val != nullptr && (val->GetSubCacheType() == MULTI_TOUCH || val->query_id != h->query_id)) {
+      h->query_id = kInMultiTouchId;
+      return MULTI_TOUCH;
+    }
+    return SINGLE_TOUCH;
+  }
+
+  // Returns the replaced entry with the same key, if any. Bucket array that was replaced while
+  // growing the table is added to retired.
+  ClockHandle* Insert(ClockHandle* h, ClockRetiredList* retired) {
+    auto* slot = FindSlot(h->key(), h->hash);
+    ClockHandle* old = slot->load(std::memory_order_relaxed);
+    h->next_hash.store(
+        old == nullptr ? nullptr : old->next_hash.load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    slot->store(h, std::memory_order_release);
+    if (old == nullptr) {
+      ++elems_;
+      if (elems_ > buckets_.load(std::memory_order_relaxed)->length) {
+        // Since each cache entry is fairly large, we aim for a small
+        // average linked list length (<= 1).
+        Resize(retired);
+      }
+    }
+    return old;
+  }
+
+  ClockHandle* Remove(const Slice& key, uint32_t hash) {
+    auto* slot = FindSlot(key, hash);
+    ClockHandle* result = slot->load(std::memory_order_relaxed);
+    if (result != nullptr) {
+      slot->store(result->next_hash.load(std::memory_order_relaxed), std::memory_order_release);
+      --elems_;
+    }
+    return result;
+  }
+
+ private:
+  // Returns slot that points to a cache entry that matches key/hash. If there is no such cache
+  // entry, returns the trailing slot in the corresponding linked list.
+  std::atomic<ClockHandle*>* FindSlot(const Slice& key, uint32_t hash) const {
+    const auto* buckets = buckets_.load(std::memory_order_relaxed);
+    auto* slot = &buckets->list[hash & (buckets->length - 1)];
+    for (;;) {
+      ClockHandle* h = slot->load(std::memory_order_relaxed);
+      if (h == nullptr || (h->hash == hash && key == h->key())) {
+        return slot;
+      }
+      slot = &h->next_hash;
+    }
+  }
+
+  // Entries are relinked into the new bucket array one by one, so a concurrent lookup that walks
+  // the old array follows only valid entries and always reaches the end of the chain.
+  void Resize(ClockRetiredList* retired) {
+    uint32_t new_length = 16;
+    while (new_length < elems_ * 1.5) {
+      new_length *= 2;
+    }
+    auto* old_buckets = buckets_.load(std::memory_order_relaxed);
+    std::unique_ptr<ClockBuckets> new_buckets(new ClockBuckets(new_length));
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < old_buckets->length; i++) {
+      ClockHandle* h = old_buckets->list[i].load(std::memory_order_relaxed);
+      while (h != nullptr) {
+        ClockHandle* next = h->next_hash.load(std::memory_order_relaxed);
+        auto& new_slot = new_buckets->list[h->hash & (new_length - 1)];
+        h->next_hash.store(new_slot.load(std::memory_order_relaxed), std::memory_order_release);
+        new_slot.store(h, std::memory_order_relaxed);
+        h = next;
+        count++;
+      }
+    }
+    assert(elems_ == count);
+    buckets_.store(new_buckets.release(), std::memory_order_release);
+    retired->buckets.emplace_back(old_buckets);
+  }
+
+  // Bucket array, replaced while holding the shard mutex.
+  std::atomic<ClockBuckets*> buckets_;
+  // Protected by the shard mutex.
+  uint32_t elems_ = 0;
+  shared_ptr<yb::CacheMetrics> metrics_;
+};
+
+// Circular list of cache entries swept by the clock hand.
+// Usage could be read concurrently, everything else should be accessed while holding the
+// shard mutex.
+class ClockRing {
+ public:
+  bool IsEmpty() const {
+    return hand_ == nullptr;
+  }
+
+  size_t Size() const {
+    return size_;
+  }
+
+  size_t Usage() const {
+    return usage_.load(std::memory_order_relaxed);
+  }
+
+  void IncrementUsage(size_t charge) {
+    usage_.fetch_add(charge, std::memory_order_relaxed);
+  }
+
+  void DecrementUsage(size_t charge) {
+    assert(Usage() >= charge);
+    usage_.fetch_sub(charge, std::memory_order_relaxed);
+  }
+
+  ClockHandle* Hand() const {
+    return hand_;
+  }
+
+  void Advance() {
+    hand_ = hand_->next;
+  }
+
+  // Places the entry right behind the hand, so it will be visited after all other entries.
+  void Insert(ClockHandle* e) {
+    assert(e->next == nullptr);
+    if (hand_ == nullptr) {
+      e->next = e->prev = e;
+      hand_ = e;
+    } else {
+      e->next = hand_;
+      e->prev = hand_->prev;
+      e->prev->next = e;
+      hand_->prev = e;
+    }
+    ++size_;
+    IncrementUsage(e->charge);
+  }
+
+  void Remove(ClockHandle* e) {
+    assert(e->next != nullptr);
+    if (e->next == e) {
+      hand_ = nullptr;
+    } else {
+      if (hand_ == e) {
+        hand_ = e->next;
+      }
+      e->prev->next = e->next;
+      e->next->prev = e->prev;
+    }
+    e->next = e->prev = nullptr;
+    --size_;
+    DecrementUsage(e->charge);
+  }
+
+ private:
+  ClockHandle* hand_ = nullptr;
+  size_t size_ = 0;
+  std::atomic<size_t> usage_{0};
+};
+
+// A single shard of sharded clock cache.
+class ClockCache {
+ public:
+  ClockCache() = default;
+  ~ClockCache() = default;
+
+  void SetCapacity(size_t capacity);
+
+  void SetMetrics(shared_ptr<yb::CacheMetrics> metrics) {
+    metrics_ = metrics;
+    table_.SetMetrics(metrics);
+  }
+
+  void SetEvictionListener(const CacheEvictionListener* listener) {
+    eviction_listener_ = listener;
+  }
+
+  void SetStrictCapacityLimit(bool strict_capacity_limit);
+
+  Status Insert(const Slice& key, uint32_t hash, const QueryId query_id,
+                void* value, size_t charge, void (*deleter)(const Slice& key, void* value),
+                Cache::Handle** handle, Statistics* statistics);
+  Cache::Handle* Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
+                        Statistics* statistics = nullptr);
+  void Release(Cache::Handle* handle);
+  void Erase(const Slice& key, uint32_t hash);
+  size_t Evict(size_t required);
+
+  size_t GetUsage() const {
+    return single_touch_ring_.Usage() + multi_touch_ring_.Usage();
+  }
+
+  size_t GetPinnedUsage() const;
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe);
+
+  std::pair<size_t, size_t> TEST_GetIndividualUsages() {
+    return std::pair<size_t, size_t>(single_touch_ring_.Usage(), multi_touch_ring_.Usage());
+  }
+
+ private:
+  ClockRing* GetRing(SubCacheType subcache_type) {
+    return subcache_type == MULTI_TOUCH ? &multi_touch_ring_ : &single_touch_ring_;
+  }
+
+  // Same as LRUCache::GetSubCacheCapacity.
+  size_t GetSubCacheCapacity(SubCacheType subcache_type) const;
+
+  // Runs the clock hand of the specified ring until the ring has space for charge more bytes,
+  // or every evictable entry was visited. Should be called while holding the shard mutex.
+  void EvictFromRing(size_t charge, ClockRetiredList* retired, SubCacheType subcache_type);
+
+  // Removes the entry from its ring and hash table. The reference held by the cache is dropped
+  // by FreeRetired.
+  void RemoveEntry(ClockHandle* e, bool evicted, ClockRetiredList* retired);
+
+  // Waits until lookups that could have found retired entries are done, then drops the cache
+  // reference to those entries. Entries without other references are added to deleted.
+  // Should be called without holding the shard mutex.
+  void FreeRetired(ClockRetiredList* retired, ClockHandleDeleter* deleted);
+
+  // Moves the single-touch entry into the multi-touch ring.
+  void Promote(ClockHandle* e);
+
+  bool strict_capacity_limit_ = false;
+  size_t total_capacity_ = 0;
+  size_t multi_touch_capacity_ = 0;
+
+  ClockRing single_touch_ring_;
+  ClockRing multi_touch_ring_;
+
+  // Protects rings, modifications of table_ and capacity. Not taken by Lookup.
+  mutable port::Mutex mutex_;
+
+  // Lookup holds it in shared mode while reading table_. Modifications only wait for readers
+  // before freeing retired entries, SetCapacity and ApplyToAllCacheEntries take it exclusively.
+  mutable yb::percpu_rwlock readers_lock_;
+
+  ClockHandleTable table_;
+
+  shared_ptr<yb::CacheMetrics> metrics_;
+
+  const CacheEvictionListener* eviction_listener_ = nullptr;
+};
+
+size_t ClockCache::GetSubCacheCapacity(SubCacheType subcache_type) const {
+  if (FLAGS_cache_single_touch_ratio == 0) {
+    return subcache_type == MULTI_TOUCH ? total_capacity_ : 0;
+  } else if (FLAGS_cache_single_touch_ratio == 1) {
+    return subcache_type == SINGLE_TOUCH ? total_capacity_ : 0;
+  }
+  switch (subcache_type) {
+    case SINGLE_TOUCH:
+      if (strict_capacity_limit_ || !FLAGS_cache_overflow_single_touch) {
+        return total_capacity_ - multi_touch_capacity_;
+      }
+      return total_capacity_ - std::min(total_capacity_, multi_touch_ring_.Usage());
+    case MULTI_TOUCH:
+      return multi_touch_capacity_;
+  }
+  FATAL_INVALID_ENUM_VALUE(SubCacheType, subcache_type);
+}
+
+void ClockCache::RemoveEntry(ClockHandle* e, bool evicted, ClockRetiredList* retired) {
+  GetRing(e->GetSubCacheType())->Remove(e);
+  table_.Remove(e->key(), e->hash);
+  e->in_cache = false;
+  retired->handles.emplace_back(e, evicted);
+}
+
+void ClockCache::FreeRetired(ClockRetiredList* retired, ClockHandleDeleter* deleted) {
+  if (retired->empty()) {
+    return;
+  }
+  readers_lock_.wait_for_readers();
+  for (const auto& p : retired->handles) {
+    if (p.first->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      if (p.second) {
+        deleted->AddEvicted(p.first);
+      } else {
+        deleted->Add(p.first);
+      }
+    }
+  }
+  retired->handles.clear();
+  retired->buckets.clear();
+}
+
+void ClockCache::Promote(ClockHandle* e) {
+  single_touch_ring_.Remove(e);
+  e->query_id.store(kInMultiTouchId, std::memory_order_relaxed);
+  e->referenced.store(false, std::memory_order_relaxed);
+  multi_touch_ring_.Insert(e);
+  if (metrics_) {
+    metrics_->multi_touch_cache_usage->IncrementBy(e->charge);
+    metrics_->single_touch_cache_usage->DecrementBy(e->charge);
+  }
+}
+
+void ClockCache::EvictFromRing(
+    size_t charge, ClockRetiredList* retired, SubCacheType subcache_type) {
+  ClockRing* ring = GetRing(subcache_type);
+  const bool can_promote = subcache_type == SINGLE_TOUCH && FLAGS_cache_single_touch_ratio > 0 &&
+                           FLAGS_cache_single_touch_ratio < 1;
+  // Each entry could be skipped at most once because of its reference bit, so two full turns of
+  // the hand are enough to visit every evictable entry. Pinned entries are skipped and counted.
+  size_t steps_left = 2 * ring->Size();
+  while (!ring->IsEmpty() && steps_left > 0 &&
+         ring->Usage() + charge > GetSubCacheCapacity(subcache_type)) {
+    --steps_left;
+    ClockHandle* e = ring->Hand();
+    assert(e->in_cache);
+    if (can_promote && e->touched_by_other_query.load(std::memory_order_relaxed)) {
+      // Promoting to the multi-touch ring could require space there, so make room first.
+      if (!strict_capacity_limit_ ||
+          multi_touch_ring_.Usage() + e->charge <= multi_touch_capacity_) {
+        Promote(e);
+        EvictFromRing(0, retired, MULTI_TOUCH);
+        continue;
+      }
+    }
+    // A concurrent lookup could still take a new reference after this check. It is fine, such
+    // entry is freed by the last Release instead of FreeRetired.
+    if (e->refs.load(std::memory_order_acquire) > 1 ||
+        e->referenced.exchange(false, std::memory_order_relaxed)) {
+      ring->Advance();
+      continue;
+    }
+    RemoveEntry(e, /* evicted= */ true, retired);
+  }
+}
+
+void ClockCache::SetCapacity(size_t capacity) {
+  ClockHandleDeleter last_reference_list(metrics_.get(), eviction_listener_);
+  ClockRetiredList retired;
+
+  {
+    MutexLock l(&mutex_);
+    std::lock_guard<yb::percpu_rwlock> readers_lock(readers_lock_);
+    multi_touch_capacity_ = round((1 - FLAGS_cache_single_touch_ratio) * capacity);
+    total_capacity_ = capacity;
+    EvictFromRing(0, &retired, MULTI_TOUCH);
+    EvictFromRing(0, &retired, SINGLE_TOUCH);
+  }
+  FreeRetired(&retired, &last_reference_list);
+}
+
+void ClockCache::SetStrictCapacityLimit(bool strict_capacity_limit) {
+  MutexLock l(&mutex_);
+  assert(GetUsage() == 0 || !FLAGS_cache_overflow_single_touch);
+  strict_capacity_limit_ = strict_capacity_limit;
+}
+
+size_t ClockCache::GetPinnedUsage() const {
+  size_t result = 0;
+  MutexLock l(&mutex_);
+  table_.ApplyToAllCacheEntries([&result](ClockHandle* h) {
+    if (h->refs.load(std::memory_order_relaxed) > 1) {
+      result += h->charge;
+    }
+  });
+  return result;
+}
+
+void ClockCache::ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) {
+  auto apply = [this, callback] {
+    table_.ApplyToAllCacheEntries([callback](ClockHandle* h) {
+      callback(h->value, h->charge);
+    });
+  };
+  if (thread_safe) {
+    MutexLock l(&mutex_);
+    std::lock_guard<yb::percpu_rwlock> readers_lock(readers_lock_);
+    apply();
+  } else {
+    apply();
+  }
+}
+
+Cache::Handle* ClockCache::Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
+                                  Statistics* statistics) {
+  ClockHandle* e;
+  {
+    yb::shared_lock<yb::rw_spinlock> l(readers_lock_.get_lock());
+    e = table_.Lookup(key, hash);
+    if (e != nullptr) {
+      // The cache reference to the found entry is dropped only after we release the reader lock,
+      // so the entry is alive.
+      e->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  if (e != nullptr) {
+    ClockHandle::SetFlag(&e->referenced);
+    if (e->query_id.load(std::memory_order_relaxed) != query_id) {
+      ClockHandle::SetFlag(&e->touched_by_other_query);
+    }
+    if (statistics != nullptr) {
+      RecordTick(statistics, BLOCK_CACHE_HIT);
+      RecordTick(statistics, BLOCK_CACHE_BYTES_READ, e->charge);
+      if (e->GetSubCacheType() == SubCacheType::SINGLE_TOUCH) {
+        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_HIT);
+        RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_BYTES_READ, e->charge);
+      } else {
+        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_HIT);
+        RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_BYTES_READ, e->charge);
+      }
+    }
+  } else if (statistics != nullptr) {
+    RecordTick(statistics, BLOCK_CACHE_MISS);
+  }
+
+  if (metrics_ != nullptr) {
+    metrics_->lookups->Increment();
+    if (e != nullptr) {
+      metrics_->cache_hits->Increment();
+    } else {
+      metrics_->cache_misses->Increment();
+    }
+  }
+  return reinterpret_cast<Cache::Handle*>(e);
+}
+
+void ClockCache::Release(Cache::Handle* handle) {
+  if (handle == nullptr) {
+    return;
+  }
+  ClockHandle* e = reinterpret_cast<ClockHandle*>(handle);
+  // Entries that are still in cache are evicted by the clock hand, so we only have to free the
+  // entry if it was already removed from the cache and retired.
+  if (e->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    e->Free(metrics_.get());
+  }
+}
+
+size_t ClockCache::Evict(size_t required) {
+  ClockHandleDeleter evicted(metrics_.get(), eviction_listener_);
+  ClockRetiredList retired;
+  {
+    MutexLock l(&mutex_);
+    EvictFromRing(required, &retired, SINGLE_TOUCH);
+    if (required > retired.TotalCharge()) {
+      EvictFromRing(required, &retired, MULTI_TOUCH);
+    }
+  }
+  FreeRetired(&retired, &evicted);
+  return evicted.TotalCharge();
+}
+
+Status ClockCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
+                          void* value, size_t charge,
+                          void (*deleter)(const Slice& key, void* value),
+                          Cache::Handle** handle, Statistics* statistics) {
+  if (query_id == kNoCacheQueryId) {
+    return Status::OK();
+  }
+  // Allocate the memory here outside of the mutex.
+  ClockHandle* e = new (new char[sizeof(ClockHandle) - 1 + key.size()]) ClockHandle;
+  Status s;
+  ClockHandleDeleter last_reference_list(metrics_.get(), eviction_listener_);
+  ClockRetiredList retired;
+  bool delete_value = false;
+
+  e->value = value;
+  e->deleter = deleter;
+  e->next_hash.store(nullptr, std::memory_order_relaxed);
+  e->next = e->prev = nullptr;
+  e->charge = charge;
+  e->key_length = key.size();
+  e->hash = hash;
+  // One from ClockCache, one for the returned handle.
+  e->refs.store(handle == nullptr ? 1 : 2, std::memory_order_relaxed);
+  e->in_cache = true;
+  e->referenced.store(false, std::memory_order_relaxed);
+  e->touched_by_other_query.store(false, std::memory_order_relaxed);
+  e->query_id.store(query_id, std::memory_order_relaxed);
+  memcpy(e->key_data, key.data(), key.size());
+
+  {
+    MutexLock l(&mutex_);
+    SubCacheType subcache_type;
+    if (FLAGS_cache_single_touch_ratio == 0) {
+      e->query_id.store(kInMultiTouchId, std::memory_order_relaxed);
+      subcache_type = MULTI_TOUCH;
+    } else if (FLAGS_cache_single_touch_ratio == 1) {
+      subcache_type = SINGLE_TOUCH;
+    } else {
+      subcache_type = table_.GetSubCacheTypeCandidate(e);
+    }
+    EvictFromRing(charge, &retired, subcache_type);
+    ClockRing* ring = GetRing(subcache_type);
+    if (strict_capacity_limit_ && ring->Usage() + charge > GetSubCacheCapacity(subcache_type)) {
+      e->~ClockHandle();
+      delete[] reinterpret_cast<char*>(e);
+      if (handle == nullptr) {
+        delete_value = true;
+      } else {
+        *handle = nullptr;
+      }
+      s = STATUS(Incomplete, "Insert failed due to clock cache being full.");
+    } else {
+      ClockHandle* old = table_.Lookup(key, hash);
+      if (old != nullptr) {
+        RemoveEntry(old, /* evicted= */ false, &retired);
+      }
+      table_.Insert(e, &retired);
+      ring->Insert(e);
+      if (handle != nullptr) {
+        *handle = reinterpret_cast<Cache::Handle*>(e);
+      }
+      if (subcache_type == MULTI_TOUCH && FLAGS_cache_single_touch_ratio != 0) {
+        // Same as in LRUCache, inserting directly into multi touch could require eviction from
+        // overflown single touch ring.
+        EvictFromRing(0, &retired, SINGLE_TOUCH);
+      }
+    }
+    if (statistics != nullptr) {
+      if (s.ok()) {
+        RecordTick(statistics, BLOCK_CACHE_ADD);
+        RecordTick(statistics, BLOCK_CACHE_BYTES_WRITE, charge);
+        if (subcache_type == SubCacheType::SINGLE_TOUCH) {
+          RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_ADD);
+          RecordTick(statistics, BLOCK_CACHE_SINGLE_TOUCH_BYTES_WRITE, charge);
+        } else {
+          RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_ADD);
+          RecordTick(statistics, BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE, charge);
+        }
+      } else {
+        RecordTick(statistics, BLOCK_CACHE_ADD_FAILURES);
+      }
+    }
+    if (metrics_ != nullptr && s.ok()) {
+      if (subcache_type == MULTI_TOUCH) {
+        metrics_->multi_touch_cache_usage->IncrementBy(charge);
+      } else {
+        metrics_->single_touch_cache_usage->IncrementBy(charge);
+      }
+      metrics_->cache_usage->IncrementBy(charge);
+    }
+  }
+  FreeRetired(&retired, &last_reference_list);
+
+  // Value is cleaned up on error when caller does not want the handle, see Cache::Insert.
+  if (delete_value) {
+    (*deleter)(key, value);
+  }
+  return s;
+}
+
+void ClockCache::Erase(const Slice& key, uint32_t hash) {
+  ClockHandleDeleter last_reference_list(metrics_.get(), eviction_listener_);
+  ClockRetiredList retired;
+  {
+    MutexLock l(&mutex_);
+    ClockHandle* e = table_.Lookup(key, hash);
+    if (e != nullptr) {
+      RemoveEntry(e, /* evicted= */ false, &retired);
+    }
+  }
+  FreeRetired(&retired, &last_reference_list);
+}
+
 static int kNumShardBits = 4;          // default values, can be overridden
 
-class ShardedLRUCache : public Cache {
+// Cache split into 2^num_shard_bits independent shards of type CacheShard by key hash.
+template <class CacheShard, class HandleType>
+class ShardedCache : public Cache {
  private:
-  LRUCache* shards_;
+  CacheShard* shards_;
   port::Mutex id_mutex_;
   port::Mutex capacity_mutex_;
   uint64_t last_id_;
@@ -850,6 +1602,7 @@ class ShardedLRUCache : public Cache {
   size_t capacity_;
   bool strict_capacity_limit_;
   shared_ptr<yb::CacheMetrics> metrics_;
+  CacheEvictionListener eviction_listener_;
 
   static inline uint32_t HashSlice(const Slice& s) {
     return Hash(s.data(), s.size(), 0);
@@ -865,15 +1618,14 @@ class ShardedLRUCache : public Cache {
   }
 
  public:
-  ShardedLRUCache(size_t capacity, int num_shard_bits,
-                  bool strict_capacity_limit)
+  ShardedCache(size_t capacity, int num_shard_bits, bool strict_capacity_limit)
       : last_id_(0),
         num_shard_bits_(num_shard_bits),
         capacity_(capacity),
         strict_capacity_limit_(strict_capacity_limit),
         metrics_(nullptr) {
     int num_shards = 1 << num_shard_bits_;
-    shards_ = new LRUCache[num_shards];
+    shards_ = new CacheShard[num_shards];
     const size_t per_shard = (capacity + (num_shards - 1)) / num_shards;
     for (int s = 0; s < num_shards; s++) {
       shards_[s].SetStrictCapacityLimit(strict_capacity_limit);
@@ -881,7 +1633,7 @@ class ShardedLRUCache : public Cache {
     }
   }
 
-  virtual ~ShardedLRUCache() {
+  virtual ~ShardedCache() {
     delete[] shards_;
   }
 
@@ -930,7 +1682,7 @@ class ShardedLRUCache : public Cache {
   }
 
   void Release(Handle* handle) override {
-    LRUHandle* h = reinterpret_cast<LRUHandle*>(handle);
+    HandleType* h = reinterpret_cast<HandleType*>(handle);
     shards_[Shard(h->hash)].Release(handle);
   }
 
@@ -940,7 +1692,7 @@ class ShardedLRUCache : public Cache {
   }
 
   void* Value(Handle* handle) override {
-    return reinterpret_cast<LRUHandle*>(handle)->value;
+    return reinterpret_cast<HandleType*>(handle)->value;
   }
 
   uint64_t NewId() override {
@@ -965,7 +1717,7 @@ class ShardedLRUCache : public Cache {
   }
 
   size_t GetUsage(Handle* handle) const override {
-    return reinterpret_cast<LRUHandle*>(handle)->charge;
+    return reinterpret_cast<HandleType*>(handle)->charge;
   }
 
   size_t GetPinnedUsage() const override {
@@ -979,7 +1731,7 @@ class ShardedLRUCache : public Cache {
   }
 
   SubCacheType GetSubCacheType(Handle* e) const override {
-    LRUHandle* h = reinterpret_cast<LRUHandle*>(e);
+    HandleType* h = reinterpret_cast<HandleType*>(e);
     return h->GetSubCacheType();
   }
 
@@ -1003,6 +1755,14 @@ class ShardedLRUCache : public Cache {
     }
   }
 
+  void SetEvictionListener(CacheEvictionListener listener) override {
+    eviction_listener_ = std::move(listener);
+    int num_shards = 1 << num_shard_bits_;
+    for (int s = 0; s < num_shards; s++) {
+      shards_[s].SetEvictionListener(&eviction_listener_);
+    }
+  }
+
   virtual std::vector<std::pair<size_t, size_t>> TEST_GetIndividualUsages() override {
     std::vector<std::pair<size_t, size_t>> cache_sizes;
     cache_sizes.reserve(1 << num_shard_bits_);
@@ -1014,6 +1774,9 @@ class ShardedLRUCache : public Cache {
   }
 };
 
+using ShardedLRUCache = ShardedCache<LRUCache, LRUHandle>;
+using ShardedClockCache = ShardedCache<ClockCache, ClockHandle>;
+
 }  // end anonymous namespace
 
 shared_ptr<Cache> NewLRUCache(size_t capacity) {
@@ -1033,4 +1796,21 @@ shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                                            strict_capacity_limit);
 }
 
+shared_ptr<Cache> NewClockCache(size_t capacity) {
+  return NewClockCache(capacity, kNumShardBits, false);
+}
+
+shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits) {
+  return NewClockCache(capacity, num_shard_bits, false);
+}
+
+shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits,
+                                bool strict_capacity_limit) {
+  if (num_shard_bits >= 20) {
+    return nullptr;  // the cache cannot be sharded into too many fine pieces
+  }
+  return std::make_shared<ShardedClockCache>(capacity, num_shard_bits,
+                                             strict_capacity_limit);
+}
+
 }  // namespace rocksdb
@@ -23,8 +23,10 @@
 
 #include <forward_list>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 
 #include "yb/rocksdb/cache.h"
@@ -70,6 +72,9 @@ class CacheTest : public RocksDBTest {
 
   static const QueryId kTestQueryId = 1;
 
+  // Tests change cache flags, restore them after each test. Declared first, so flags are restored
+  // after caches of the test are destroyed.
+  google::FlagSaver flag_saver_;
   std::vector<int> deleted_keys_;
   std::vector<int> deleted_values_;
   shared_ptr<Cache> cache_;
@@ -743,6 +748,190 @@ TEST_F(CacheTest, OverFlowTest) {
   cache->Release(h);
 }
 
+
+TEST_F(CacheTest, EvictionListener) {
+  FLAGS_cache_single_touch_ratio = 0.2;
+  std::vector<int> evicted_keys;
+  for (bool use_clock : {false, true}) {
+    evicted_keys.clear();
+    deleted_keys_.clear();
+    constexpr int kCapacity = 10;
+    auto cache = use_clock ? NewClockCache(kCapacity, 0) : NewLRUCache(kCapacity, 0);
+    cache->SetEvictionListener(
+        [&evicted_keys](const Slice& key, void* value, void (*deleter)(const Slice&, void*)) {
+      ASSERT_EQ(deleter, &CacheTest::Deleter);
+      ASSERT_EQ(DecodeKey(key), DecodeValue(value));
+      evicted_keys.push_back(DecodeKey(key));
+    });
+
+    for (int i = 0; i < kCapacity; ++i) {
+      ASSERT_OK(Insert(cache, i, i));
+    }
+    // Erased and replaced entries are not reported.
+    Erase(cache, 0);
+    ASSERT_OK(Insert(cache, 1, 1));
+    ASSERT_TRUE(evicted_keys.empty());
+    ASSERT_EQ(2U, deleted_keys_.size());
+
+    for (int i = kCapacity; i < 2 * kCapacity; ++i) {
+      ASSERT_OK(Insert(cache, i, i));
+    }
+    ASSERT_EQ(static_cast<size_t>(kCapacity - 1), evicted_keys.size());
+    ASSERT_EQ(deleted_keys_.size(), evicted_keys.size() + 2);
+  }
+}
+
+TEST_F(CacheTest, ClockCacheBasic) {
+  FLAGS_cache_single_touch_ratio = 0.2;
+  auto cache = NewClockCache(kCacheSize, kNumShardBits);
+
+  ASSERT_EQ(-1, Lookup(cache, 100));
+  ASSERT_OK(Insert(cache, 100, 101));
+  ASSERT_EQ(101, Lookup(cache, 100));
+  ASSERT_OK(Insert(cache, 200, 201));
+  ASSERT_EQ(201, Lookup(cache, 200));
+  ASSERT_EQ(2U, cache->GetUsage());
+
+  // Replaced entry is deleted only after the last handle to it is released.
+  Cache::Handle* h = cache->Lookup(EncodeKey(100), kTestQueryId);
+  ASSERT_OK(Insert(cache, 100, 102));
+  ASSERT_EQ(102, Lookup(cache, 100));
+  ASSERT_EQ(0U, deleted_keys_.size());
+  ASSERT_EQ(101, DecodeValue(cache->Value(h)));
+  cache->Release(h);
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(101, deleted_values_[0]);
+
+  Erase(cache, 100);
+  ASSERT_EQ(-1, Lookup(cache, 100));
+  ASSERT_EQ(2U, deleted_keys_.size());
+  ASSERT_EQ(102, deleted_values_[1]);
+  ASSERT_EQ(1U, cache->GetUsage());
+}
+
+TEST_F(CacheTest, ClockCacheSecondChance) {
+  FLAGS_cache_single_touch_ratio = 0;
+  constexpr int kCapacity = 10;
+  auto cache = NewClockCache(kCapacity, 0);
+
+  for (int i = 0; i < kCapacity; ++i) {
+    ASSERT_OK(Insert(cache, i, i));
+  }
+  // Referenced entry should be skipped by the clock hand, so the next oldest one is evicted.
+  ASSERT_EQ(0, Lookup(cache, 0));
+  ASSERT_OK(Insert(cache, kCapacity, kCapacity));
+  ASSERT_EQ(0, Lookup(cache, 0));
+  ASSERT_EQ(-1, Lookup(cache, 1));
+  ASSERT_EQ(kCapacity, cache->GetUsage());
+
+  // Pinned entries are never evicted.
+  Cache::Handle* h = cache->Lookup(EncodeKey(2), kTestQueryId);
+  ASSERT_NE(h, nullptr);
+  for (int i = 0; i < 2 * kCapacity; ++i) {
+    ASSERT_OK(Insert(cache, 100 + i, 100 + i));
+  }
+  ASSERT_EQ(1U, cache->GetPinnedUsage());
+  ASSERT_EQ(2, Lookup(cache, 2));
+  cache->Release(h);
+  ASSERT_EQ(0U, cache->GetPinnedUsage());
+  FLAGS_cache_single_touch_ratio = 0.2;
+}
+
+TEST_F(CacheTest, ClockCacheScanResistance) {
+  FLAGS_cache_single_touch_ratio = 0.2;
+  constexpr int kCapacity = 100;
+  auto cache = NewClockCache(kCapacity, 0);
+  QueryId qid1 = 1000;
+  QueryId qid2 = 1001;
+  QueryId scan_qid = 1002;
+
+  ASSERT_OK(Insert(cache, 1, 1, 1, qid1));
+  ASSERT_EQ(1, Lookup(cache, 1, qid2));
+  // Promotion is lazy, entry stays single touch until the clock hand reaches it.
+  ASSERT_FALSE(LookupAndCheckInMultiTouch(cache, 1, 1, qid2));
+  ASSERT_OK(Insert(cache, 2, 2, 1, qid1));
+  ASSERT_EQ(2, Lookup(cache, 2, qid1));
+
+  // Scan that touches each entry by a single query should not evict entries that were touched by
+  // different queries.
+  for (int i = 0; i < 10 * kCapacity; ++i) {
+    ASSERT_OK(Insert(cache, 1000 + i, 1000 + i, 1, scan_qid));
+    ASSERT_EQ(1000 + i, Lookup(cache, 1000 + i, scan_qid));
+  }
+  ASSERT_TRUE(LookupAndCheckInMultiTouch(cache, 1, 1, qid2));
+  ASSERT_EQ(-1, Lookup(cache, 2));
+  ASSERT_LE(cache->GetUsage(), kCapacity);
+  AssertCacheSizes(cache.get(), kCapacity - 1, 1);
+}
+
+TEST_F(CacheTest, ClockCacheConcurrentAccess) {
+  FLAGS_cache_single_touch_ratio = 0.2;
+  constexpr int kNumThreads = 8;
+  constexpr int kNumKeys = 1000;
+  constexpr int kOperations = 50000;
+  auto cache = NewClockCache(kNumKeys / 4, 2);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kNumThreads; ++t) {
+    threads.emplace_back([cache, t] {
+      for (int i = 0; i != kOperations; ++i) {
+        int key = (i * 7919 + t * 104729) % kNumKeys;
+        Cache::Handle* h = cache->Lookup(EncodeKey(key), t);
+        if (h == nullptr) {
+          ASSERT_OK(cache->Insert(EncodeKey(key), t, EncodeValue(key), 1, &dumbDeleter, &h));
+        }
+        ASSERT_EQ(key, DecodeValue(cache->Value(h)));
+        cache->Release(h);
+        if (i % 100 == 0) {
+          cache->Erase(EncodeKey(key));
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(0U, cache->GetPinnedUsage());
+}
+
+// Lookups do not take the shard mutex, so they run concurrently with table growth and eviction
+// done by inserts.
+TEST_F(CacheTest, ClockCacheLookupDuringResizeAndEviction) {
+  FLAGS_cache_single_touch_ratio = 0.2;
+  constexpr int kNumReaders = 4;
+  constexpr int kNumHotKeys = 16;
+  constexpr int kNumInserts = 100000;
+  auto cache = NewClockCache(kNumInserts / 10, 0);
+  for (int i = 0; i != kNumHotKeys; ++i) {
+    ASSERT_OK(Insert(cache, i, i));
+  }
+
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> readers;
+  for (int t = 0; t != kNumReaders; ++t) {
+    readers.emplace_back([cache, &stop, t] {
+      while (!stop.load(std::memory_order_acquire)) {
+        for (int key = 0; key != kNumHotKeys; ++key) {
+          Cache::Handle* h = cache->Lookup(EncodeKey(key), t);
+          if (h != nullptr) {
+            ASSERT_EQ(key, DecodeValue(cache->Value(h)));
+            cache->Release(h);
+          }
+        }
+      }
+    });
+  }
+  for (int i = kNumHotKeys; i != kNumInserts; ++i) {
+    ASSERT_OK(cache->Insert(EncodeKey(i), kTestQueryId, EncodeValue(i), 1, &dumbDeleter));
+  }
+  stop.store(true, std::memory_order_release);
+  for (auto& thread : readers) {
+    thread.join();
+  }
+  ASSERT_LE(cache->GetUsage(), kNumInserts / 10);
+  ASSERT_EQ(0U, cache->GetPinnedUsage());
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
@@ -95,7 +95,9 @@ ImmutableCFOptions::ImmutableCFOptions(const Options& options)
       mem_tracker(options.mem_tracker),
       block_based_table_mem_tracker(options.block_based_table_mem_tracker),
       iterator_replacer(options.iterator_replacer),
-      compaction_file_filter_factory(options.compaction_file_filter_factory.get()) {}
+      compaction_file_filter_factory(options.compaction_file_filter_factory.get()),
+      cold_compaction_output(options.cold_compaction_output),
+      compaction_time_window(options.compaction_time_window) {}
 
 ColumnFamilyOptions::ColumnFamilyOptions()
     : comparator(BytewiseComparator()),
@@ -23,6 +23,9 @@
 
 #include "yb/rocksdb/util/rate_limiter.h"
 #include "yb/rocksdb/env.h"
+
+#include <algorithm>
+
 #include <glog/logging.h>
 
 namespace rocksdb {
@@ -30,20 +33,64 @@ namespace rocksdb {
 
 // Pending request
 struct GenericRateLimiter::Req {
-  explicit Req(int64_t _bytes, port::Mutex* _mu)
-      : bytes(_bytes), cv(_mu), granted(false) {}
+  Req(int64_t _bytes, const void* _owner, port::Mutex* _mu)
+      : bytes(_bytes), owner(_owner), cv(_mu), granted(false) {}
   int64_t bytes;
+  const void* owner;
   port::CondVar cv;
   bool granted;
 };
 
+namespace {
+
+class RateLimiterShare : public RateLimiter {
+ public:
+  explicit RateLimiterShare(std::shared_ptr<RateLimiter> base)
+      : base_(std::move(base)), generic_base_(dynamic_cast<GenericRateLimiter*>(base_.get())) {}
+
+  void SetBytesPerSecond(int64_t bytes_per_second) override {
+    base_->SetBytesPerSecond(bytes_per_second);
+  }
+
+  void Request(const int64_t bytes, const Env::IOPriority pri) override {
+    if (generic_base_) {
+      generic_base_->RequestFrom(this, bytes, pri);
+    } else {
+      base_->Request(bytes, pri);
+    }
+  }
+
+  int64_t GetSingleBurstBytes() const override {
+    return base_->GetSingleBurstBytes();
+  }
+
+  int64_t GetTotalBytesThrough(const Env::IOPriority pri) const override {
+    return base_->GetTotalBytesThrough(pri);
+  }
+
+  int64_t GetTotalRequests(const Env::IOPriority pri) const override {
+    return base_->GetTotalRequests(pri);
+  }
+
+  RateLimiter* base() const {
+    return base_.get();
+  }
+
+ private:
+  const std::shared_ptr<RateLimiter> base_;
+  GenericRateLimiter* const generic_base_;
+};
+
+} // namespace
+
 GenericRateLimiter::GenericRateLimiter(int64_t rate_bytes_per_sec,
                                        int64_t refill_period_us,
-                                       int32_t fairness)
+                                       int32_t fairness,
+                                       Env* env)
     : refill_period_us_(refill_period_us),
       refill_bytes_per_period_(
           CalculateRefillBytesPerPeriod(rate_bytes_per_sec)),
-      env_(Env::Default()),
+      env_(env),
       stop_(false),
       exit_cv_(&request_mutex_),
       requests_to_wait_(0),
@@ -63,11 +110,10 @@ GenericRateLimiter::~GenericRateLimiter() {
   stop_ = true;
   requests_to_wait_ = static_cast<int32_t>(queue_[Env::IO_LOW].size() +
                                            queue_[Env::IO_HIGH].size());
-  for (auto& r : queue_[Env::IO_HIGH]) {
-    r->cv.Signal();
-  }
-  for (auto& r : queue_[Env::IO_LOW]) {
-    r->cv.Signal();
+  for (const auto& queue : queue_) {
+    queue.ForEach([](Req* r) {
+      r->cv.Signal();
+    });
   }
   while (requests_to_wait_ > 0) {
     exit_cv_.Wait();
@@ -85,13 +131,46 @@ void GenericRateLimiter::SetBytesPerSecond(int64_t bytes_per_second) {
 }
 
 void GenericRateLimiter::Request(int64_t bytes, const Env::IOPriority pri) {
-  assert(bytes <= refill_bytes_per_period_.load(std::memory_order_relaxed));
+  RequestFrom(nullptr, bytes, pri);
+}
+
+GenericRateLimiter::Req* GenericRateLimiter::RequestQueue::front() const {
+  return owner_queues_.find(owners_.front())->second.front();
+}
 
+void GenericRateLimiter::RequestQueue::push_back(Req* req) {
+  auto& owner_queue = owner_queues_[req->owner];
+  if (owner_queue.empty()) {
+    owners_.push_back(req->owner);
+  }
+  owner_queue.push_back(req);
+  ++size_;
+}
+
+void GenericRateLimiter::RequestQueue::pop_front() {
+  const void* owner = owners_.front();
+  owners_.pop_front();
+  auto it = owner_queues_.find(owner);
+  it->second.pop_front();
+  if (it->second.empty()) {
+    owner_queues_.erase(it);
+  } else {
+    owners_.push_back(owner);
+  }
+  --size_;
+}
+
+void GenericRateLimiter::RequestFrom(
+    const void* owner, int64_t bytes, const Env::IOPriority pri) {
   MutexLock g(&request_mutex_);
   if (stop_) {
     return;
   }
 
+  // Rate could be lowered by SetBytesPerSecond after the caller split its I/O into chunks of
+  // GetSingleBurstBytes(), so clamp the request to the current burst size.
+  bytes = std::min(bytes, refill_bytes_per_period_.load(std::memory_order_relaxed));
+
   ++total_requests_[pri];
 
   if (available_bytes_ >= bytes) {
@@ -104,7 +183,7 @@ void GenericRateLimiter::Request(int64_t bytes, const Env::IOPriority pri) {
   }
 
   // Request cannot be satisfied at this moment, enqueue
-  Req r(bytes, &request_mutex_);
+  Req r(bytes, owner, &request_mutex_);
   queue_[pri].push_back(&r);
 
   do {
@@ -191,7 +270,12 @@ void GenericRateLimiter::Request(int64_t bytes, const Env::IOPriority pri) {
 }
 
 void GenericRateLimiter::Refill() {
-  next_refill_us_ = env_->NowMicros() + refill_period_us_;
+  const auto now = env_->NowMicros();
+  // Env with mocked time could be behind the clock used by TimedWait.
+  if (now < next_refill_us_) {
+    return;
+  }
+  next_refill_us_ = now + refill_period_us_;
   // Carry over the left over quota from the last period
   auto refill_bytes_per_period =
       refill_bytes_per_period_.load(std::memory_order_relaxed);
@@ -205,6 +289,8 @@ void GenericRateLimiter::Refill() {
     auto* queue = &queue_[use_pri];
     while (!queue->empty()) {
       auto* next_req = queue->front();
+      // Requests enqueued before the rate was lowered could exceed the new burst size.
+      next_req->bytes = std::min(next_req->bytes, refill_bytes_per_period);
       if (available_bytes_ < next_req->bytes) {
         break;
       }
@@ -230,4 +316,13 @@ RateLimiter* NewGenericRateLimiter(
       rate_bytes_per_sec, refill_period_us, fairness);
 }
 
+std::shared_ptr<RateLimiter> NewRateLimiterShare(std::shared_ptr<RateLimiter> base) {
+  return std::make_shared<RateLimiterShare>(std::move(base));
+}
+
+RateLimiter* GetBaseRateLimiter(RateLimiter* rate_limiter) {
+  auto* share = dynamic_cast<RateLimiterShare*>(rate_limiter);
+  return share ? share->base() : rate_limiter;
+}
+
 }  // namespace rocksdb
@@ -25,6 +25,7 @@
 
 #include <atomic>
 #include <deque>
+#include <unordered_map>
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/util/mutexlock.h"
 #include "yb/rocksdb/util/random.h"
@@ -36,7 +37,7 @@ namespace rocksdb {
 class GenericRateLimiter : public RateLimiter {
  public:
   GenericRateLimiter(int64_t refill_bytes,
-      int64_t refill_period_us, int32_t fairness);
+      int64_t refill_period_us, int32_t fairness, Env* env = Env::Default());
 
   virtual ~GenericRateLimiter();
 
@@ -48,6 +49,11 @@ class GenericRateLimiter : public RateLimiter {
   // bytes <= GetSingleBurstBytes()
   virtual void Request(const int64_t bytes, const Env::IOPriority pri) override;
 
+  // The same as Request, but waiting requests with different owners are granted in round robin
+  // order, requests of the same owner are granted in FIFO order. Requests without owner
+  // (nullptr) are treated as requests of a single owner.
+  void RequestFrom(const void* owner, const int64_t bytes, const Env::IOPriority pri);
+
   virtual int64_t GetSingleBurstBytes() const override {
     return refill_bytes_per_period_.load(std::memory_order_relaxed);
   }
@@ -71,7 +77,45 @@ class GenericRateLimiter : public RateLimiter {
     return total_requests_[pri];
   }
 
+  size_t TEST_GetNumWaitingRequests() const {
+    MutexLock g(&request_mutex_);
+    return queue_[Env::IO_LOW].size() + queue_[Env::IO_HIGH].size();
+  }
+
  private:
+  struct Req;
+
+  // Queue of waiting requests of the same priority. Each owner has its own FIFO queue, and owners
+  // are served in round robin order, so the position of a request does not depend on how many
+  // requests other owners enqueue after it.
+  class RequestQueue {
+   public:
+    bool empty() const { return owners_.empty(); }
+    size_t size() const { return size_; }
+
+    // Front request is not changed by push_back, so the leader stays at the front of its queue
+    // until it is granted.
+    Req* front() const;
+    void push_back(Req* req);
+    // Removes the front request and moves its owner to the end of the round.
+    void pop_front();
+
+    template <class F>
+    void ForEach(const F& f) const {
+      for (const auto& owner_and_queue : owner_queues_) {
+        for (auto* req : owner_and_queue.second) {
+          f(req);
+        }
+      }
+    }
+
+   private:
+    std::unordered_map<const void*, std::deque<Req*>> owner_queues_;
+    // Owners that have waiting requests, in the order they are served.
+    std::deque<const void*> owners_;
+    size_t size_ = 0;
+  };
+
   void Refill();
   int64_t CalculateRefillBytesPerPeriod(int64_t rate_bytes_per_sec) {
     return rate_bytes_per_sec * refill_period_us_ / 1000000;
@@ -97,9 +141,8 @@ class GenericRateLimiter : public RateLimiter {
   int32_t fairness_;
   Random rnd_;
 
-  struct Req;
   Req* leader_;
-  std::deque<Req*> queue_[Env::IO_TOTAL];
+  RequestQueue queue_[Env::IO_TOTAL];
 };
 
 }  // namespace rocksdb
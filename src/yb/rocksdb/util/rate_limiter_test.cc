@@ -26,8 +26,11 @@
 #endif
 
 #include <inttypes.h>
+#include <atomic>
 #include <limits>
 #include <string>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/util/rate_limiter.h"
@@ -35,6 +38,11 @@
 
 #include "yb/rocksdb/util/testutil.h"
 
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
 namespace rocksdb {
 
 class RateLimiterTest : public RocksDBTest {};
@@ -106,6 +114,125 @@ TEST_F(RateLimiterTest, Rate) {
 }
 #endif
 
+namespace {
+
+// Time is advanced only by the test, so the number of refills is controlled by the test.
+class MockTimeEnv : public EnvWrapper {
+ public:
+  MockTimeEnv() : EnvWrapper(Env::Default()) {}
+
+  uint64_t NowMicros() override {
+    return now_micros_.load(std::memory_order_acquire);
+  }
+
+  void Advance(uint64_t delta_micros) {
+    now_micros_.fetch_add(delta_micros, std::memory_order_acq_rel);
+  }
+
+ private:
+  std::atomic<uint64_t> now_micros_{1000};
+};
+
+} // namespace
+
+TEST_F(RateLimiterTest, ShareFairness) {
+  constexpr int64_t kRequestSize = 100;
+  constexpr int64_t kRefillPeriodUs = 100 * 1000;
+  constexpr int kBusyShareThreads = 4;
+  constexpr int kNumThreads = kBusyShareThreads + 1;
+  constexpr int kNumRefills = 100;
+
+  MockTimeEnv env;
+  // Single request is granted per refill period.
+  auto* generic_base = new GenericRateLimiter(
+      kRequestSize * 1000000 / kRefillPeriodUs, kRefillPeriodUs, /* fairness= */ 10, &env);
+  std::shared_ptr<RateLimiter> base(generic_base);
+  auto busy_share = NewRateLimiterShare(base);
+  auto other_share = NewRateLimiterShare(base);
+  ASSERT_EQ(base.get(), GetBaseRateLimiter(busy_share.get()));
+  ASSERT_EQ(base.get(), GetBaseRateLimiter(base.get()));
+
+  std::atomic<bool> stop(false);
+  std::atomic<int> busy_requests(0);
+  std::atomic<int> other_requests(0);
+  std::atomic<int> finished_threads(0);
+  std::vector<std::thread> threads;
+  auto writer = [&stop, &finished_threads](RateLimiter* limiter, std::atomic<int>* requests) {
+    while (!stop.load()) {
+      limiter->Request(kRequestSize, Env::IO_LOW);
+      ++*requests;
+    }
+    ++finished_threads;
+  };
+  for (int i = 0; i != kBusyShareThreads; ++i) {
+    threads.emplace_back(writer, busy_share.get(), &busy_requests);
+  }
+  threads.emplace_back(writer, other_share.get(), &other_requests);
+
+  // Refill happens only after all threads are waiting, so the order of grants depends only on the
+  // queue and not on thread scheduling.
+  auto wait_all_waiting = [generic_base] {
+    ASSERT_OK(yb::LoggedWaitFor([generic_base] {
+      return generic_base->TEST_GetNumWaitingRequests() == static_cast<size_t>(kNumThreads);
+    }, 30s, "All threads are waiting"));
+  };
+  ASSERT_NO_FATALS(wait_all_waiting());
+  const int initial_busy_requests = busy_requests;
+  const int initial_other_requests = other_requests;
+  for (int i = 0; i != kNumRefills; ++i) {
+    const int granted_requests = busy_requests + other_requests;
+    env.Advance(kRefillPeriodUs);
+    ASSERT_OK(yb::LoggedWaitFor([&] {
+      return busy_requests + other_requests == granted_requests + 1;
+    }, 30s, "Request granted"));
+    ASSERT_NO_FATALS(wait_all_waiting());
+  }
+
+  // FIFO order would give the other share only 1/5 of the requests, while round robin alternates
+  // between the shares.
+  ASSERT_EQ(kNumRefills / 2, busy_requests - initial_busy_requests);
+  ASSERT_EQ(kNumRefills / 2, other_requests - initial_other_requests);
+
+  stop = true;
+  while (finished_threads != kNumThreads) {
+    env.Advance(kRefillPeriodUs);
+    std::this_thread::sleep_for(1ms);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+TEST_F(RateLimiterTest, LowerRateWithPendingRequests) {
+  constexpr int kThreads = 4;
+  std::unique_ptr<RateLimiter> limiter(NewGenericRateLimiter(1024 * 1024));
+  const int64_t request_size = limiter->GetSingleBurstBytes();
+
+  std::atomic<bool> stop(false);
+  std::atomic<int> requests(0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i != kThreads; ++i) {
+    threads.emplace_back([&limiter, &stop, &requests, request_size] {
+      while (!stop.load()) {
+        // Requests sized by the old burst size should be clamped instead of hanging or failing.
+        limiter->Request(request_size, Env::IO_LOW);
+        ++requests;
+      }
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  limiter->SetBytesPerSecond(100 * 1024);
+  const int requests_before = requests.load();
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  stop = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_GT(requests.load(), requests_before);
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
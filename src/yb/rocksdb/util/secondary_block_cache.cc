@@ -0,0 +1,528 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/secondary_block_cache.h"
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/rocksdb/env.h"
+#include "yb/rocksdb/port/port.h"
+#include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/crc32c.h"
+#include "yb/rocksdb/util/mutexlock.h"
+
+#include "yb/util/logging.h"
+#include "yb/util/mem_tracker.h"
+#include "yb/util/metrics.h"
+#include "yb/util/status_log.h"
+#include "yb/util/thread.h"
+
+METRIC_DEFINE_counter(server, secondary_block_cache_lookups,
+                      "Secondary Block Cache Lookups", yb::MetricUnit::kBlocks,
+                      "Number of blocks looked up from the secondary block cache");
+METRIC_DEFINE_counter(server, secondary_block_cache_hits,
+                      "Secondary Block Cache Hits", yb::MetricUnit::kBlocks,
+                      "Number of lookups that found a block in the secondary block cache");
+METRIC_DEFINE_counter(server, secondary_block_cache_inserts,
+                      "Secondary Block Cache Inserts", yb::MetricUnit::kBlocks,
+                      "Number of blocks written to the secondary block cache");
+METRIC_DEFINE_counter(server, secondary_block_cache_dropped_inserts,
+                      "Secondary Block Cache Dropped Inserts", yb::MetricUnit::kBlocks,
+                      "Number of blocks that were not admitted to the secondary block cache "
+                      "because too many blocks were waiting to be written");
+METRIC_DEFINE_counter(server, secondary_block_cache_evicted_bytes,
+                      "Secondary Block Cache Evicted Bytes", yb::MetricUnit::kBytes,
+                      "Number of bytes evicted from the secondary block cache");
+METRIC_DEFINE_gauge_uint64(server, secondary_block_cache_usage,
+                           "Secondary Block Cache Usage", yb::MetricUnit::kBytes,
+                           "Number of bytes stored in the secondary block cache");
+
+namespace rocksdb {
+
+namespace {
+
+const std::string kCacheFilePrefix = "secondary_block_cache-";
+constexpr size_t kChecksumSize = sizeof(uint32_t);
+constexpr size_t kNumIndexShards = 16;
+
+struct SecondaryBlockCacheMetrics {
+  explicit SecondaryBlockCacheMetrics(const scoped_refptr<yb::MetricEntity>& entity)
+      : lookups(METRIC_secondary_block_cache_lookups.Instantiate(entity)),
+        hits(METRIC_secondary_block_cache_hits.Instantiate(entity)),
+        inserts(METRIC_secondary_block_cache_inserts.Instantiate(entity)),
+        dropped_inserts(METRIC_secondary_block_cache_dropped_inserts.Instantiate(entity)),
+        evicted_bytes(METRIC_secondary_block_cache_evicted_bytes.Instantiate(entity)),
+        usage(METRIC_secondary_block_cache_usage.Instantiate(entity, 0)) {}
+
+  scoped_refptr<yb::Counter> lookups;
+  scoped_refptr<yb::Counter> hits;
+  scoped_refptr<yb::Counter> inserts;
+  scoped_refptr<yb::Counter> dropped_inserts;
+  scoped_refptr<yb::Counter> evicted_bytes;
+  scoped_refptr<yb::AtomicGauge<uint64_t>> usage;
+};
+
+struct CacheFile {
+  std::string path;
+  std::unique_ptr<RandomAccessFile> reader;
+  // Keys of the blocks stored in this file, used to clean up index on eviction.
+  // Index refers to these keys, so the container should not relocate them.
+  std::deque<std::string> keys;
+  size_t size = 0;
+};
+
+struct BlockLocation {
+  // Readers keep the file alive, so it could be safely evicted while being read.
+  std::shared_ptr<CacheFile> file;
+  uint64_t offset;
+  size_t size;
+};
+
+// Index key points to the key stored in CacheFile::keys, so lookup does not have to allocate.
+typedef std::unordered_map<Slice, BlockLocation, Slice::Hash> BlockIndex;
+
+// Approximate DRAM used by the index entry for the specified key, including the key copy stored
+// in CacheFile::keys.
+size_t IndexEntryMemoryUsage(const Slice& key) {
+  return key.size() + sizeof(std::string) + sizeof(BlockIndex::value_type) + 2 * sizeof(void*);
+}
+
+struct IndexShard {
+  port::Mutex mutex;
+  BlockIndex index;
+};
+
+class FileSecondaryBlockCache : public SecondaryBlockCache {
+ public:
+  explicit FileSecondaryBlockCache(const FileSecondaryBlockCacheOptions& options)
+      : options_(options),
+        file_size_(std::max<size_t>(std::min(options.file_size, options.capacity / 4), 1)),
+        queue_cond_(&queue_mutex_) {
+    if (options.metric_entity) {
+      metrics_ = std::make_unique<SecondaryBlockCacheMetrics>(options.metric_entity);
+    }
+    if (options.parent_mem_tracker) {
+      mem_tracker_ = yb::MemTracker::FindOrCreateTracker(
+          "SecondaryBlockCache", options.parent_mem_tracker);
+    }
+  }
+
+  ~FileSecondaryBlockCache() {
+    {
+      MutexLock l(&queue_mutex_);
+      closing_ = true;
+      queue_cond_.SignalAll();
+    }
+    if (writer_thread_) {
+      writer_thread_->Join();
+    }
+    if (writer_) {
+      WARN_NOT_OK(writer_->Close(), "Failed to close secondary block cache file");
+    }
+    for (const auto& file : files_) {
+      WARN_NOT_OK(options_.env->DeleteFile(file->path),
+                  "Failed to delete secondary block cache file");
+    }
+    if (mem_tracker_) {
+      mem_tracker_->Release(tracked_memory_.load(std::memory_order_acquire));
+    }
+  }
+
+  Status Init() {
+    RETURN_NOT_OK(options_.env->CreateDirIfMissing(options_.path));
+    std::vector<std::string> children;
+    RETURN_NOT_OK(options_.env->GetChildren(options_.path, &children));
+    // Cache content is not persisted across restarts, so clean up files left by previous run.
+    for (const auto& child : children) {
+      if (child.compare(0, kCacheFilePrefix.size(), kCacheFilePrefix) == 0) {
+        RETURN_NOT_OK(options_.env->DeleteFile(JoinPath(child)));
+      }
+    }
+    return yb::Thread::Create(
+        "rocksdb", "secondary_block_cache_writer", &FileSecondaryBlockCache::BackgroundWriter,
+        this, &writer_thread_);
+  }
+
+  void Insert(const Slice& key, const Slice& contents) override {
+    if (EncryptionEnabled()) {
+      if (!dropped_for_encryption_.load(std::memory_order_acquire)) {
+        MutexLock l(&queue_mutex_);
+        drop_requested_ = true;
+        queue_cond_.SignalAll();
+      }
+      DroppedInsert();
+      return;
+    }
+    const size_t bytes = key.size() + contents.size();
+    // Check the limit before copying, so blocks that would be dropped anyway are not copied.
+    if (pending_bytes_.load(std::memory_order_acquire) + bytes > options_.max_pending_bytes) {
+      DroppedInsert();
+      return;
+    }
+    // Block contents could be large, so copy them before taking the mutex. This method is invoked
+    // from the block cache eviction listener, that is called without holding block cache locks.
+    std::pair<std::string, std::string> entry(key.ToBuffer(), contents.ToBuffer());
+    {
+      MutexLock l(&queue_mutex_);
+      const auto pending_bytes = pending_bytes_.load(std::memory_order_relaxed);
+      if (!closing_ && pending_bytes + bytes <= options_.max_pending_bytes) {
+        queue_.push_back(std::move(entry));
+        pending_bytes_.store(pending_bytes + bytes, std::memory_order_release);
+        ConsumeMemory(bytes);
+        queue_cond_.SignalAll();
+        return;
+      }
+    }
+    DroppedInsert();
+  }
+
+  bool Lookup(const Slice& key, std::unique_ptr<char[]>* data, size_t* size) override {
+    if (metrics_) {
+      metrics_->lookups->Increment();
+    }
+    if (EncryptionEnabled()) {
+      return false;
+    }
+    BlockLocation location;
+    {
+      auto& shard = IndexShardFor(key);
+      MutexLock l(&shard.mutex);
+      auto it = shard.index.find(key);
+      if (it == shard.index.end()) {
+        return false;
+      }
+      location = it->second;
+    }
+
+    const size_t record_size = location.size + kChecksumSize;
+    std::unique_ptr<char[]> buffer(new char[record_size]);
+    Slice result;
+    auto status = location.file->reader->Read(
+        location.offset, record_size, &result, buffer.get());
+    if (!status.ok() || result.size() != record_size) {
+      YB_LOG_EVERY_N_SECS(WARNING, 10)
+          << "Failed to read block from " << location.file->path << ": " << status;
+      return false;
+    }
+    const uint32_t expected_checksum = crc32c::Unmask(DecodeFixed32(result.cdata() + location.size));
+    if (crc32c::Value(result.cdata(), location.size) != expected_checksum) {
+      YB_LOG_EVERY_N_SECS(WARNING, 10)
+          << "Checksum mismatch for block in " << location.file->path << " at "
+          << location.offset;
+      return false;
+    }
+    if (result.cdata() != buffer.get()) {
+      memcpy(buffer.get(), result.cdata(), location.size);
+    }
+
+    if (metrics_) {
+      metrics_->hits->Increment();
+    }
+    *data = std::move(buffer);
+    *size = location.size;
+    return true;
+  }
+
+  size_t GetUsage() const override {
+    MutexLock l(&mutex_);
+    return usage_;
+  }
+
+  void TEST_WaitForPendingInserts() override {
+    MutexLock l(&queue_mutex_);
+    while (!queue_.empty() || writing_ || drop_requested_) {
+      queue_cond_.Wait();
+    }
+  }
+
+ private:
+  std::string JoinPath(const std::string& name) const {
+    return options_.path + "/" + name;
+  }
+
+  IndexShard& IndexShardFor(const Slice& key) {
+    return index_shards_[key.hash() % kNumIndexShards];
+  }
+
+  bool EncryptionEnabled() const {
+    return options_.encryption_enabled && options_.encryption_enabled();
+  }
+
+  void DroppedInsert() {
+    if (metrics_) {
+      metrics_->dropped_inserts->Increment();
+    }
+  }
+
+  void ConsumeMemory(size_t bytes) {
+    tracked_memory_.fetch_add(bytes, std::memory_order_acq_rel);
+    if (mem_tracker_) {
+      mem_tracker_->Consume(bytes);
+    }
+  }
+
+  void ReleaseMemory(size_t bytes) {
+    tracked_memory_.fetch_sub(bytes, std::memory_order_acq_rel);
+    if (mem_tracker_) {
+      mem_tracker_->Release(bytes);
+    }
+  }
+
+  void BackgroundWriter() {
+    for (;;) {
+      std::pair<std::string, std::string> entry;
+      bool has_entry = false;
+      {
+        MutexLock l(&queue_mutex_);
+        while (queue_.empty() && !closing_ && !drop_requested_) {
+          queue_cond_.Wait();
+        }
+        if (closing_) {
+          return;
+        }
+        drop_requested_ = false;
+        if (!queue_.empty()) {
+          entry = std::move(queue_.front());
+          queue_.pop_front();
+          has_entry = true;
+        }
+        writing_ = true;
+      }
+
+      // Encryption could be enabled after the block was queued, so check it again before writing.
+      Status status;
+      if (EncryptionEnabled()) {
+        DropAllFiles();
+      } else if (has_entry) {
+        status = Write(entry.first, entry.second);
+      }
+      if (!status.ok()) {
+        YB_LOG_EVERY_N_SECS(WARNING, 10) << "Failed to write secondary block cache: " << status;
+        // Start a new file on next write, since the state of the current one is unknown.
+        if (writer_) {
+          WARN_NOT_OK(writer_->Close(), "Failed to close secondary block cache file");
+          writer_.reset();
+        }
+        current_file_ = nullptr;
+      }
+
+      {
+        const size_t bytes = entry.first.size() + entry.second.size();
+        MutexLock l(&queue_mutex_);
+        pending_bytes_.fetch_sub(bytes, std::memory_order_acq_rel);
+        ReleaseMemory(bytes);
+        writing_ = false;
+        queue_cond_.SignalAll();
+      }
+    }
+  }
+
+  Status Write(const std::string& key, const std::string& contents) {
+    auto& shard = IndexShardFor(key);
+    {
+      MutexLock l(&shard.mutex);
+      if (shard.index.count(key)) {
+        return Status::OK();
+      }
+    }
+
+    std::string record;
+    record.reserve(contents.size() + kChecksumSize);
+    record.append(contents);
+    PutFixed32(&record, crc32c::Mask(crc32c::Value(contents.data(), contents.size())));
+
+    if (!current_file_ || current_file_->size + record.size() > file_size_) {
+      RETURN_NOT_OK(StartNewFile());
+    }
+
+    const uint64_t offset = current_file_->size;
+    RETURN_NOT_OK(writer_->Append(record));
+    // Make written data visible to readers.
+    RETURN_NOT_OK(writer_->Flush());
+
+    // Only the writer thread modifies index, so the key could not be added concurrently.
+    current_file_->keys.push_back(key);
+    {
+      MutexLock l(&shard.mutex);
+      shard.index.emplace(
+          current_file_->keys.back(), BlockLocation{current_file_, offset, contents.size()});
+    }
+    ConsumeMemory(IndexEntryMemoryUsage(key));
+
+    std::vector<std::shared_ptr<CacheFile>> evicted_files;
+    {
+      MutexLock l(&mutex_);
+      current_file_->size += record.size();
+      usage_ += record.size();
+      EvictFiles(&evicted_files);
+    }
+    dropped_for_encryption_.store(false, std::memory_order_release);
+
+    if (metrics_) {
+      metrics_->inserts->Increment();
+    }
+    RemoveFiles(evicted_files);
+    return Status::OK();
+  }
+
+  // Removes all cache files, so decrypted blocks are not kept on disk while encryption is enabled.
+  // Could be called only by the writer thread.
+  void DropAllFiles() {
+    if (writer_) {
+      WARN_NOT_OK(writer_->Close(), "Failed to close secondary block cache file");
+      writer_.reset();
+    }
+    current_file_ = nullptr;
+
+    std::vector<std::shared_ptr<CacheFile>> dropped_files;
+    {
+      MutexLock l(&mutex_);
+      dropped_files.assign(files_.begin(), files_.end());
+      files_.clear();
+      usage_ = 0;
+    }
+    if (!dropped_files.empty()) {
+      LOG(INFO) << "Encryption is enabled, dropping " << dropped_files.size()
+                << " secondary block cache files";
+    }
+    RemoveFiles(dropped_files);
+    dropped_for_encryption_.store(true, std::memory_order_release);
+  }
+
+  // Removes blocks of the specified files, that are not in files_ anymore, from the index and
+  // deletes the files.
+  void RemoveFiles(const std::vector<std::shared_ptr<CacheFile>>& files) {
+    for (const auto& file : files) {
+      RemoveFromIndex(*file);
+    }
+
+    if (metrics_) {
+      metrics_->usage->set_value(GetUsage());
+    }
+
+    for (const auto& file : files) {
+      WARN_NOT_OK(options_.env->DeleteFile(file->path),
+                  "Failed to delete secondary block cache file");
+    }
+  }
+
+  Status StartNewFile() {
+    if (writer_) {
+      RETURN_NOT_OK(writer_->Close());
+      writer_.reset();
+    }
+    current_file_ = nullptr;
+
+    auto file = std::make_shared<CacheFile>();
+    file->path = JoinPath(kCacheFilePrefix + std::to_string(next_file_number_++));
+    EnvOptions env_options;
+    RETURN_NOT_OK(options_.env->NewWritableFile(file->path, &writer_, env_options));
+    RETURN_NOT_OK(options_.env->NewRandomAccessFile(file->path, &file->reader, env_options));
+    {
+      MutexLock l(&mutex_);
+      files_.push_back(file);
+    }
+    current_file_ = std::move(file);
+    return Status::OK();
+  }
+
+  // Evicts the oldest files until the cache fits its capacity. The file that is currently being
+  // written is never evicted. Should be called while holding mutex_.
+  // Blocks of evicted files should be removed from the index with RemoveFromIndex.
+  void EvictFiles(std::vector<std::shared_ptr<CacheFile>>* evicted_files) {
+    while (usage_ > options_.capacity && files_.size() > 1) {
+      auto file = std::move(files_.front());
+      files_.pop_front();
+      usage_ -= file->size;
+      if (metrics_) {
+        metrics_->evicted_bytes->IncrementBy(file->size);
+      }
+      evicted_files->push_back(std::move(file));
+    }
+  }
+
+  void RemoveFromIndex(const CacheFile& file) {
+    size_t released_memory = 0;
+    for (const auto& key : file.keys) {
+      auto& shard = IndexShardFor(key);
+      MutexLock l(&shard.mutex);
+      auto it = shard.index.find(key);
+      if (it != shard.index.end() && it->second.file.get() == &file) {
+        shard.index.erase(it);
+      }
+      released_memory += IndexEntryMemoryUsage(key);
+    }
+    ReleaseMemory(released_memory);
+  }
+
+  const FileSecondaryBlockCacheOptions options_;
+  const size_t file_size_;
+  std::unique_ptr<SecondaryBlockCacheMetrics> metrics_;
+
+  // Index is sharded, so lookups from different threads do not serialize on a single mutex.
+  // Only the writer thread adds and removes index entries.
+  std::array<IndexShard, kNumIndexShards> index_shards_;
+
+  // Protects files_ and usage_.
+  mutable port::Mutex mutex_;
+  std::deque<std::shared_ptr<CacheFile>> files_;
+  size_t usage_ = 0;
+
+  // Tracks DRAM used by the index and by blocks waiting to be written.
+  std::shared_ptr<yb::MemTracker> mem_tracker_;
+  std::atomic<size_t> tracked_memory_{0};
+
+  // Protects queue_, writing_, drop_requested_ and closing_. pending_bytes_ is modified while
+  // holding it, but could be read without it.
+  port::Mutex queue_mutex_;
+  // Signalled when a block is queued, when a queued block is processed, when files should be
+  // dropped and on shutdown.
+  port::CondVar queue_cond_;
+  std::deque<std::pair<std::string, std::string>> queue_;
+  std::atomic<size_t> pending_bytes_{0};
+  bool writing_ = false;
+  // Set when blocks were not admitted because encryption is enabled, so the writer thread should
+  // drop stored files.
+  bool drop_requested_ = false;
+  bool closing_ = false;
+
+  // True when all files were dropped because encryption is enabled, and no blocks were stored
+  // since then.
+  std::atomic<bool> dropped_for_encryption_{false};
+
+  scoped_refptr<yb::Thread> writer_thread_;
+
+  // Accessed only by the writer thread.
+  std::unique_ptr<WritableFile> writer_;
+  std::shared_ptr<CacheFile> current_file_;
+  uint64_t next_file_number_ = 0;
+};
+
+} // namespace
+
+Status NewFileSecondaryBlockCache(
+    const FileSecondaryBlockCacheOptions& options, std::shared_ptr<SecondaryBlockCache>* result) {
+  if (options.env == nullptr || options.path.empty() || options.capacity == 0) {
+    return STATUS(InvalidArgument, "Secondary block cache requires env, path and capacity");
+  }
+  auto cache = std::make_shared<FileSecondaryBlockCache>(options);
+  RETURN_NOT_OK(cache->Init());
+  *result = std::move(cache);
+  return Status::OK();
+}
+
+}  // namespace rocksdb
@@ -0,0 +1,256 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "yb/rocksdb/env.h"
+#include "yb/rocksdb/secondary_block_cache.h"
+#include "yb/rocksdb/util/testharness.h"
+#include "yb/rocksdb/util/testutil.h"
+
+#include "yb/util/mem_tracker.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/test_macros.h"
+
+using namespace yb::size_literals;
+
+namespace rocksdb {
+
+class SecondaryBlockCacheTest : public RocksDBTest {
+ protected:
+  void SetUp() override {
+    RocksDBTest::SetUp();
+    options_.env = Env::Default();
+    options_.path = test::TmpDir(options_.env) + "/secondary_block_cache";
+  }
+
+  std::shared_ptr<SecondaryBlockCache> CreateCache() {
+    std::shared_ptr<SecondaryBlockCache> result;
+    EXPECT_OK(NewFileSecondaryBlockCache(options_, &result));
+    return result;
+  }
+
+  static std::string Key(int i) {
+    return "key" + std::to_string(i);
+  }
+
+  static std::string Contents(int i, size_t size) {
+    return std::string(size, 'a' + i % 26);
+  }
+
+  static void CheckLookup(SecondaryBlockCache* cache, int i, size_t size) {
+    std::unique_ptr<char[]> data;
+    size_t found_size = 0;
+    ASSERT_TRUE(cache->Lookup(Key(i), &data, &found_size)) << i;
+    ASSERT_EQ(Contents(i, size), std::string(data.get(), found_size));
+  }
+
+  static bool Contains(SecondaryBlockCache* cache, int i) {
+    std::unique_ptr<char[]> data;
+    size_t size = 0;
+    return cache->Lookup(Key(i), &data, &size);
+  }
+
+  FileSecondaryBlockCacheOptions options_;
+};
+
+TEST_F(SecondaryBlockCacheTest, InsertAndLookup) {
+  options_.capacity = 1_MB;
+  auto cache = CreateCache();
+  ASSERT_NE(cache, nullptr);
+
+  constexpr int kNumBlocks = 100;
+  constexpr size_t kBlockSize = 1_KB;
+  for (int i = 0; i != kNumBlocks; ++i) {
+    cache->Insert(Key(i), Contents(i, kBlockSize));
+  }
+  cache->TEST_WaitForPendingInserts();
+
+  for (int i = 0; i != kNumBlocks; ++i) {
+    ASSERT_NO_FATALS(CheckLookup(cache.get(), i, kBlockSize));
+  }
+  ASSERT_FALSE(Contains(cache.get(), kNumBlocks));
+  ASSERT_GE(cache->GetUsage(), kNumBlocks * kBlockSize);
+
+  // Duplicate insert does not change anything.
+  auto usage = cache->GetUsage();
+  cache->Insert(Key(0), Contents(1, kBlockSize));
+  cache->TEST_WaitForPendingInserts();
+  ASSERT_EQ(usage, cache->GetUsage());
+  ASSERT_NO_FATALS(CheckLookup(cache.get(), 0, kBlockSize));
+
+  // Cache content does not survive restart.
+  cache.reset();
+  cache = CreateCache();
+  ASSERT_FALSE(Contains(cache.get(), 0));
+  ASSERT_EQ(0U, cache->GetUsage());
+}
+
+TEST_F(SecondaryBlockCacheTest, Eviction) {
+  options_.capacity = 64_KB;
+  options_.file_size = 16_KB;
+  auto cache = CreateCache();
+
+  constexpr int kNumBlocks = 200;
+  constexpr size_t kBlockSize = 1_KB;
+  for (int i = 0; i != kNumBlocks; ++i) {
+    cache->Insert(Key(i), Contents(i, kBlockSize));
+    // Avoid dropping blocks because of admission queue limit.
+    cache->TEST_WaitForPendingInserts();
+  }
+
+  ASSERT_LE(cache->GetUsage(), options_.capacity);
+  ASSERT_FALSE(Contains(cache.get(), 0));
+  ASSERT_NO_FATALS(CheckLookup(cache.get(), kNumBlocks - 1, kBlockSize));
+  int num_present = 0;
+  for (int i = 0; i != kNumBlocks; ++i) {
+    num_present += Contains(cache.get(), i);
+  }
+  ASSERT_GT(num_present, options_.capacity / kBlockSize / 2);
+  ASSERT_LE(num_present, options_.capacity / kBlockSize);
+}
+
+TEST_F(SecondaryBlockCacheTest, DropWhenQueueIsFull) {
+  options_.capacity = 1_MB;
+  options_.max_pending_bytes = 0;
+  auto cache = CreateCache();
+
+  cache->Insert(Key(0), Contents(0, 1_KB));
+  cache->TEST_WaitForPendingInserts();
+  ASSERT_FALSE(Contains(cache.get(), 0));
+  ASSERT_EQ(0U, cache->GetUsage());
+}
+
+TEST_F(SecondaryBlockCacheTest, EncryptionEnabled) {
+  options_.capacity = 1_MB;
+  std::atomic<bool> encryption_enabled{false};
+  options_.encryption_enabled = [&encryption_enabled] {
+    return encryption_enabled.load(std::memory_order_acquire);
+  };
+  auto cache = CreateCache();
+  auto num_cache_files = [this] {
+    std::vector<std::string> children;
+    EXPECT_OK(options_.env->GetChildren(options_.path, &children));
+    return std::count_if(children.begin(), children.end(), [](const std::string& child) {
+      return child.find("secondary_block_cache-") == 0;
+    });
+  };
+
+  constexpr size_t kBlockSize = 1_KB;
+  cache->Insert(Key(0), Contents(0, kBlockSize));
+  cache->TEST_WaitForPendingInserts();
+  ASSERT_NO_FATALS(CheckLookup(cache.get(), 0, kBlockSize));
+  ASSERT_EQ(1, num_cache_files());
+
+  // Decrypted blocks are not stored on disk while encryption is enabled.
+  encryption_enabled = true;
+  ASSERT_FALSE(Contains(cache.get(), 0));
+  cache->Insert(Key(1), Contents(1, kBlockSize));
+  cache->TEST_WaitForPendingInserts();
+  ASSERT_EQ(0U, cache->GetUsage());
+  ASSERT_EQ(0, num_cache_files());
+
+  encryption_enabled = false;
+  ASSERT_FALSE(Contains(cache.get(), 0));
+  ASSERT_FALSE(Contains(cache.get(), 1));
+  cache->Insert(Key(2), Contents(2, kBlockSize));
+  cache->TEST_WaitForPendingInserts();
+  ASSERT_NO_FATALS(CheckLookup(cache.get(), 2, kBlockSize));
+}
+
+TEST_F(SecondaryBlockCacheTest, MemTracker) {
+  options_.capacity = 64_KB;
+  options_.file_size = 16_KB;
+  options_.parent_mem_tracker = yb::MemTracker::CreateTracker("SecondaryBlockCacheTest");
+  const auto& mem_tracker = options_.parent_mem_tracker;
+  auto cache = CreateCache();
+  ASSERT_EQ(0, mem_tracker->consumption());
+
+  constexpr size_t kBlockSize = 1_KB;
+  cache->Insert(Key(0), Contents(0, kBlockSize));
+  cache->TEST_WaitForPendingInserts();
+  const auto single_block_consumption = mem_tracker->consumption();
+  // Contents are stored on disk, only index entry is charged.
+  ASSERT_GT(single_block_consumption, 0);
+  ASSERT_LT(single_block_consumption, kBlockSize);
+
+  constexpr int kNumBlocks = 200;
+  int64_t max_consumption = 0;
+  for (int i = 1; i != kNumBlocks; ++i) {
+    cache->Insert(Key(i), Contents(i, kBlockSize));
+    cache->TEST_WaitForPendingInserts();
+    max_consumption = std::max(max_consumption, mem_tracker->consumption());
+  }
+  // Index entries of evicted blocks are released.
+  ASSERT_LE(max_consumption,
+            single_block_consumption * static_cast<int64_t>(options_.capacity / kBlockSize + 1));
+  ASSERT_LT(mem_tracker->consumption(), single_block_consumption * kNumBlocks / 2);
+
+  cache.reset();
+  ASSERT_EQ(0, mem_tracker->consumption());
+}
+
+TEST_F(SecondaryBlockCacheTest, ConcurrentLookup) {
+  options_.capacity = 1_MB;
+  auto cache = CreateCache();
+
+  constexpr int kNumBlocks = 500;
+  constexpr size_t kBlockSize = 512;
+  std::atomic<bool> stop{false};
+  std::atomic<int> num_inserted{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t != 4; ++t) {
+    readers.emplace_back([&cache, &stop, &num_inserted, t] {
+      while (!stop.load(std::memory_order_acquire)) {
+        int limit = num_inserted.load(std::memory_order_acquire);
+        for (int i = t; i < limit; i += 4) {
+          std::unique_ptr<char[]> data;
+          size_t size = 0;
+          if (cache->Lookup(Key(i), &data, &size)) {
+            ASSERT_EQ(Contents(i, kBlockSize), std::string(data.get(), size));
+          }
+        }
+      }
+    });
+  }
+
+  for (int i = 0; i != kNumBlocks; ++i) {
+    cache->Insert(Key(i), Contents(i, kBlockSize));
+    if (i % 50 == 0) {
+      cache->TEST_WaitForPendingInserts();
+    }
+    num_inserted.store(i + 1, std::memory_order_release);
+  }
+  cache->TEST_WaitForPendingInserts();
+  stop.store(true, std::memory_order_release);
+  for (auto& thread : readers) {
+    thread.join();
+  }
+
+  int num_present = 0;
+  for (int i = 0; i != kNumBlocks; ++i) {
+    num_present += Contains(cache.get(), i);
+  }
+  ASSERT_GT(num_present, 0);
+}
+
+}  // namespace rocksdb
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
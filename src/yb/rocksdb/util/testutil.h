@@ -287,16 +287,27 @@ class StringSource: public RandomAccessFile {
 
   size_t memory_footprint() const override { LOG(FATAL) << "Not supported"; }
 
+  void Prefetch(uint64_t offset, size_t n) override {
+    ++total_prefetches_;
+    total_prefetched_bytes_ += n;
+  }
+
   int total_reads() const { return total_reads_; }
 
   void set_total_reads(int tr) { total_reads_ = tr; }
 
+  int total_prefetches() const { return total_prefetches_; }
+
+  size_t total_prefetched_bytes() const { return total_prefetched_bytes_; }
+
  private:
   std::string filename_ = "StringSource";
   std::string contents_;
   uint64_t uniq_id_;
   bool mmap_;
   mutable int total_reads_;
+  int total_prefetches_ = 0;
+  size_t total_prefetched_bytes_ = 0;
 };
 
 class NullLogger : public Logger {
@@ -46,6 +46,20 @@
 namespace rocksdb {
 namespace checkpoint {
 
+namespace {
+
+// Returns directory containing specified table file, it could be any of db_paths.
+std::string TableFileDir(DB* db, const std::string& fname) {
+  for (const auto& db_path : db->GetDBOptions().db_paths) {
+    if (db->GetCheckpointEnv()->FileExists(db_path.path + fname).ok()) {
+      return db_path.path;
+    }
+  }
+  return db->GetName();
+}
+
+}  // namespace
+
 // Builds an openable snapshot of RocksDB on the same disk, which
 // accepts an output directory on the same disk, and under the directory
 // (1) hard-linked SST files pointing to existing live SST files
@@ -117,9 +131,10 @@ Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir) {
     // * if it's kDescriptorFile, limit the size to manifest_file_size
     // * always copy if cross-device link
     bool is_table_file = type == kTableFile || type == kTableSBlockFile;
+    const std::string src_dir = is_table_file ? TableFileDir(db, src_fname) : db->GetName();
     if (is_table_file && same_fs) {
       RLOG(db->GetOptions().info_log, "Hard Linking %s", src_fname.c_str());
-      s = db->GetCheckpointEnv()->LinkFile(db->GetName() + src_fname,
+      s = db->GetCheckpointEnv()->LinkFile(src_dir + src_fname,
                                  full_private_path + src_fname);
       if (s.IsNotSupported()) {
         same_fs = false;
@@ -129,7 +144,7 @@ Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir) {
     if (!is_table_file || !same_fs) {
       RLOG(db->GetOptions().info_log, "Copying %s", src_fname.c_str());
       std::string dest_name = full_private_path + src_fname;
-      s = CopyFile(db->GetCheckpointEnv(), db->GetName() + src_fname, dest_name,
+      s = CopyFile(db->GetCheckpointEnv(), src_dir + src_fname, dest_name,
                    type == kDescriptorFile ? manifest_file_size : 0);
     }
   }
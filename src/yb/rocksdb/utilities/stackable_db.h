@@ -88,6 +88,11 @@ class StackableDB : public DB {
                          bool move_file) override {
     return db_->AddFile(column_family, file_info, move_file);
   }
+  virtual Status AddFile(ColumnFamilyHandle* column_family,
+                         const ExternalSstFileInfo* file_info,
+                         bool move_file, bool allow_overlap) override {
+    return db_->AddFile(column_family, file_info, move_file, allow_overlap);
+  }
   virtual Status AddFile(ColumnFamilyHandle* column_family,
                          const std::string& file_path,
                          bool move_file) override {
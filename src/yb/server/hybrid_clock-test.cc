@@ -35,6 +35,8 @@
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
+#include "yb/gutil/walltime.h"
+
 #include "yb/server/hybrid_clock.h"
 
 #include "yb/util/atomic.h"
@@ -44,6 +46,7 @@
 #include "yb/util/test_util.h"
 #include "yb/util/thread.h"
 
+DECLARE_uint64(adjtime_clock_refresh_interval_ms);
 DECLARE_uint64(max_clock_sync_error_usec);
 DECLARE_bool(disable_clock_sync_error);
 
@@ -219,5 +222,25 @@ TEST_F(HybridClockTest, CompareHybridClocksToDelta) {
       MonoDelta::FromMicroseconds(1)));
 }
 
+#if !defined(__APPLE__)
+// Test that between kernel queries AdjTimeClock reads the realtime clock and extrapolates max
+// error, so it does not decrease.
+TEST(AdjTimeClockTest, ExtrapolatedMaxError) {
+  constexpr int kNumReads = 1000;
+  FLAGS_adjtime_clock_refresh_interval_ms = 60 * 60 * 1000;
+  const auto& clock = AdjTimeClock();
+  auto prev = ASSERT_RESULT(clock->Now());
+  for (int i = 0; i != kNumReads; ++i) {
+    auto before = static_cast<MicrosTime>(GetCurrentTimeMicros());
+    auto now = ASSERT_RESULT(clock->Now());
+    auto after = static_cast<MicrosTime>(GetCurrentTimeMicros());
+    ASSERT_GE(now.time_point, before);
+    ASSERT_LE(now.time_point, after);
+    ASSERT_GE(now.max_error, prev.max_error);
+    prev = now;
+  }
+}
+#endif
+
 }  // namespace server
 }  // namespace yb
@@ -29,6 +29,16 @@ DEFINE_int64(apply_intents_task_injected_delay_ms, 0,
              "Inject such delay before applying intents for large transactions. "
              "Could be used to throttle the apply speed.");
 
+DEFINE_int32(apply_intents_task_max_steps_per_run, 1,
+             "Max number of intents apply steps, txn_max_apply_batch_records each, performed by "
+             "a large transaction apply task before it is rescheduled, so other tasks waiting in "
+             "the tablet strand, i.e. apply of small transactions, are not blocked until the "
+             "large transaction is fully applied. 0 - means no limit.");
+
+DEFINE_test_flag(bool, record_apply_intents_events, false,
+                 "Record large transaction apply tasks, when they are enqueued and after each "
+                 "apply step, so tests could check the order of their execution.");
+
 DEFINE_test_flag(int32, pause_and_skip_apply_intents_task_loop_ms, 0,
                  "If set to a value greater than zero, each loop of the apply intents task will "
                  "sleep for the specified duration and continue without doing apply work.");
@@ -37,10 +47,11 @@ namespace yb {
 namespace tablet {
 
 ApplyIntentsTask::ApplyIntentsTask(TransactionIntentApplier* applier,
+                                   TransactionParticipantContext* participant_context,
                                    RunningTransactionContext* running_transaction_context,
                                    const TransactionApplyData* apply_data)
-    : applier_(*applier), running_transaction_context_(*running_transaction_context),
-      apply_data_(*apply_data) {}
+    : applier_(*applier), participant_context_(*participant_context),
+      running_transaction_context_(*running_transaction_context), apply_data_(*apply_data) {}
 
 bool ApplyIntentsTask::Prepare(RunningTransactionPtr transaction, ScopedRWOperation* operation) {
   bool expected = false;
@@ -50,18 +61,33 @@ bool ApplyIntentsTask::Prepare(RunningTransactionPtr transaction, ScopedRWOperat
 
   transaction_ = std::move(transaction);
   operation_ = std::move(*DCHECK_NOTNULL(operation));
+  if (PREDICT_FALSE(FLAGS_TEST_record_apply_intents_events)) {
+    running_transaction_context_.TEST_RecordApplyIntentsEvent(apply_data_.transaction_id, 0);
+  }
   return true;
 }
 
 void ApplyIntentsTask::Run() {
   VLOG_WITH_PREFIX(4) << __func__;
 
+  if (start_time_ == CoarseTimePoint()) {
+    start_time_ = CoarseMonoClock::Now();
+    running_transaction_context_.apply_intents_metrics().transactions_applying->Increment();
+  }
+
+  yielded_ = ApplySteps();
+}
+
+bool ApplyIntentsTask::ApplySteps() {
+  const auto& metrics = running_transaction_context_.apply_intents_metrics();
+  const auto max_steps = FLAGS_apply_intents_task_max_steps_per_run;
+  int32_t steps_in_run = 0;
   for (;;) {
     AtomicFlagSleepMs(&FLAGS_apply_intents_task_injected_delay_ms);
 
     if (running_transaction_context_.Closing()) {
       VLOG_WITH_PREFIX(1) << "Abort because of shutdown";
-      break;
+      return false;
     }
 
     const auto pause_and_skip_ms = ANNOTATE_UNPROTECTED_READ(
@@ -75,20 +101,47 @@ void ApplyIntentsTask::Run() {
     if (!result.ok()) {
       LOG_WITH_PREFIX(DFATAL)
           << "Failed to apply intents " << apply_data_.ToString() << ": " << result.status();
-      break;
+      return false;
+    }
+
+    ++steps_;
+    metrics.steps->Increment();
+    if (PREDICT_FALSE(FLAGS_TEST_record_apply_intents_events)) {
+      running_transaction_context_.TEST_RecordApplyIntentsEvent(apply_data_.transaction_id, steps_);
     }
 
     transaction_->SetApplyData(*result);
     VLOG_WITH_PREFIX(2) << "Performed next apply step: " << result->ToString();
 
     if (!result->active()) {
-      break;
+      return false;
+    }
+
+    if (max_steps > 0 && ++steps_in_run >= max_steps) {
+      return true;
     }
   }
 }
 
 void ApplyIntentsTask::Done(const Status& status) {
+  if (status.ok() && yielded_) {
+    yielded_ = false;
+    ++yields_;
+    running_transaction_context_.apply_intents_metrics().yields->Increment();
+    VLOG_WITH_PREFIX(3) << "Reschedule apply after " << steps_ << " steps";
+    // Let tasks that were queued to the strand meanwhile run before continuing with this one.
+    // Task could be already done after this call, so we should not access its fields.
+    participant_context_.StrandEnqueue(this);
+    return;
+  }
+
   WARN_NOT_OK(status, "Apply intents task failed");
+  if (start_time_ != CoarseTimePoint()) {
+    running_transaction_context_.apply_intents_metrics().transactions_applying->Decrement();
+    LOG_IF_WITH_PREFIX(INFO, steps_ > 1)
+        << "Applied intents in " << steps_ << " steps, yields: " << yields_ << ", took: "
+        << MonoDelta(CoarseMonoClock::Now() - start_time_);
+  }
   operation_.Reset();
   transaction_.reset();
 }
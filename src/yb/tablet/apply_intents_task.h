@@ -18,6 +18,7 @@
 
 #include "yb/tablet/running_transaction_context.h"
 
+#include "yb/util/monotime.h"
 #include "yb/util/operation_counter.h"
 
 namespace yb {
@@ -27,6 +28,7 @@ namespace tablet {
 class ApplyIntentsTask : public rpc::StrandTask {
  public:
   ApplyIntentsTask(TransactionIntentApplier* applier,
+                   TransactionParticipantContext* participant_context,
                    RunningTransactionContext* running_transaction_context,
                    const TransactionApplyData* apply_data);
 
@@ -40,7 +42,12 @@ class ApplyIntentsTask : public rpc::StrandTask {
  private:
   std::string LogPrefix() const;
 
+  // Performs apply steps until the transaction is fully applied or the steps limit is reached.
+  // Returns true if task should be rescheduled to continue apply.
+  bool ApplySteps();
+
   TransactionIntentApplier& applier_;
+  TransactionParticipantContext& participant_context_;
   RunningTransactionContext& running_transaction_context_;
   const TransactionApplyData& apply_data_;
   ScopedRWOperation operation_;
@@ -50,6 +57,12 @@ class ApplyIntentsTask : public rpc::StrandTask {
   // The task can be submitted only once, so this flag never reverts its state to false.
   std::atomic<bool> used_{false};
   RunningTransactionPtr transaction_;
+
+  // Progress of the apply, accessed only from the strand.
+  bool yielded_ = false;
+  size_t steps_ = 0;
+  size_t yields_ = 0;
+  CoarseTimePoint start_time_;
 };
 
 } // namespace tablet
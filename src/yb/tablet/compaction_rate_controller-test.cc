@@ -0,0 +1,156 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/rocksdb/rate_limiter.h"
+
+#include "yb/tablet/compaction_rate_controller.h"
+
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+DECLARE_int32(rocksdb_compact_flush_rate_limit_target_latency_ms);
+DECLARE_int64(rocksdb_compact_flush_rate_limit_min_bytes_per_sec);
+DECLARE_int32(rocksdb_compact_flush_rate_limit_adjust_interval_ms);
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+constexpr int64_t kMaxRate = 1000;
+constexpr int64_t kMinRate = 300;
+constexpr int kTargetLatencyMs = 10;
+const auto kHighLatency = MonoDelta::FromMilliseconds(kTargetLatencyMs * 2);
+const auto kLowLatency = MonoDelta::FromMilliseconds(kTargetLatencyMs / 2);
+
+class MockRateLimiter : public rocksdb::RateLimiter {
+ public:
+  void SetBytesPerSecond(int64_t bytes_per_second) override {
+    bytes_per_second_ = bytes_per_second;
+  }
+
+  void Request(const int64_t bytes, const rocksdb::Env::IOPriority pri) override {}
+
+  int64_t GetSingleBurstBytes() const override {
+    return bytes_per_second_;
+  }
+
+  int64_t GetTotalBytesThrough(const rocksdb::Env::IOPriority pri) const override {
+    return 0;
+  }
+
+  int64_t GetTotalRequests(const rocksdb::Env::IOPriority pri) const override {
+    return 0;
+  }
+
+  int64_t bytes_per_second() const {
+    return bytes_per_second_;
+  }
+
+ private:
+  int64_t bytes_per_second_ = kMaxRate;
+};
+
+} // namespace
+
+class CompactionRateControllerTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    FLAGS_rocksdb_compact_flush_rate_limit_target_latency_ms = kTargetLatencyMs;
+    FLAGS_rocksdb_compact_flush_rate_limit_min_bytes_per_sec = kMinRate;
+    // Adjustments are triggered only by the test.
+    FLAGS_rocksdb_compact_flush_rate_limit_adjust_interval_ms = 3600 * 1000;
+    controller_ = std::make_unique<CompactionRateController>(
+        rate_limiter_, kMaxRate, [this] { return backlog_; });
+  }
+
+  // Records operations with the specified latency and adjusts the rate, returns the new rate.
+  int64_t Adjust(MonoDelta latency) {
+    for (int i = 0; i != 10; ++i) {
+      controller_->RecordForegroundLatency(latency);
+    }
+    controller_->TEST_Adjust();
+    EXPECT_EQ(controller_->bytes_per_sec(), rate_limiter_->bytes_per_second());
+    return controller_->bytes_per_sec();
+  }
+
+  google::FlagSaver flag_saver_;
+  std::shared_ptr<MockRateLimiter> rate_limiter_ = std::make_shared<MockRateLimiter>();
+  uint64_t backlog_ = 0;
+  std::unique_ptr<CompactionRateController> controller_;
+};
+
+TEST_F(CompactionRateControllerTest, AdjustByLatency) {
+  // Multiplicative decrease down to the min rate.
+  ASSERT_NEAR(700, Adjust(kHighLatency), 1);
+  ASSERT_NEAR(490, Adjust(kHighLatency), 1);
+  ASSERT_NEAR(343, Adjust(kHighLatency), 1);
+  ASSERT_EQ(kMinRate, Adjust(kHighLatency));
+  ASSERT_EQ(kMinRate, Adjust(kHighLatency));
+
+  // Additive increase up to the max rate.
+  ASSERT_EQ(kMinRate + 100, Adjust(kLowLatency));
+  ASSERT_EQ(kMinRate + 200, Adjust(kLowLatency));
+  for (int i = 0; i != 10; ++i) {
+    Adjust(kLowLatency);
+  }
+  ASSERT_EQ(kMaxRate, controller_->bytes_per_sec());
+
+  // Rate is not changed without operations.
+  const auto rate = Adjust(kHighLatency);
+  ASSERT_LT(rate, kMaxRate);
+  controller_->TEST_Adjust();
+  ASSERT_EQ(rate, controller_->bytes_per_sec());
+}
+
+TEST_F(CompactionRateControllerTest, BacklogGrows) {
+  auto rate = Adjust(kHighLatency);
+  ASSERT_LT(rate, kMaxRate);
+
+  // Rate is not decreased while backlog grows.
+  for (int i = 0; i != 3; ++i) {
+    backlog_ += 5;
+    ASSERT_EQ(rate, Adjust(kHighLatency));
+  }
+
+  // Rate is decreased again once backlog stops growing.
+  auto new_rate = Adjust(kHighLatency);
+  ASSERT_LT(new_rate, rate);
+  rate = new_rate;
+  backlog_ -= 5;
+  new_rate = Adjust(kHighLatency);
+  ASSERT_LT(new_rate, rate);
+  rate = new_rate;
+
+  // Growing backlog does not prevent increasing the rate.
+  backlog_ += 5;
+  ASSERT_EQ(rate + 100, Adjust(kLowLatency));
+}
+
+TEST_F(CompactionRateControllerTest, Disabled) {
+  ASSERT_LT(Adjust(kHighLatency), kMaxRate);
+
+  // Max rate is restored when latency aware throttling is disabled.
+  FLAGS_rocksdb_compact_flush_rate_limit_target_latency_ms = 0;
+  controller_->TEST_Adjust();
+  ASSERT_EQ(kMaxRate, controller_->bytes_per_sec());
+  ASSERT_EQ(kMaxRate, rate_limiter_->bytes_per_second());
+  ASSERT_EQ(kMaxRate, Adjust(kHighLatency));
+}
+
+} // namespace tablet
+} // namespace yb
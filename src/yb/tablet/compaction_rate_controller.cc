@@ -0,0 +1,130 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#include "yb/tablet/compaction_rate_controller.h"
+
+#include <algorithm>
+
+#include "yb/rocksdb/rate_limiter.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/size_literals.h"
+
+using namespace yb::size_literals;
+
+DEFINE_int32(rocksdb_compact_flush_rate_limit_target_latency_ms, 0,
+             "Target average latency of foreground reads and local application of writes. When it "
+             "is exceeded, the rate of the compaction/flush rate limiter shared by the tablet "
+             "server is decreased, unless compaction backlog grows. 0 to disable latency aware "
+             "throttling. Applies only when rate limiter is shared across the tablet server.");
+TAG_FLAG(rocksdb_compact_flush_rate_limit_target_latency_ms, runtime);
+TAG_FLAG(rocksdb_compact_flush_rate_limit_target_latency_ms, advanced);
+
+DEFINE_int64(rocksdb_compact_flush_rate_limit_min_bytes_per_sec, 16_MB,
+             "Latency aware throttling does not decrease compaction/flush rate below this value.");
+TAG_FLAG(rocksdb_compact_flush_rate_limit_min_bytes_per_sec, runtime);
+TAG_FLAG(rocksdb_compact_flush_rate_limit_min_bytes_per_sec, advanced);
+
+DEFINE_int32(rocksdb_compact_flush_rate_limit_adjust_interval_ms, 1000,
+             "Interval between adjustments of the compaction/flush rate by latency aware "
+             "throttling.");
+TAG_FLAG(rocksdb_compact_flush_rate_limit_adjust_interval_ms, runtime);
+TAG_FLAG(rocksdb_compact_flush_rate_limit_adjust_interval_ms, advanced);
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+// Multiplicative decrease factor, applied when target latency is exceeded.
+constexpr double kDecreaseFactor = 0.7;
+
+// Additive increase step, as a fraction of the max rate.
+constexpr int64_t kIncreaseSteps = 10;
+
+std::chrono::milliseconds AdjustInterval() {
+  return std::chrono::milliseconds(
+      std::max(FLAGS_rocksdb_compact_flush_rate_limit_adjust_interval_ms, 1));
+}
+
+} // namespace
+
+CompactionRateController::CompactionRateController(
+    std::shared_ptr<rocksdb::RateLimiter> rate_limiter, int64_t max_bytes_per_sec,
+    BacklogProvider backlog_provider)
+    : rate_limiter_(std::move(rate_limiter)), max_bytes_per_sec_(max_bytes_per_sec),
+      backlog_provider_(std::move(backlog_provider)),
+      bytes_per_sec_(max_bytes_per_sec),
+      next_adjust_time_(CoarseMonoClock::now() + AdjustInterval()) {
+}
+
+void CompactionRateController::RecordForegroundLatency(MonoDelta latency) {
+  latency_sum_us_.fetch_add(latency.ToMicroseconds(), std::memory_order_relaxed);
+  num_operations_.fetch_add(1, std::memory_order_relaxed);
+
+  auto now = CoarseMonoClock::now();
+  auto next_adjust_time = next_adjust_time_.load(std::memory_order_acquire);
+  if (now < next_adjust_time) {
+    return;
+  }
+  // Only one thread performs the adjustment for the passed interval.
+  if (!next_adjust_time_.compare_exchange_strong(
+          next_adjust_time, now + AdjustInterval(), std::memory_order_acq_rel)) {
+    return;
+  }
+  Adjust();
+}
+
+void CompactionRateController::Adjust() {
+  auto latency_sum_us = latency_sum_us_.exchange(0, std::memory_order_acq_rel);
+  auto num_operations = num_operations_.exchange(0, std::memory_order_acq_rel);
+
+  auto old_rate = bytes_per_sec();
+  int64_t new_rate;
+  auto target_latency_ms = FLAGS_rocksdb_compact_flush_rate_limit_target_latency_ms;
+  const auto last_backlog = last_backlog_;
+  const auto backlog = backlog_provider_ ? backlog_provider_() : 0;
+  last_backlog_ = backlog;
+  if (target_latency_ms <= 0) {
+    new_rate = max_bytes_per_sec_;
+  } else if (num_operations == 0) {
+    return;
+  } else {
+    auto min_rate = std::min(
+        FLAGS_rocksdb_compact_flush_rate_limit_min_bytes_per_sec, max_bytes_per_sec_);
+    auto avg_latency_us = latency_sum_us / num_operations;
+    if (avg_latency_us <= target_latency_ms * 1000) {
+      new_rate = std::min(old_rate + max_bytes_per_sec_ / kIncreaseSteps, max_bytes_per_sec_);
+    } else if (backlog > last_backlog) {
+      // Compactions already fall behind, so slowing them down further would not help.
+      new_rate = old_rate;
+    } else {
+      new_rate = std::max<int64_t>(old_rate * kDecreaseFactor, min_rate);
+    }
+    new_rate = std::max<int64_t>(new_rate, 1);
+    VLOG(2) << "Average foreground latency: " << avg_latency_us << "us over " << num_operations
+            << " operations, compaction backlog: " << last_backlog << " => " << backlog
+            << ", compaction/flush rate: " << old_rate << " => " << new_rate;
+  }
+
+  if (new_rate == old_rate) {
+    return;
+  }
+  bytes_per_sec_.store(new_rate, std::memory_order_release);
+  rate_limiter_->SetBytesPerSecond(new_rate);
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,101 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#ifndef YB_TABLET_COMPACTION_RATE_CONTROLLER_H
+#define YB_TABLET_COMPACTION_RATE_CONTROLLER_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "yb/util/monotime.h"
+
+namespace rocksdb {
+class RateLimiter;
+}
+
+namespace yb {
+namespace tablet {
+
+// Adjusts rate of the compaction/flush rate limiter shared by all tablets of the tablet server,
+// based on the latency of foreground reads and local application of writes.
+// Uses AIMD: when average foreground latency over the adjustment interval exceeds the target,
+// the rate is multiplicatively decreased (but not below the configured minimum), otherwise it is
+// additively increased up to the configured maximum.
+// The rate is not decreased while compaction backlog grows, since slower compactions would only
+// make reads more expensive later.
+class CompactionRateController {
+ public:
+  // Returns current compaction backlog, for instance the number of SST files. Only the trend
+  // matters, so any measure that grows when compactions fall behind could be used.
+  typedef std::function<uint64_t()> BacklogProvider;
+
+  // backlog_provider could be empty, then backlog is not taken into account.
+  CompactionRateController(
+      std::shared_ptr<rocksdb::RateLimiter> rate_limiter, int64_t max_bytes_per_sec,
+      BacklogProvider backlog_provider = BacklogProvider());
+
+  CompactionRateController(const CompactionRateController&) = delete;
+  void operator=(const CompactionRateController&) = delete;
+
+  // Records latency of the foreground operation, adjusting the rate when adjustment interval
+  // has passed. Thread safe.
+  void RecordForegroundLatency(MonoDelta latency);
+
+  int64_t bytes_per_sec() const {
+    return bytes_per_sec_.load(std::memory_order_acquire);
+  }
+
+  void TEST_Adjust() {
+    Adjust();
+  }
+
+ private:
+  void Adjust();
+
+  const std::shared_ptr<rocksdb::RateLimiter> rate_limiter_;
+  const int64_t max_bytes_per_sec_;
+  const BacklogProvider backlog_provider_;
+
+  // Backlog at the previous adjustment, accessed only by the thread performing the adjustment.
+  uint64_t last_backlog_ = 0;
+
+  std::atomic<int64_t> bytes_per_sec_;
+  std::atomic<int64_t> latency_sum_us_{0};
+  std::atomic<int64_t> num_operations_{0};
+  std::atomic<CoarseTimePoint> next_adjust_time_;
+};
+
+// Records the latency of the foreground operation, from construction to destruction,
+// to the specified controller. Controller could be null.
+class ScopedForegroundLatencyRecorder {
+ public:
+  explicit ScopedForegroundLatencyRecorder(CompactionRateController* controller)
+      : controller_(controller), start_(controller ? CoarseMonoClock::now() : CoarseTimePoint()) {}
+
+  ~ScopedForegroundLatencyRecorder() {
+    if (controller_) {
+      controller_->RecordForegroundLatency(CoarseMonoClock::now() - start_);
+    }
+  }
+
+ private:
+  CompactionRateController* const controller_;
+  const CoarseTimePoint start_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_COMPACTION_RATE_CONTROLLER_H
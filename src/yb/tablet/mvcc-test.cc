@@ -133,6 +133,73 @@ TEST_F(MvccTest, SafeHybridTimeToReadAt) {
   ASSERT_STR_CONTAINS(mvcc_trace, "9. SafeTime");
 }
 
+TEST_F(MvccTest, PublishedSafeTime) {
+  HybridTime ht1 = manager_.AddLeaderPending(OpId(1, 1));
+  HybridTime ht2 = manager_.AddLeaderPending(OpId(1, 2));
+  ASSERT_EQ(ht1.Decremented(), manager_.SafeTime(FixedHybridTimeLease()));
+
+  // Lease that is before published safe time should be respected.
+  auto lease_time = ht1.Decremented().Decremented();
+  ASSERT_EQ(lease_time, manager_.SafeTime({
+    .time = lease_time,
+    .lease = lease_time,
+  }));
+
+  // Published safe time does not satisfy min allowed, so we should wait for replication.
+  ASSERT_FALSE(manager_.SafeTime(ht2, CoarseMonoClock::now() + 100ms, FixedHybridTimeLease()));
+
+  manager_.Replicated(ht1, OpId(1, 1));
+  ASSERT_EQ(ht2.Decremented(), manager_.SafeTime(FixedHybridTimeLease()));
+  manager_.Aborted(ht2, OpId(1, 2));
+
+  // Empty queue, safe time should be taken from the clock.
+  auto time_before = clock_->Now();
+  auto safe_time = manager_.SafeTime(FixedHybridTimeLease());
+  ASSERT_GT(safe_time, time_before);
+  ASSERT_LT(safe_time, clock_->Now());
+
+  // New operation should receive time after safe time returned from the slow path.
+  HybridTime ht3 = manager_.AddLeaderPending(OpId(1, 3));
+  ASSERT_GT(ht3, safe_time);
+  ASSERT_EQ(ht3.Decremented(), manager_.SafeTime(FixedHybridTimeLease()));
+  manager_.Replicated(ht3, OpId(1, 3));
+}
+
+// Safe time returned by the fast path should be taken into account by the locked path, that is
+// used for the lease that is before the published safe time.
+TEST_F(MvccTest, PublishedSafeTimeWithDecreasingLease) {
+  constexpr int kNumOps = 10;
+  constexpr uint64_t kLeaseDelta = 100;
+
+  std::vector<HybridTime> hts;
+  for (int i = 1; i <= kNumOps; ++i) {
+    hts.push_back(manager_.AddLeaderPending(OpId(1, i)));
+  }
+
+  auto far_time = AddLogical(hts.back(), kLeaseDelta);
+  auto lease_time = hts.front();
+  HybridTime prev_safe_time = HybridTime::kMin;
+  for (int i = 0; i != kNumOps; ++i) {
+    // Served by the fast path, lease is after the first pending operation.
+    auto safe_time = manager_.SafeTime({ .time = far_time, .lease = far_time });
+    ASSERT_EQ(hts[i].Decremented(), safe_time);
+    ASSERT_GE(safe_time, prev_safe_time);
+    prev_safe_time = safe_time;
+
+    // Served by the locked path, lease is before the published safe time and decreases on every
+    // iteration.
+    lease_time = lease_time.Decremented();
+    safe_time = manager_.SafeTime({ .time = lease_time, .lease = lease_time });
+    ASSERT_GE(safe_time, prev_safe_time);
+    prev_safe_time = safe_time;
+
+    manager_.Replicated(hts[i], OpId(1, i + 1));
+  }
+
+  auto safe_time = manager_.SafeTime({ .time = lease_time, .lease = lease_time });
+  ASSERT_GE(safe_time, prev_safe_time);
+}
+
 TEST_F(MvccTest, Abort) {
   constexpr size_t kTotalEntries = 10;
   vector<HybridTime> hts(kTotalEntries);
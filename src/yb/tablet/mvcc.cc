@@ -42,6 +42,7 @@
 #include "yb/util/enums.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/format.h"
+#include "yb/util/locks.h"
 #include "yb/util/logging.h"
 
 using namespace std::literals;
@@ -200,10 +201,12 @@ class MvccManager::MvccOpTrace {
   ~MvccOpTrace() = default;
 
   void Add(TraceItemVariant v) {
+    std::lock_guard<simple_spinlock> lock(mutex_);
     items_.push_back(std::move(v));
   }
 
   void DumpTrace(ostream* out) const {
+    std::lock_guard<simple_spinlock> lock(mutex_);
     if (items_.empty()) {
       *out << "No MVCC operations" << std::endl;
       return;
@@ -217,7 +220,9 @@ class MvccManager::MvccOpTrace {
   }
 
  private:
-  boost::circular_buffer_space_optimized<TraceItemVariant, std::allocator<TraceItemVariant>> items_;
+  mutable simple_spinlock mutex_;
+  boost::circular_buffer_space_optimized<TraceItemVariant, std::allocator<TraceItemVariant>> items_
+      GUARDED_BY(mutex_);
 };
 
 struct MvccManager::InvariantViolationLoggingHelper {
@@ -271,6 +276,7 @@ void MvccManager::Replicated(HybridTime ht, const OpId& op_id) {
              (QueueItem{ .hybrid_time = ht, .op_id = op_id })) << InvariantViolationLogPrefix();
     queue_.pop_front();
     last_replicated_ = ht;
+    PublishSafeTime();
   }
   cond_.notify_all();
 }
@@ -288,6 +294,7 @@ void MvccManager::Aborted(HybridTime ht, const OpId& op_id) {
              (QueueItem{ .hybrid_time = ht, .op_id = op_id }))
         << InvariantViolationLogPrefix() << "It is allowed to abort only last operation";
     queue_.pop_back();
+    PublishSafeTime();
   }
   cond_.notify_all();
 }
@@ -403,6 +410,44 @@ void MvccManager::AddPending(HybridTime ht, const OpId& op_id, bool is_follower_
     .hybrid_time = ht,
     .op_id = op_id,
   });
+  PublishSafeTime();
+}
+
+void MvccManager::PublishSafeTime() {
+  auto safe_time = HybridTime::kInvalid;
+  if (!queue_.empty()) {
+    safe_time = queue_.front().hybrid_time.Decremented();
+    // Published value is used without updating max_safe_time_returned_*, so it should not be less
+    // than any of them. Otherwise result would go backwards, so fallback to the slow path.
+    if (safe_time < last_replicated_ ||
+        safe_time < max_safe_time_returned_with_lease_.safe_time ||
+        safe_time < max_safe_time_returned_without_lease_.safe_time) {
+      safe_time = HybridTime::kInvalid;
+    }
+  }
+  published_safe_time_.store(safe_time.ToUint64(), std::memory_order_release);
+}
+
+HybridTime MvccManager::PublishedSafeTime(
+    HybridTime min_allowed, const FixedHybridTimeLease& ht_lease) const {
+  HybridTime result(published_safe_time_.load(std::memory_order_acquire));
+  if (!result.is_valid() || result < min_allowed) {
+    return HybridTime::kInvalid;
+  }
+  // Safe time should not exceed hybrid time leader lease. Since max_safe_time_returned_with_lease_
+  // could be used only under the mutex, we check against the lease itself, that is stricter.
+  if (!ht_lease.empty() && result > ht_lease.lease) {
+    return HybridTime::kInvalid;
+  }
+  return result;
+}
+
+void MvccManager::FoldPublishedSafeTimeReturned(
+    const std::atomic<uint64_t>& published_returned, SafeTimeWithSource* max_returned) const {
+  HybridTime safe_time(published_returned.load(std::memory_order_acquire));
+  if (safe_time > max_returned->safe_time) {
+    *max_returned = { safe_time, SafeTimeSource::kNextInQueue };
+  }
 }
 
 void MvccManager::SetLastReplicated(HybridTime ht) {
@@ -414,6 +459,7 @@ void MvccManager::SetLastReplicated(HybridTime ht) {
       op_trace_->Add(SetLastReplicatedTraceItem { .ht = ht });
     }
     last_replicated_ = ht;
+    PublishSafeTime();
   }
   cond_.notify_all();
 }
@@ -544,8 +590,21 @@ HybridTime MvccManager::SafeTime(
     HybridTime min_allowed,
     CoarseTimePoint deadline,
     const FixedHybridTimeLease& ht_lease) const NO_THREAD_SAFETY_ANALYSIS {
-  std::unique_lock<std::mutex> lock(mutex_);
-  auto safe_time = DoGetSafeTime(min_allowed, deadline, ht_lease, &lock);
+  // Fast path, that does not contend with writers.
+  auto safe_time = PublishedSafeTime(min_allowed, ht_lease);
+  std::unique_lock<std::mutex> lock;
+  if (safe_time.is_valid()) {
+    VLOG_WITH_PREFIX_AND_FUNC(2) << "Published: " << safe_time;
+    // Remember returned value before returning it, so the locked path would not return lower value
+    // after this call.
+    UpdateAtomicMax(
+        ht_lease.empty() ? &max_published_safe_time_returned_without_lease_
+                         : &max_published_safe_time_returned_with_lease_,
+        safe_time.ToUint64());
+  } else {
+    lock = std::unique_lock<std::mutex>(mutex_);
+    safe_time = DoGetSafeTime(min_allowed, deadline, ht_lease, &lock);
+  }
   if (op_trace_) {
     op_trace_->Add(SafeTimeTraceItem {
       .min_allowed = min_allowed,
@@ -565,6 +624,11 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
   CHECK(ht_lease.lease.is_valid()) << InvariantViolationLogPrefix();
   CHECK_LE(min_allowed, ht_lease.lease) << InvariantViolationLogPrefix();
 
+  FoldPublishedSafeTimeReturned(
+      max_published_safe_time_returned_with_lease_, &max_safe_time_returned_with_lease_);
+  FoldPublishedSafeTimeReturned(
+      max_published_safe_time_returned_without_lease_, &max_safe_time_returned_without_lease_);
+
   const bool has_lease = !ht_lease.empty();
   // Because different calls that have current hybrid time leader lease as an argument can come to
   // us out of order, we might see an older value of hybrid time leader lease expiration after a
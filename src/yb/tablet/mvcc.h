@@ -32,6 +32,7 @@
 #ifndef YB_TABLET_MVCC_H_
 #define YB_TABLET_MVCC_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <vector>
@@ -80,6 +81,10 @@ inline std::ostream& operator<<(std::ostream& out, const FixedHybridTimeLease& h
 // methods.
 // Operations could be replicated only in the same order as they were added.
 // Time of newly added operation should be after time of all previously added operations.
+//
+// While there are pending operations, safe time is determined by the first of them. This value is
+// published to an atomic after every queue change, so SafeTime could be served without taking the
+// mutex, that is shared with writers, in case it satisfies the request.
 class MvccManager {
  public:
   // `prefix` is used for logging.
@@ -167,6 +172,18 @@ class MvccManager {
 
   void AddPending(HybridTime ht, const OpId& op_id, bool is_follower_side) REQUIRES(mutex_);
 
+  // Updates published_safe_time_ after change of the queue or last replicated hybrid time.
+  void PublishSafeTime() REQUIRES(mutex_);
+
+  // Returns published safe time if it could be used as result of SafeTime with provided arguments,
+  // invalid hybrid time otherwise.
+  HybridTime PublishedSafeTime(HybridTime min_allowed, const FixedHybridTimeLease& ht_lease) const;
+
+  // Updates max_returned with safe time that was returned by SafeTime fast path.
+  void FoldPublishedSafeTimeReturned(
+      const std::atomic<uint64_t>& published_returned, SafeTimeWithSource* max_returned) const
+      REQUIRES(mutex_);
+
   std::string prefix_;
   server::ClockPtr clock_;
   mutable std::mutex mutex_;
@@ -212,7 +229,22 @@ class MvccManager {
   mutable SafeTimeWithSource max_safe_time_returned_without_lease_;
   mutable SafeTimeWithSource max_safe_time_returned_for_follower_ { HybridTime::kMin };
 
-  std::unique_ptr<MvccOpTrace> op_trace_ GUARDED_BY(mutex_);
+  // Safe time that is determined by the first operation in the queue, i.e. the value that
+  // DoGetSafeTime would return while queue is not changed.
+  // Invalid when queue is empty, since safe time depends on the clock and lease in this case.
+  std::atomic<uint64_t> published_safe_time_{HybridTime::kInvalid.ToUint64()};
+
+  // Max safe time returned from the published value, with and without lease. They are folded into
+  // max_safe_time_returned_with_lease_ and max_safe_time_returned_without_lease_ by DoGetSafeTime,
+  // so results of the locked path do not go below results of the fast path.
+  mutable std::atomic<uint64_t> max_published_safe_time_returned_with_lease_{
+      HybridTime::kMin.ToUint64()};
+  mutable std::atomic<uint64_t> max_published_safe_time_returned_without_lease_{
+      HybridTime::kMin.ToUint64()};
+
+  // Set in the constructor and internally synchronized, because SafeTime fast path adds items to
+  // it without holding mutex_.
+  std::unique_ptr<MvccOpTrace> op_trace_;
 };
 
 }  // namespace tablet
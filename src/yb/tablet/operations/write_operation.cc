@@ -69,9 +69,14 @@ Status WriteOperation::Prepare() {
 
 Status WriteOperation::DoAborted(const Status& status) {
   TRACE("FINISH: aborting operation");
+  tablet()->DiscardBulkLoadBatch(op_id());
   return status;
 }
 
+void WriteOperation::AddedAsPending() {
+  tablet()->PrepareBulkLoadBatch(*this);
+}
+
 // FIXME: Since this is called as a void in a thread-pool callback,
 // it seems pointless to return a Status!
 Status WriteOperation::DoReplicated(int64_t leader_term, Status* complete_status) {
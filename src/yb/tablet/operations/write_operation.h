@@ -105,6 +105,9 @@ class WriteOperation : public OperationBase<OperationType::kWrite, WritePB>  {
   // Aborts the mvcc transaction.
   CHECKED_STATUS DoAborted(const Status& status) override;
 
+  // Starts preparing SST file for the bulk load batch, see Tablet::PrepareBulkLoadBatch.
+  void AddedAsPending() override;
+
   HybridTime WriteHybridTime() const override;
 };
 
@@ -56,7 +56,8 @@ RunningTransaction::RunningTransaction(TransactionMetadata metadata,
                            metadata_.transaction_id),
       get_status_handle_(context->rpcs_.InvalidHandle()),
       abort_handle_(context->rpcs_.InvalidHandle()),
-      apply_intents_task_(&context->applier_, context, &apply_data_),
+      apply_intents_task_(&context->applier_, &context->participant_context_, context,
+                          &apply_data_),
       abort_check_ht_(base_time_for_abort_check_ht_calculation.AddDelta(
                           1ms * FLAGS_transaction_abort_check_interval_ms)) {
 }
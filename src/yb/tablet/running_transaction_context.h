@@ -19,11 +19,14 @@
 #include <functional>
 #include <mutex>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <gflags/gflags_declare.h>
 
 #include "yb/gutil/callback.h"
 #include "yb/gutil/integral_types.h"
+#include "yb/gutil/thread_annotations.h"
 
 #include "yb/rpc/rpc.h"
 
@@ -32,6 +35,7 @@
 
 #include "yb/util/delayer.h"
 #include "yb/util/math_util.h"
+#include "yb/util/metrics.h"
 #include "yb/util/shared_lock.h"
 #include "yb/util/status_callback.h"
 
@@ -58,6 +62,16 @@ class MinRunningNotifier {
 
 class RunningTransaction;
 
+// Metrics of intents apply, shared by all ApplyIntentsTask instances of the participant.
+struct ApplyIntentsMetrics {
+  // Number of large transactions whose intents are applied in several steps right now.
+  scoped_refptr<AtomicGauge<uint64_t>> transactions_applying;
+  // Number of apply steps performed, each step applies at most txn_max_apply_batch_records.
+  scoped_refptr<Counter> steps;
+  // Number of times apply of a large transaction was rescheduled to let other tasks run.
+  scoped_refptr<Counter> yields;
+};
+
 typedef std::shared_ptr<RunningTransaction> RunningTransactionPtr;
 
 YB_DEFINE_ENUM(RemoveReason,
@@ -90,6 +104,21 @@ class RunningTransactionContext {
 
   virtual bool Closing() const = 0;
 
+  const ApplyIntentsMetrics& apply_intents_metrics() const {
+    return apply_intents_metrics_;
+  }
+
+  // Used only in tests, see FLAGS_TEST_record_apply_intents_events.
+  void TEST_RecordApplyIntentsEvent(const TransactionId& id, size_t steps) {
+    std::lock_guard<std::mutex> lock(TEST_apply_intents_events_mutex_);
+    TEST_apply_intents_events_.emplace_back(id, steps);
+  }
+
+  std::vector<std::pair<TransactionId, size_t>> TEST_ApplyIntentsEvents() {
+    std::lock_guard<std::mutex> lock(TEST_apply_intents_events_mutex_);
+    return TEST_apply_intents_events_;
+  }
+
  protected:
   friend class RunningTransaction;
 
@@ -98,9 +127,14 @@ class RunningTransactionContext {
   TransactionIntentApplier& applier_;
   int64_t request_serial_ = 0;
   std::mutex mutex_;
+  ApplyIntentsMetrics apply_intents_metrics_;
 
   // Used only in tests.
   Delayer delayer_;
+
+  std::mutex TEST_apply_intents_events_mutex_;
+  std::vector<std::pair<TransactionId, size_t>> TEST_apply_intents_events_
+      GUARDED_BY(TEST_apply_intents_events_mutex_);
 };
 
 } // namespace tablet
@@ -39,6 +39,10 @@
 
 #include <time.h>
 
+#include <mutex>
+#include <set>
+#include <thread>
+
 #include <glog/logging.h>
 
 #include "yb/client/table.h"
@@ -54,15 +58,22 @@
 #include "yb/tablet/tablet-test-base.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_bootstrap_if.h"
+#include "yb/tablet/tablet_retention_policy.h"
 
 #include "yb/util/enums.h"
 #include "yb/util/slice.h"
 #include "yb/util/status_log.h"
 #include "yb/util/test_macros.h"
+#include "yb/util/test_thread_holder.h"
+#include "yb/util/tsan_util.h"
 
 using std::shared_ptr;
 using std::unordered_set;
 
+using namespace std::literals;
+
+DECLARE_int32(timestamp_history_retention_interval_sec);
+
 namespace yb {
 namespace tablet {
 
@@ -222,5 +233,125 @@ TYPED_TEST(TestTablet, TestFlushedOpId) {
   ASSERT_EQ(id.index, start_index + 2*kCount);
 }
 
+class TabletRetentionPolicyTest : public TabletTestBase<IntKeyTestSetup<INT64>> {
+};
+
+// Registers more readers than there are lock-free reader slots, so the oldest reader lands in the
+// overflow set, and checks that history cutoff respects it.
+TEST_F(TabletRetentionPolicyTest, OverflowReaders) {
+  constexpr size_t kNumReaders = 40;
+  google::FlagSaver flag_saver;
+  FLAGS_timestamp_history_retention_interval_sec = 0;
+
+  auto* policy = tablet()->RetentionPolicy();
+  std::vector<HybridTime> timestamps;
+  for (size_t i = 0; i != kNumReaders + 1; ++i) {
+    timestamps.push_back(clock()->Now());
+  }
+
+  // Register the oldest reader last, after all slots are occupied by newer ones.
+  for (size_t i = 1; i != timestamps.size(); ++i) {
+    ASSERT_OK(policy->RegisterReaderTimestamp(timestamps[i]));
+  }
+  ASSERT_OK(policy->RegisterReaderTimestamp(timestamps[0]));
+  ASSERT_EQ(policy->GetRetentionDirective().history_cutoff, timestamps[0]);
+
+  policy->UnregisterReaderTimestamp(timestamps[0]);
+  ASSERT_EQ(policy->GetRetentionDirective().history_cutoff, timestamps[1]);
+
+  // Reader older than committed history cutoff is rejected.
+  auto status = policy->RegisterReaderTimestamp(timestamps[0]);
+  ASSERT_TRUE(status.IsSnapshotTooOld()) << status;
+
+  for (size_t i = 1; i != timestamps.size(); ++i) {
+    policy->UnregisterReaderTimestamp(timestamps[i]);
+  }
+  ASSERT_GT(policy->GetRetentionDirective().history_cutoff, timestamps.back());
+}
+
+// Registers and unregisters readers concurrently with history cutoff calculation, and checks that
+// history cutoff never passes a registered reader.
+TEST_F(TabletRetentionPolicyTest, ConcurrentReaders) {
+  constexpr int kNumReaderThreads = 8;
+  constexpr size_t kReadersPerThread = 16;
+  // Number of lock-free reader slots in TabletRetentionPolicy.
+  constexpr size_t kNumReaderSlots = 32;
+  google::FlagSaver flag_saver;
+  FLAGS_timestamp_history_retention_interval_sec = 0;
+
+  auto* policy = tablet()->RetentionPolicy();
+  auto* clock = this->clock();
+
+  // Readers that are registered in policy. Reader is added after successful registration and
+  // removed before unregistration, so it is registered in policy while it is present here.
+  std::mutex mutex;
+  std::multiset<HybridTime> registered;
+  size_t max_registered = 0;
+  std::atomic<size_t> num_rejected{0};
+  std::atomic<size_t> num_checks{0};
+
+  TestThreadHolder thread_holder;
+  for (int i = 0; i != kNumReaderThreads; ++i) {
+    thread_holder.AddThreadFunctor(
+        [policy, clock, &stop = thread_holder.stop_flag(), &mutex, &registered, &max_registered,
+         &num_rejected] {
+      std::vector<HybridTime> held;
+      while (!stop.load(std::memory_order_acquire)) {
+        while (held.size() < kReadersPerThread) {
+          auto timestamp = clock->Now();
+          auto status = policy->RegisterReaderTimestamp(timestamp);
+          if (!status.ok()) {
+            ASSERT_TRUE(status.IsSnapshotTooOld()) << status;
+            ++num_rejected;
+            continue;
+          }
+          held.push_back(timestamp);
+          std::lock_guard<std::mutex> lock(mutex);
+          registered.insert(timestamp);
+          max_registered = std::max(max_registered, registered.size());
+        }
+        for (auto timestamp : held) {
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            registered.erase(registered.find(timestamp));
+          }
+          policy->UnregisterReaderTimestamp(timestamp);
+        }
+        held.clear();
+      }
+      for (auto timestamp : held) {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          registered.erase(registered.find(timestamp));
+        }
+        policy->UnregisterReaderTimestamp(timestamp);
+      }
+    });
+  }
+
+  thread_holder.AddThreadFunctor(
+      [policy, &stop = thread_holder.stop_flag(), &mutex, &registered, &num_checks] {
+    while (!stop.load(std::memory_order_acquire)) {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto history_cutoff = policy->GetRetentionDirective().history_cutoff;
+        if (!registered.empty()) {
+          ASSERT_LE(history_cutoff, *registered.begin());
+        }
+      }
+      ++num_checks;
+      std::this_thread::yield();
+    }
+  });
+
+  thread_holder.WaitAndStop(3s * kTimeMultiplier);
+
+  LOG(INFO) << "Checks: " << num_checks << ", rejected readers: " << num_rejected
+            << ", max registered readers: " << max_registered;
+  ASSERT_GT(num_checks, 0);
+  ASSERT_GT(max_registered, kNumReaderSlots);
+  ASSERT_TRUE(registered.empty());
+}
+
 } // namespace tablet
 } // namespace yb
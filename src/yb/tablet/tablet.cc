@@ -32,6 +32,8 @@
 
 #include "yb/tablet/tablet.h"
 
+#include <deque>
+
 #include <boost/container/static_vector.hpp>
 
 #include "yb/client/client.h"
@@ -60,6 +62,7 @@
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/cql_operation.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
+#include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/doc_write_batch.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb_compaction_filter.h"
@@ -73,13 +76,17 @@
 
 #include "yb/gutil/casts.h"
 
+#include "yb/rocksdb/db/filename.h"
 #include "yb/rocksdb/db/memtable.h"
+#include "yb/rocksdb/immutable_options.h"
+#include "yb/rocksdb/sst_file_writer.h"
 #include "yb/rocksdb/utilities/checkpoint.h"
 
 #include "yb/rocksutil/yb_rocksdb.h"
 
 #include "yb/server/hybrid_clock.h"
 
+#include "yb/tablet/compaction_rate_controller.h"
 #include "yb/tablet/operations/change_metadata_operation.h"
 #include "yb/tablet/operations/operation.h"
 #include "yb/tablet/operations/snapshot_operation.h"
@@ -99,14 +106,17 @@
 
 #include "yb/tserver/tserver.pb.h"
 
+#include "yb/util/countdown_latch.h"
 #include "yb/util/debug-util.h"
 #include "yb/util/debug/trace_event.h"
+#include "yb/util/enums.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/format.h"
 #include "yb/util/logging.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
 #include "yb/util/net/net_util.h"
+#include "yb/util/path_util.h"
 #include "yb/util/pg_util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status_format.h"
@@ -221,6 +231,34 @@ DEFINE_bool(tablet_enable_ttl_file_filter, false,
             "Enables compaction to directly delete files that have expired based on TTL, "
             "rather than removing them via the normal compaction process.");
 
+DEFINE_int32(tablet_cold_data_age_sec, 7 * 24 * 60 * 60,
+             "Compaction output is placed to tablet_cold_data_path when all input files contain "
+             "only data written more than this number of seconds ago.");
+TAG_FLAG(tablet_cold_data_age_sec, advanced);
+TAG_FLAG(tablet_cold_data_age_sec, runtime);
+
+DEFINE_int32(tablet_compaction_time_window_sec, 0,
+             "If positive, SST files of tables with TTL are grouped into time windows of this "
+             "size by their max hybrid time. Compaction never merges files from different "
+             "windows, so whole windows expire and are dropped without being rewritten.");
+TAG_FLAG(tablet_compaction_time_window_sec, advanced);
+TAG_FLAG(tablet_compaction_time_window_sec, runtime);
+
+DEFINE_bool(tablet_ingest_bulk_load_batches, true,
+            "Write batches of bulk load (non transactional COPY and index backfill) directly "
+            "to SST files, that are added to the regular DB instead of going through the mem "
+            "table. It removes mem table inserts, flushes and the write amplification of "
+            "compacting them, but batches are still replicated through Raft and written to the "
+            "WAL, so bulk load throughput remains bounded by replication.");
+TAG_FLAG(tablet_ingest_bulk_load_batches, advanced);
+TAG_FLAG(tablet_ingest_bulk_load_batches, runtime);
+
+DEFINE_int32(tablet_bulk_load_ingest_min_records, 1000,
+             "Bulk load batches with fewer records are written through the mem table, to avoid "
+             "creating a lot of small SST files.");
+TAG_FLAG(tablet_bulk_load_ingest_min_records, advanced);
+TAG_FLAG(tablet_bulk_load_ingest_min_records, runtime);
+
 DEFINE_test_flag(int32, slowdown_backfill_by_ms, 0,
                  "If set > 0, slows down the backfill process by this amount.");
 
@@ -413,6 +451,7 @@ Tablet::Tablet(const TabletInitData& data)
              : rocksdb::CreateDBStatistics(table_metrics_entity_, nullptr, true));
 
     metrics_.reset(new TabletMetrics(table_metrics_entity_, tablet_metrics_entity_));
+    retention_policy_->SetHistoryCutoffLagGauge(metrics_->history_cutoff_lag_ms);
 
     mem_tracker_->SetMetricEntity(tablet_metrics_entity_);
   }
@@ -694,10 +733,55 @@ Status Tablet::OpenKeyValueTablet() {
   rocksdb::Options regular_rocksdb_options(rocksdb_options);
   regular_rocksdb_options.listeners.push_back(
       std::make_shared<RegularRocksDbListener>(this, regular_rocksdb_options.log_prefix));
+  regular_rocksdb_options.compaction_time_window =
+      std::make_shared<std::function<int64_t(const rocksdb::FileMetaData&)>>(
+          [this](const rocksdb::FileMetaData& file) -> int64_t {
+    const int64_t window_sec = FLAGS_tablet_compaction_time_window_sec;
+    // Retention directive is not used here, since obtaining it advances the history cutoff.
+    if (window_sec <= 0 || docdb::TableTTL(*metadata_->schema()) == docdb::Value::kMaxTtl) {
+      return 0;
+    }
+    const auto created_ht = docdb::ExtractExpirationTime(&file).created_ht;
+    return static_cast<int64_t>(created_ht.GetPhysicalValueMicros()) /
+           (window_sec * MonoTime::kMicrosecondsPerSecond);
+  });
 
   const string db_dir = metadata()->rocksdb_dir();
   RETURN_NOT_OK(CreateTabletDirectories(db_dir, metadata()->fs_manager()));
 
+  const auto cold_dir = metadata()->cold_rocksdb_dir();
+  if (!cold_dir.empty()) {
+    RETURN_NOT_OK_PREPEND(metadata()->fs_manager()->env()->CreateDirs(cold_dir),
+                          Format("Failed to create RocksDB cold data directory $0", cold_dir));
+    // Flushes and hot compactions go to the first path, cold compaction outputs to the second.
+    regular_rocksdb_options.db_paths = {
+        rocksdb::DbPath(db_dir, std::numeric_limits<uint64_t>::max()),
+        rocksdb::DbPath(cold_dir, std::numeric_limits<uint64_t>::max()),
+    };
+    regular_rocksdb_options.cold_compaction_output =
+        std::make_shared<std::function<bool(const std::vector<rocksdb::FileMetaData*>&)>>(
+            [this](const std::vector<rocksdb::FileMetaData*>& inputs) {
+      const auto horizon = clock()->Now().AddSeconds(-FLAGS_tablet_cold_data_age_sec);
+      for (const auto* file : inputs) {
+        if (docdb::ExtractExpirationTime(file).created_ht >= horizon) {
+          return false;
+        }
+      }
+      return true;
+    });
+  }
+
+  // Files left in the bulk load staging directory were not added to the regular DB, operations
+  // that wrote them are replayed by bootstrap.
+  const auto bulk_load_dir = metadata()->bulk_load_dir();
+  auto* env = metadata()->fs_manager()->env();
+  if (env->FileExists(bulk_load_dir)) {
+    RETURN_NOT_OK_PREPEND(env->DeleteRecursively(bulk_load_dir),
+                          Format("Failed to clean bulk load directory $0", bulk_load_dir));
+  }
+  RETURN_NOT_OK_PREPEND(env->CreateDirs(bulk_load_dir),
+                        Format("Failed to create bulk load directory $0", bulk_load_dir));
+
   LOG(INFO) << "Opening RocksDB at: " << db_dir;
   rocksdb::DB* db = nullptr;
   rocksdb::Status rocksdb_open_status = rocksdb::DB::Open(regular_rocksdb_options, db_dir, &db);
@@ -724,6 +808,8 @@ Status Tablet::OpenKeyValueTablet() {
     intents_rocksdb_options.compaction_filter_factory =
         FLAGS_tablet_do_compaction_cleanup_for_intents ?
         std::make_shared<docdb::DocDBIntentsCompactionFilterFactory>(this, &key_bounds_) : nullptr;
+    // Intents DB is expected to be small, so it is not worth splitting its compactions.
+    intents_rocksdb_options.max_subcompactions = 1;
 
     intents_rocksdb_options.mem_tracker = MemTracker::FindOrCreateTracker(kIntentsDB, mem_tracker_);
     intents_rocksdb_options.block_based_table_mem_tracker =
@@ -770,6 +856,8 @@ void Tablet::RegularDbFilesChanged() {
 }
 
 void Tablet::SetCleanupPool(ThreadPool* thread_pool) {
+  bulk_load_token_ = thread_pool->NewToken(ThreadPool::ExecutionMode::CONCURRENT);
+
   if (!transaction_participant_) {
     return;
   }
@@ -943,6 +1031,11 @@ void Tablet::CompleteShutdown(IsDropTable is_drop_table) {
   }
 
   cleanup_intent_files_token_.reset();
+  bulk_load_token_.reset();
+  {
+    std::lock_guard<std::mutex> lock(bulk_load_files_mutex_);
+    bulk_load_files_.clear();
+  }
 
   if (transaction_coordinator_) {
     transaction_coordinator_->Shutdown();
@@ -1114,8 +1207,173 @@ Result<std::unique_ptr<docdb::YQLRowwiseIteratorIf>> Tablet::NewRowIterator(
   return NewRowIterator(*table_info->schema, {}, table_id);
 }
 
+namespace {
+
+// Returns true if put_batch contains only non transactional writes to the regular DB.
+bool IsRegularDbOnlyWriteBatch(const KeyValueWriteBatchPB& put_batch) {
+  if (put_batch.has_transaction() || !put_batch.apply_external_transactions().empty()) {
+    return false;
+  }
+  for (const auto& pair : put_batch.write_pairs()) {
+    if (!pair.key().empty() && pair.key()[0] == docdb::ValueTypeAsChar::kExternalTransactionId) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Collects records of a write batch, so they could be sorted and written to SST file.
+class CollectingWriteHandler : public rocksdb::DirectWriteHandler {
+ public:
+  void Put(const SliceParts& key, const SliceParts& value) override {
+    std::string key_str(key.SumSizes(), '\0');
+    key.CopyAllTo(&key_str[0]);
+    std::string value_str(value.SumSizes(), '\0');
+    value.CopyAllTo(&value_str[0]);
+    records_.emplace_back(std::move(key_str), std::move(value_str));
+  }
+
+  std::vector<std::pair<std::string, std::string>>& records() {
+    return records_;
+  }
+
+ private:
+  std::vector<std::pair<std::string, std::string>> records_;
+};
+
+// Writes records of multiple write operations, each with its own hybrid time.
+class MultiOperationWriter : public rocksdb::DirectWriter {
+ public:
+  void Add(const KeyValueWriteBatchPB& put_batch, HybridTime hybrid_time) {
+    writers_.emplace_back(put_batch, hybrid_time);
+  }
+
+  bool Empty() const {
+    return writers_.empty();
+  }
+
+  CHECKED_STATUS Apply(rocksdb::DirectWriteHandler* handler) override {
+    for (auto& writer : writers_) {
+      RETURN_NOT_OK(writer.Apply(handler));
+    }
+    return Status::OK();
+  }
+
+ private:
+  std::deque<docdb::NonTransactionalWriter> writers_;
+};
+
+YB_DEFINE_ENUM(BulkLoadFileState, (kNotAdded)(kAdded)(kUnknown));
+
+// Ingested files do not advance the flushed op id, so a bulk load operation could be replayed by
+// bootstrap after its file was already added to the DB. Such file is recognized by its frontiers,
+// unless it was compacted together with other files.
+// Lists all live files of the DB, so should be used only for replayed operations.
+BulkLoadFileState GetBulkLoadFileState(rocksdb::DB* db, const yb::OpId& op_id) {
+  std::vector<rocksdb::LiveFileMetaData> files;
+  db->GetLiveFilesMetaData(&files);
+  auto result = BulkLoadFileState::kNotAdded;
+  for (const auto& file : files) {
+    if (!file.smallest.user_frontier || !file.largest.user_frontier) {
+      continue;
+    }
+    const auto& smallest =
+        down_cast<docdb::ConsensusFrontier&>(*file.smallest.user_frontier).op_id();
+    const auto& largest = down_cast<docdb::ConsensusFrontier&>(*file.largest.user_frontier).op_id();
+    if (smallest == op_id && largest == op_id) {
+      return BulkLoadFileState::kAdded;
+    }
+    // Operations are applied in order, so such file could exist only after restart.
+    if (largest.index >= op_id.index) {
+      result = BulkLoadFileState::kUnknown;
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+// SST file with records of a bulk load batch, written before the operation is applied.
+// The file is deleted unless it was added to the regular DB.
+struct Tablet::BulkLoadFile {
+  explicit BulkLoadFile(rocksdb::Env* env_) : env(env_) {}
+
+  ~BulkLoadFile() {
+    if (added || file_info.file_path.empty()) {
+      return;
+    }
+    env->CleanupFile(file_info.file_path);
+    if (file_info.is_split_sst) {
+      env->CleanupFile(rocksdb::TableBaseToDataFileName(file_info.file_path));
+    }
+  }
+
+  rocksdb::Env* env;
+  CountDownLatch ready{1};
+  Status status;
+  rocksdb::ExternalSstFileInfo file_info;
+  bool added = false;
+};
+
+void Tablet::PreApplyWrites(const std::vector<const consensus::ReplicateMsg*>& replicate_msgs) {
+  auto scoped_operation = CreateNonAbortableScopedRWOperation();
+  if (!scoped_operation.ok()) {
+    return;
+  }
+
+  MultiOperationWriter writer;
+  docdb::ConsensusFrontiers frontiers;
+  bool has_frontiers = false;
+  int64_t last_op_index = 0;
+  size_t num_ops = 0;
+  for (const auto* replicate_msg : replicate_msgs) {
+    const auto& write_request = replicate_msg->write();
+    const auto& put_batch = write_request.write_batch();
+    // Bulk load batch could be ingested as a separate SST file, so it is applied individually.
+    // Records with external hybrid time could be below the safe time, so they would become
+    // visible before the preceding operations are applied.
+    if (!IsRegularDbOnlyWriteBatch(put_batch) || put_batch.bulk_load() ||
+        write_request.has_external_hybrid_time()) {
+      break;
+    }
+    const HybridTime log_ht(replicate_msg->hybrid_time());
+    docdb::ConsensusFrontiers op_frontiers;
+    if (InitFrontiers(OpId::FromPB(replicate_msg->id()), log_ht, &op_frontiers)) {
+      auto ttl = put_batch.has_ttl()
+          ? MonoDelta::FromNanoseconds(put_batch.ttl())
+          : docdb::Value::kMaxTtl;
+      op_frontiers.Largest().set_max_value_level_ttl_expiration_time(
+          docdb::FileExpirationFromValueTTL(log_ht, ttl));
+      if (has_frontiers) {
+        frontiers.MergeFrontiers(op_frontiers);
+      } else {
+        frontiers = op_frontiers;
+        has_frontiers = true;
+      }
+    }
+    if (!put_batch.write_pairs().empty()) {
+      writer.Add(put_batch, log_ht);
+    }
+    last_op_index = replicate_msg->id().index();
+    ++num_ops;
+  }
+
+  // Single operation is applied as usual.
+  if (num_ops < 2 || writer.Empty()) {
+    return;
+  }
+
+  rocksdb::WriteBatch write_batch;
+  write_batch.SetDirectWriter(&writer);
+  WriteToRocksDB(has_frontiers ? &frontiers : nullptr, &write_batch, StorageDbType::kRegular);
+  pre_applied_op_index_.store(last_op_index, std::memory_order_release);
+}
+
 Status Tablet::ApplyRowOperations(
     WriteOperation* operation, AlreadyAppliedToRegularDB already_applied_to_regular_db) {
+  if (operation->op_id().index <= pre_applied_op_index_.load(std::memory_order_acquire)) {
+    already_applied_to_regular_db = AlreadyAppliedToRegularDB::kTrue;
+  }
   const auto& write_request =
       operation->consensus_round() && operation->consensus_round()->replicate_msg()
           // Online case.
@@ -1128,6 +1386,10 @@ Status Tablet::ApplyRowOperations(
             << put_batch.ShortDebugString();
     metrics_->rows_inserted->IncrementBy(put_batch.write_pairs().size());
   }
+  // Only local apply is measured, Raft replication latency does not depend on compactions of
+  // this server. Writes replayed during bootstrap are not foreground operations.
+  ScopedForegroundLatencyRecorder latency_recorder(
+      operation->consensus_round() ? compaction_rate_controller() : nullptr);
 
   return ApplyOperation(
       *operation, write_request.batch_idx(), put_batch, already_applied_to_regular_db);
@@ -1151,8 +1413,10 @@ Status Tablet::ApplyOperation(
     frontiers_ptr->Largest().set_max_value_level_ttl_expiration_time(
         docdb::FileExpirationFromValueTTL(operation.hybrid_time(), ttl));
   }
+  // Operation without consensus round is replayed by bootstrap.
   return ApplyKeyValueRowOperations(
-      batch_idx, write_batch, frontiers_ptr, hybrid_time, already_applied_to_regular_db);
+      batch_idx, write_batch, frontiers_ptr, hybrid_time, already_applied_to_regular_db,
+      Replayed(!operation.consensus_round()));
 }
 
 Status Tablet::WriteTransactionalBatch(
@@ -1214,7 +1478,8 @@ Status Tablet::ApplyKeyValueRowOperations(
     const KeyValueWriteBatchPB& put_batch,
     const rocksdb::UserFrontiers* frontiers,
     const HybridTime hybrid_time,
-    AlreadyAppliedToRegularDB already_applied_to_regular_db) {
+    AlreadyAppliedToRegularDB already_applied_to_regular_db,
+    Replayed replayed) {
   if (put_batch.write_pairs().empty() && put_batch.read_pairs().empty() &&
       put_batch.apply_external_transactions().empty()) {
     return Status::OK();
@@ -1242,6 +1507,20 @@ Status Tablet::ApplyKeyValueRowOperations(
       WriteToRocksDB(frontiers, &intents_write_batch, StorageDbType::kIntents);
     }
 
+    if (put_batch.bulk_load()) {
+      auto bulk_load_file = TakeBulkLoadFile(frontiers);
+      if (!already_applied_to_regular_db && ShouldIngestBulkLoadBatch(put_batch)) {
+        auto ingested = IngestBulkLoadBatch(
+            put_batch, hybrid_time, frontiers, std::move(bulk_load_file), replayed);
+        if (!ingested.ok()) {
+          LOG_WITH_PREFIX(WARNING) << "Failed to ingest bulk load batch, writing it through mem "
+                                   << "table: " << ingested.status();
+        } else if (*ingested) {
+          already_applied_to_regular_db = AlreadyAppliedToRegularDB::kTrue;
+        }
+      }
+    }
+
     docdb::NonTransactionalWriter writer(put_batch, hybrid_time);
     if (!already_applied_to_regular_db && has_non_exteranl_records) {
       regular_write_batch.SetDirectWriter(&writer);
@@ -1261,6 +1540,151 @@ Status Tablet::ApplyKeyValueRowOperations(
   return Status::OK();
 }
 
+bool Tablet::ShouldIngestBulkLoadBatch(const KeyValueWriteBatchPB& put_batch) const {
+  return FLAGS_tablet_ingest_bulk_load_batches && put_batch.bulk_load() &&
+         put_batch.write_pairs().size() >= FLAGS_tablet_bulk_load_ingest_min_records &&
+         IsRegularDbOnlyWriteBatch(put_batch);
+}
+
+void Tablet::PrepareBulkLoadBatch(const Operation& operation) {
+  if (!operation.consensus_round() || FLAGS_TEST_disable_adding_user_frontier_to_sst) {
+    return;
+  }
+  // Replicate message owns the write batch, so keep it alive until the file is written.
+  auto replicate_msg = operation.consensus_round()->replicate_msg();
+  if (!replicate_msg || !ShouldIngestBulkLoadBatch(replicate_msg->write().write_batch())) {
+    return;
+  }
+  auto scoped_operation = CreateNonAbortableScopedRWOperation();
+  if (!scoped_operation.ok() || !bulk_load_token_) {
+    return;
+  }
+
+  auto file = std::make_shared<BulkLoadFile>(&rocksdb_env());
+  {
+    std::lock_guard<std::mutex> lock(bulk_load_files_mutex_);
+    bulk_load_files_[operation.op_id()] = file;
+  }
+  auto hybrid_time = operation.WriteHybridTime();
+  auto status = bulk_load_token_->SubmitFunc([this, file, replicate_msg, hybrid_time] {
+    auto scoped_write = CreateNonAbortableScopedRWOperation();
+    file->status = scoped_write.ok()
+        ? WriteBulkLoadFile(replicate_msg->write().write_batch(), hybrid_time, file.get())
+        : scoped_write.status();
+    file->ready.CountDown();
+  });
+  if (!status.ok()) {
+    file->status = status;
+    file->ready.CountDown();
+  }
+}
+
+void Tablet::DiscardBulkLoadBatch(const yb::OpId& op_id) {
+  std::lock_guard<std::mutex> lock(bulk_load_files_mutex_);
+  bulk_load_files_.erase(op_id);
+}
+
+std::shared_ptr<Tablet::BulkLoadFile> Tablet::TakeBulkLoadFile(
+    const rocksdb::UserFrontiers* frontiers) {
+  if (!frontiers) {
+    return nullptr;
+  }
+  const auto& op_id = down_cast<const docdb::ConsensusFrontier&>(frontiers->Largest()).op_id();
+  std::lock_guard<std::mutex> lock(bulk_load_files_mutex_);
+  auto it = bulk_load_files_.find(op_id);
+  if (it == bulk_load_files_.end()) {
+    return nullptr;
+  }
+  auto result = std::move(it->second);
+  bulk_load_files_.erase(it);
+  return result;
+}
+
+Status Tablet::WriteBulkLoadFile(
+    const KeyValueWriteBatchPB& put_batch, HybridTime hybrid_time, BulkLoadFile* file) {
+  CollectingWriteHandler handler;
+  docdb::NonTransactionalWriter writer(put_batch, hybrid_time);
+  RETURN_NOT_OK(writer.Apply(&handler));
+  auto& records = handler.records();
+  SCHECK(!records.empty(), InvalidArgument, "Bulk load batch without records");
+
+  const auto& options = regular_db_->GetOptions();
+  const auto* comparator = options.comparator;
+  std::sort(records.begin(), records.end(), [comparator](const auto& lhs, const auto& rhs) {
+    return comparator->Compare(lhs.first, rhs.first) < 0;
+  });
+
+  // Files are prepared concurrently, so each one gets its own name. The staging directory is on
+  // the same file system as the regular DB, so the file is moved to the DB by hard link.
+  const auto file_path = JoinPathSegments(
+      metadata_->bulk_load_dir(),
+      Format("$0-$1.sst", hybrid_time.ToUint64(), bulk_load_file_counter_.fetch_add(1)));
+  rocksdb::SstFileWriter sst_writer(
+      rocksdb::EnvOptions(options), rocksdb::ImmutableCFOptions(options), comparator);
+  RETURN_NOT_OK(sst_writer.Open(file_path));
+  for (const auto& record : records) {
+    RETURN_NOT_OK(sst_writer.Add(record.first, record.second));
+  }
+  return sst_writer.Finish(&file->file_info);
+}
+
+Result<bool> Tablet::IngestBulkLoadBatch(
+    const KeyValueWriteBatchPB& put_batch, HybridTime hybrid_time,
+    const rocksdb::UserFrontiers* frontiers, std::shared_ptr<BulkLoadFile> file,
+    Replayed replayed) {
+  // Only operation replayed by bootstrap could find its file already added, so live files of the
+  // DB are not listed on the apply path of online operations.
+  if (frontiers && replayed) {
+    const auto& op_id = down_cast<const docdb::ConsensusFrontier&>(frontiers->Largest()).op_id();
+    switch (GetBulkLoadFileState(regular_db_.get(), op_id)) {
+      case BulkLoadFileState::kNotAdded:
+        break;
+      case BulkLoadFileState::kAdded:
+        VLOG_WITH_PREFIX(2) << "Bulk load batch of " << op_id << " was already ingested";
+        return true;
+      case BulkLoadFileState::kUnknown:
+        // Writing the same records through the mem table again is safe, they just get higher
+        // sequence numbers.
+        VLOG_WITH_PREFIX(2) << "Bulk load batch of " << op_id << " could be already ingested";
+        return false;
+    }
+  }
+
+  if (file) {
+    file->ready.Wait();
+  } else {
+    // Operation is replayed by bootstrap, or its file was not prepared in advance.
+    file = std::make_shared<BulkLoadFile>(&rocksdb_env());
+    file->status = WriteBulkLoadFile(put_batch, hybrid_time, file.get());
+  }
+  RETURN_NOT_OK(file->status);
+
+  // Frontiers keep op id and hybrid time of the operation in the file metadata, the same way as
+  // for files flushed from the mem table. For instance, file creation time is derived from them.
+  file->file_info.user_frontiers = frontiers;
+
+  // Index backfill runs concurrently with online writes to the index, so its file could overlap
+  // with existing data. Keys of index backfill are unique by the base row and contain write time,
+  // so records of the file do not share user keys with other records. Other bulk loads fall back
+  // to the mem table when their key range overlaps with existing data.
+  //
+  // Consensus frontiers of the file do not advance the flushed op id, so operations that are
+  // still in the mem table are replayed after restart. Replayed operation detects its file by
+  // frontiers, see GetBulkLoadFileState.
+  auto status = regular_db_->AddFile(
+      &file->file_info, true /* move_file */, put_batch.bulk_load_allow_overlap());
+  if (!status.ok()) {
+    VLOG_WITH_PREFIX(1) << "Failed to ingest bulk load batch of " << file->file_info.num_entries
+                        << " records, writing it through mem table: " << status;
+    return false;
+  }
+  file->added = true;
+
+  VLOG_WITH_PREFIX(2) << "Ingested bulk load batch of " << file->file_info.num_entries
+                      << " records";
+  return true;
+}
+
 void Tablet::WriteToRocksDB(
     const rocksdb::UserFrontiers* frontiers,
     rocksdb::WriteBatch* write_batch,
@@ -1310,6 +1734,7 @@ Status Tablet::HandleRedisReadRequest(CoarseTimePoint deadline,
   RETURN_NOT_OK(scoped_read_operation);
 
   ScopedTabletMetricsTracker metrics_tracker(metrics_->redis_read_latency);
+  ScopedForegroundLatencyRecorder latency_recorder(compaction_rate_controller());
 
   docdb::RedisReadOperation doc_op(redis_read_request, doc_db(), deadline, read_time);
   RETURN_NOT_OK(doc_op.Execute());
@@ -1343,6 +1768,7 @@ Status Tablet::HandleQLReadRequest(
   auto scoped_read_operation = CreateNonAbortableScopedRWOperation(deadline);
   RETURN_NOT_OK(scoped_read_operation);
   ScopedTabletMetricsTracker metrics_tracker(metrics_->ql_read_latency);
+  ScopedForegroundLatencyRecorder latency_recorder(compaction_rate_controller());
 
   if (!IsSchemaVersionCompatible(
           metadata()->schema_version(), ql_read_request.schema_version(),
@@ -1425,6 +1851,7 @@ Status Tablet::HandlePgsqlReadRequest(
   RETURN_NOT_OK(scoped_read_operation);
   // TODO(neil) Work on metrics for PGSQL.
   // ScopedTabletMetricsTracker metrics_tracker(metrics_->pgsql_read_latency);
+  ScopedForegroundLatencyRecorder latency_recorder(compaction_rate_controller());
 
   const shared_ptr<tablet::TableInfo> table_info =
       VERIFY_RESULT(metadata_->GetTableInfo(pgsql_read_request.table_id()));
@@ -3242,6 +3669,36 @@ std::pair<int, int> Tablet::GetNumMemtables() const {
   return std::make_pair(intents_num_memtables, regular_num_memtables);
 }
 
+std::pair<uint64_t, uint64_t> Tablet::GetMutableMemtableSizes() const {
+  // Empty memtable still holds allocated arena block, so report zero size for it.
+  auto memtable_size = [](rocksdb::DB* db) -> uint64_t {
+    uint64_t num_entries = 0;
+    uint64_t size = 0;
+    if (!db->GetIntProperty(rocksdb::DB::Properties::kNumEntriesActiveMemTable, &num_entries) ||
+        num_entries == 0 ||
+        !db->GetIntProperty(rocksdb::DB::Properties::kCurSizeActiveMemTable, &size)) {
+      return 0;
+    }
+    return size;
+  };
+
+  uint64_t intents_memtable_size = 0;
+  uint64_t regular_memtable_size = 0;
+
+  {
+    auto scoped_operation = CreateNonAbortableScopedRWOperation();
+    std::lock_guard<rw_spinlock> lock(component_lock_);
+    if (intents_db_) {
+      intents_memtable_size = memtable_size(intents_db_.get());
+    }
+    if (regular_db_) {
+      regular_memtable_size = memtable_size(regular_db_.get());
+    }
+  }
+
+  return std::make_pair(intents_memtable_size, regular_memtable_size);
+}
+
 // ------------------------------------------------------------------------------------------------
 
 Result<TransactionOperationContext> Tablet::CreateTransactionOperationContext(
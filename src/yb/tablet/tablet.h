@@ -32,6 +32,8 @@
 #ifndef YB_TABLET_TABLET_H_
 #define YB_TABLET_TABLET_H_
 
+#include <map>
+
 #include <boost/intrusive/list.hpp>
 
 #include "yb/common/common_fwd.h"
@@ -111,6 +113,7 @@ class TabletScopedIf : public RefCountedThreadSafe<TabletScopedIf> {
 
 YB_STRONGLY_TYPED_BOOL(AllowBootstrappingState);
 YB_STRONGLY_TYPED_BOOL(ResetSplit);
+YB_STRONGLY_TYPED_BOOL(Replayed);
 
 struct TabletScopedRWOperationPauses {
   ScopedRWOperationPause abortable;
@@ -292,6 +295,12 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   CHECKED_STATUS RemoveIntents(
       const RemoveIntentsData& data, const TransactionIdSet& transactions) override;
 
+  // Writes data of the longest prefix of replicate_msgs, that contains only non transactional
+  // writes to the regular DB without external hybrid time, with a single RocksDB write.
+  // Those operations are applied to the regular DB already, when ApplyRowOperations is called for
+  // them later.
+  void PreApplyWrites(const std::vector<const consensus::ReplicateMsg*>& replicate_msgs);
+
   // Apply all of the row operations associated with this transaction.
   CHECKED_STATUS ApplyRowOperations(
       WriteOperation* operation,
@@ -309,7 +318,8 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       const docdb::KeyValueWriteBatchPB& put_batch,
       const rocksdb::UserFrontiers* frontiers,
       HybridTime hybrid_time,
-      AlreadyAppliedToRegularDB already_applied_to_regular_db = AlreadyAppliedToRegularDB::kFalse);
+      AlreadyAppliedToRegularDB already_applied_to_regular_db = AlreadyAppliedToRegularDB::kFalse,
+      Replayed replayed = Replayed::kFalse);
 
   void WriteToRocksDB(
       const rocksdb::UserFrontiers* frontiers,
@@ -452,6 +462,12 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // May be nullptr in unit tests, etc.
   TabletMetrics* metrics() { return metrics_.get(); }
 
+  // Return controller of the compaction/flush rate, that should be notified about latency of
+  // foreground operations. May be nullptr.
+  CompactionRateController* compaction_rate_controller() const {
+    return tablet_options_.compaction_rate_controller.get();
+  }
+
   // Return handle to the metric entity of this tablet/table.
   const scoped_refptr<MetricEntity>& GetTableMetricsEntity() const {
     return table_metrics_entity_;
@@ -578,6 +594,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Returns the number of memtables in intents and regular db-s.
   std::pair<int, int> GetNumMemtables() const;
 
+  // Returns approximate sizes in bytes of the mutable memtables of intents and regular db-s.
+  std::pair<uint64_t, uint64_t> GetMutableMemtableSizes() const;
+
   void SetHybridTimeLeaseProvider(HybridTimeLeaseProvider provider) {
     ht_lease_provider_ = std::move(provider);
   }
@@ -606,6 +625,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   CHECKED_STATUS TEST_SwitchMemtable();
 
+  int64_t TEST_pre_applied_op_index() const {
+    return pre_applied_op_index_.load(std::memory_order_acquire);
+  }
+
   // Initialize RocksDB's max persistent op id and hybrid time to that of the operation state.
   // Necessary for cases like truncate or restore snapshot when RocksDB is reset.
   CHECKED_STATUS ModifyFlushedFrontier(
@@ -636,6 +659,14 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   void SetCleanupPool(ThreadPool* thread_pool);
 
+  // Starts writing records of the bulk load batch of the write operation to SST file in the
+  // background, so the file is ready to be added to the regular DB when the operation is applied.
+  // Invoked when op id and hybrid time of the operation are assigned.
+  void PrepareBulkLoadBatch(const Operation& operation);
+
+  // Discards SST file prepared for the bulk load batch of the aborted operation.
+  void DiscardBulkLoadBatch(const yb::OpId& op_id);
+
   TabletSnapshots& snapshots() {
     return *snapshots_;
   }
@@ -737,6 +768,28 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       HybridTime hybrid_time,
       const rocksdb::UserFrontiers* frontiers);
 
+  struct BulkLoadFile;
+
+  // Whether records of the bulk load batch could be written to SST file.
+  bool ShouldIngestBulkLoadBatch(const docdb::KeyValueWriteBatchPB& put_batch) const;
+
+  // Writes sorted records of the bulk load batch to a new SST file in the staging directory.
+  CHECKED_STATUS WriteBulkLoadFile(
+      const docdb::KeyValueWriteBatchPB& put_batch, HybridTime hybrid_time, BulkLoadFile* file);
+
+  // Removes SST file prepared by PrepareBulkLoadBatch for the operation with op id from frontiers.
+  std::shared_ptr<BulkLoadFile> TakeBulkLoadFile(const rocksdb::UserFrontiers* frontiers);
+
+  // Adds SST file with records of the bulk load batch to the regular DB, bypassing the mem table.
+  // The file is written now if it was not prepared in advance. frontiers are assigned to the file.
+  // Returns false if the batch should be written as usual, for instance when its key range overlaps
+  // with existing data. Returns true without adding anything when the file of the replayed
+  // operation is already present in the regular DB.
+  Result<bool> IngestBulkLoadBatch(
+      const docdb::KeyValueWriteBatchPB& put_batch, HybridTime hybrid_time,
+      const rocksdb::UserFrontiers* frontiers, std::shared_ptr<BulkLoadFile> file,
+      Replayed replayed);
+
   Result<TransactionOperationContext> CreateTransactionOperationContext(
       const boost::optional<TransactionId>& transaction_id,
       bool is_ysql_catalog_table,
@@ -948,6 +1001,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::function<rocksdb::MemTableFilter()> mem_table_flush_filter_factory_;
 
+  // Index of the last write operation, that was written to the regular DB by PreApplyWrites.
+  // PreApplyWrites is invoked without holding the consensus lock, before operations are applied.
+  std::atomic<int64_t> pre_applied_op_index_{0};
+
   client::LocalTabletFilter local_tablet_filter_;
 
   // This is typically "P <peer_id>", so we can get a log prefix "T <tablet_id> P <peer_id>: ".
@@ -958,6 +1015,16 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::unique_ptr<ThreadPoolToken> cleanup_intent_files_token_;
 
+  // Writes SST files of bulk load batches, see PrepareBulkLoadBatch.
+  std::unique_ptr<ThreadPoolToken> bulk_load_token_;
+
+  std::mutex bulk_load_files_mutex_;
+  // SST files prepared for bulk load batches of operations that were not applied yet.
+  std::map<yb::OpId, std::shared_ptr<BulkLoadFile>> bulk_load_files_
+      GUARDED_BY(bulk_load_files_mutex_);
+  // Used to generate unique names of bulk load files.
+  std::atomic<uint64_t> bulk_load_file_counter_{0};
+
   std::unique_ptr<TabletSnapshots> snapshots_;
 
   SnapshotCoordinator* snapshot_coordinator_ = nullptr;
@@ -28,6 +28,8 @@ namespace tablet {
 
 class AbstractTablet;
 
+class CompactionRateController;
+
 class OperationDriver;
 typedef scoped_refptr<OperationDriver> OperationDriverPtr;
 
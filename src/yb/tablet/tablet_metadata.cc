@@ -65,6 +65,7 @@
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/path_util.h"
 #include "yb/util/pb_util.h"
 #include "yb/util/random.h"
 #include "yb/util/result.h"
@@ -79,6 +80,11 @@ TAG_FLAG(enable_tablet_orphaned_block_deletion, advanced);
 TAG_FLAG(enable_tablet_orphaned_block_deletion, hidden);
 TAG_FLAG(enable_tablet_orphaned_block_deletion, runtime);
 
+DEFINE_string(tablet_cold_data_path, "",
+              "Root directory for SST files that contain only cold data, usually placed on "
+              "cheaper storage. Cold data is not separated from the tablet data when empty.");
+TAG_FLAG(tablet_cold_data_path, advanced);
+
 using std::shared_ptr;
 
 using base::subtle::Barrier_AtomicIncrement;
@@ -93,6 +99,7 @@ const int64 kNoDurableMemStore = -1;
 const std::string kIntentsSubdir = "intents";
 const std::string kIntentsDBSuffix = ".intents";
 const std::string kSnapshotsDirSuffix = ".snapshots";
+const std::string kBulkLoadDirSuffix = ".bulk_load";
 
 // ============================================================================
 //  Raft group metadata
@@ -406,6 +413,12 @@ Status RaftGroupMetadata::DeleteTabletData(TabletDataState delete_type,
     LOG_IF(WARNING, !s.ok()) << "Unable to delete rocksdb data directory " << rocksdb_dir;
   }
 
+  const auto cold_dir = cold_rocksdb_dir();
+  if (!cold_dir.empty() && fs_manager_->env()->FileExists(cold_dir)) {
+    auto s = fs_manager_->env()->DeleteRecursively(cold_dir);
+    LOG_IF(WARNING, !s.ok()) << "Unable to delete rocksdb cold data directory " << cold_dir;
+  }
+
   const auto intents_dir = this->intents_rocksdb_dir();
   if (fs_manager_->env()->FileExists(intents_dir)) {
     status = rocksdb::DestroyDB(intents_dir, rocksdb_options);
@@ -431,6 +444,12 @@ Status RaftGroupMetadata::DeleteTabletData(TabletDataState delete_type,
     LOG_IF(WARNING, !s.ok()) << "Unable to delete snapshots directory " << snapshots_dir;
   }
 
+  const auto bulk_load_dir = this->bulk_load_dir();
+  if (fs_manager_->env()->FileExists(bulk_load_dir)) {
+    auto s = fs_manager_->env()->DeleteRecursively(bulk_load_dir);
+    LOG_IF(WARNING, !s.ok()) << "Unable to delete bulk load directory " << bulk_load_dir;
+  }
+
   // Flushing will sync the new tablet_data_state_ to disk and will now also
   // delete all the data.
   RETURN_NOT_OK(Flush());
@@ -442,6 +461,16 @@ Status RaftGroupMetadata::DeleteTabletData(TabletDataState delete_type,
   return Flush();
 }
 
+std::string RaftGroupMetadata::cold_rocksdb_dir() const {
+  if (FLAGS_tablet_cold_data_path.empty()) {
+    return std::string();
+  }
+  // Mirror table-<id>/tablet-<id> layout of the tablet data directory.
+  const auto& rocksdb_dir = kv_store_.rocksdb_dir;
+  return JoinPathSegments(
+      FLAGS_tablet_cold_data_path, BaseName(DirName(rocksdb_dir)), BaseName(rocksdb_dir));
+}
+
 bool RaftGroupMetadata::IsTombstonedWithNoRocksDBData() const {
   std::lock_guard<MutexType> lock(data_mutex_);
   const auto& rocksdb_dir = kv_store_.rocksdb_dir;
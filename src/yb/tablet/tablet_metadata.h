@@ -68,6 +68,7 @@ extern const int64 kNoDurableMemStore;
 extern const std::string kIntentsSubdir;
 extern const std::string kIntentsDBSuffix;
 extern const std::string kSnapshotsDirSuffix;
+extern const std::string kBulkLoadDirSuffix;
 
   // Table info.
 struct TableInfo {
@@ -257,6 +258,12 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
   const std::string& rocksdb_dir() const { return kv_store_.rocksdb_dir; }
   std::string intents_rocksdb_dir() const { return kv_store_.rocksdb_dir + kIntentsDBSuffix; }
   std::string snapshots_dir() const { return kv_store_.rocksdb_dir + kSnapshotsDirSuffix; }
+  // Staging directory for SST files of bulk load batches, before they are added to the regular DB.
+  std::string bulk_load_dir() const { return kv_store_.rocksdb_dir + kBulkLoadDirSuffix; }
+
+  // Directory for SST files of the regular DB that contain only cold data.
+  // Empty when tablet_cold_data_path is not specified.
+  std::string cold_rocksdb_dir() const;
 
   const std::string& lower_bound_key() const { return kv_store_.lower_bound_key; }
   const std::string& upper_bound_key() const { return kv_store_.upper_bound_key; }
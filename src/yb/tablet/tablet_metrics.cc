@@ -130,6 +130,12 @@ METRIC_DEFINE_counter(tablet, tablet_data_corruptions,
   yb::MetricUnit::kUnits,
   "Number of times this tablet was flagged for corrupted data");
 
+METRIC_DEFINE_gauge_uint64(tablet, history_cutoff_lag_ms,
+  "History Cutoff Lag",
+  yb::MetricUnit::kMilliseconds,
+  "Difference between current time and history cutoff used by the last compaction. "
+  "Grows when long running reads hold back garbage collection of old versions.");
+
 using strings::Substitute;
 
 namespace yb {
@@ -152,7 +158,8 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& table_entity,
     MINIT(tablet_entity, consistent_prefix_read_requests),
     MINIT(tablet_entity, pgsql_consistent_prefix_read_rows),
     MINIT(tablet_entity, tablet_data_corruptions),
-    MINIT(tablet_entity, rows_inserted) {
+    MINIT(tablet_entity, rows_inserted),
+    history_cutoff_lag_ms(METRIC_history_cutoff_lag_ms.Instantiate(tablet_entity, 0)) {
 }
 #undef MINIT
 
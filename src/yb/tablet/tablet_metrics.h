@@ -72,6 +72,8 @@ struct TabletMetrics {
   scoped_refptr<Counter> tablet_data_corruptions;
 
   scoped_refptr<Counter> rows_inserted;
+
+  scoped_refptr<AtomicGauge<uint64_t>> history_cutoff_lag_ms;
 };
 
 class ScopedTabletMetricsTracker {
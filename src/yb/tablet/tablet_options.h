@@ -34,6 +34,7 @@ class Cache;
 class EventListener;
 class MemoryMonitor;
 class Env;
+class SecondaryBlockCache;
 }
 
 namespace yb {
@@ -43,6 +44,10 @@ class MemTracker;
 class MetricRegistry;
 class MetricEntity;
 
+namespace encryption {
+class UniverseKeyManager;
+}
+
 namespace tablet {
 
 YB_STRONGLY_TYPED_BOOL(IsDropTable);
@@ -50,11 +55,16 @@ YB_STRONGLY_TYPED_BOOL(IsDropTable);
 // Common for all tablets within TabletManager.
 struct TabletOptions {
   std::shared_ptr<rocksdb::Cache> block_cache;
+  std::shared_ptr<rocksdb::SecondaryBlockCache> secondary_block_cache;
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor;
   std::vector<std::shared_ptr<rocksdb::EventListener>> listeners;
   yb::Env* env = Env::Default();
   rocksdb::Env* rocksdb_env = rocksdb::Env::Default();
+  // Tells whether encryption at rest is enabled, could be null.
+  encryption::UniverseKeyManager* universe_key_manager = nullptr;
   std::shared_ptr<rocksdb::RateLimiter> rate_limiter;
+  // Adjusts rate of the shared rate_limiter based on foreground latency, could be null.
+  std::shared_ptr<CompactionRateController> compaction_rate_controller;
   scoped_refptr<MetricEntity> ServerMetricEntity;
 };
 
@@ -264,6 +264,7 @@ Status TabletPeer::InitTabletPeer(
 
     if (retryable_requests) {
       retryable_requests->SetMetricEntity(tablet->GetTabletMetricsEntity());
+      retryable_requests->SetMemTracker(tablet->mem_tracker());
     }
 
     consensus_ = RaftConsensus::Create(
@@ -1081,6 +1082,10 @@ bool TabletPeer::ShouldApplyWrite() {
   return tablet_->ShouldApplyWrite();
 }
 
+void TabletPeer::PreApplyWrites(const std::vector<const consensus::ReplicateMsg*>& replicate_msgs) {
+  tablet_->PreApplyWrites(replicate_msgs);
+}
+
 consensus::Consensus* TabletPeer::consensus() const {
   return raft_consensus();
 }
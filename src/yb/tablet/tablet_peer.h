@@ -228,6 +228,8 @@ class TabletPeer : public consensus::ConsensusContext,
   // Returns false if it is preferable to don't apply write operation.
   bool ShouldApplyWrite() override;
 
+  void PreApplyWrites(const std::vector<const consensus::ReplicateMsg*>& replicate_msgs) override;
+
   consensus::Consensus* consensus() const;
   consensus::RaftConsensus* raft_consensus() const;
 
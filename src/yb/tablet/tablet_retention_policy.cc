@@ -40,6 +40,7 @@
 
 #include "yb/util/enums.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 #include "yb/util/strongly_typed_bool.h"
 
 using namespace std::literals;
@@ -62,6 +63,15 @@ namespace tablet {
 using docdb::TableTTL;
 using docdb::HistoryRetentionDirective;
 
+namespace {
+
+size_t ReaderSlotIndex(uint64_t timestamp, size_t num_slots) {
+  // Spread close timestamps, that differ only in low bits, across slots.
+  return ((timestamp * 0x9E3779B97F4A7C15ULL) >> 32) % num_slots;
+}
+
+} // namespace
+
 TabletRetentionPolicy::TabletRetentionPolicy(
     server::ClockPtr clock, const AllowedHistoryCutoffProvider& allowed_history_cutoff_provider,
     RaftGroupMetadata* metadata)
@@ -71,14 +81,16 @@ TabletRetentionPolicy::TabletRetentionPolicy(
 
 HybridTime TabletRetentionPolicy::UpdateCommittedHistoryCutoff(HybridTime value) {
   std::lock_guard<std::mutex> lock(mutex_);
+  auto committed_history_cutoff = committed_history_cutoff_.load();
   if (!value) {
-    return committed_history_cutoff_;
+    return committed_history_cutoff;
   }
 
   VLOG_WITH_PREFIX(4) << __func__ << "(" << value << ")";
 
-  committed_history_cutoff_ = std::max(committed_history_cutoff_, value);
-  return committed_history_cutoff_;
+  committed_history_cutoff = std::max(committed_history_cutoff, value);
+  committed_history_cutoff_.store(committed_history_cutoff);
+  return committed_history_cutoff;
 }
 
 HistoryRetentionDirective TabletRetentionPolicy::GetRetentionDirective() {
@@ -86,13 +98,22 @@ HistoryRetentionDirective TabletRetentionPolicy::GetRetentionDirective() {
   {
     std::lock_guard<std::mutex> lock(mutex_);
     if (FLAGS_enable_history_cutoff_propagation) {
-      history_cutoff = SanitizeHistoryCutoff(committed_history_cutoff_);
+      history_cutoff = SanitizeHistoryCutoff(committed_history_cutoff_.load());
     } else {
       history_cutoff = EffectiveHistoryCutoff();
-      committed_history_cutoff_ = std::max(history_cutoff, committed_history_cutoff_);
+      committed_history_cutoff_.store(std::max(history_cutoff, committed_history_cutoff_.load()));
+      // Reader could register concurrently with EffectiveHistoryCutoff, and check its timestamp
+      // against the old committed history cutoff. Such reader is visible after the store above,
+      // since readers are published before they load committed history cutoff.
+      history_cutoff = std::min(history_cutoff, MinActiveReaderTimestamp());
     }
   }
 
+  if (history_cutoff_lag_ms_) {
+    history_cutoff_lag_ms_->set_value(
+        std::max<int64_t>(clock_->Now().PhysicalDiff(history_cutoff), 0) / 1000);
+  }
+
   auto deleted_before_history_cutoff = std::make_shared<docdb::ColumnIds>();
   for (const auto& deleted_col : *metadata_.deleted_cols()) {
     if (deleted_col.ht < history_cutoff) {
@@ -106,25 +127,84 @@ HistoryRetentionDirective TabletRetentionPolicy::GetRetentionDirective() {
               ShouldRetainDeleteMarkersInMajorCompaction())};
 }
 
+namespace {
+
+Status SnapshotTooOld(HybridTime timestamp, HybridTime committed_history_cutoff) {
+  return STATUS(
+      SnapshotTooOld,
+      Format(
+          "Snapshot too old. Read point: $0, earliest read time allowed: $1, delta (usec): $2",
+          timestamp,
+          committed_history_cutoff,
+          committed_history_cutoff.PhysicalDiff(timestamp)),
+      TransactionError(TransactionErrorCode::kSnapshotTooOld));
+}
+
+} // namespace
+
 Status TabletRetentionPolicy::RegisterReaderTimestamp(HybridTime timestamp) {
+  const auto value = timestamp.ToUint64();
+  const auto start = ReaderSlotIndex(value, kNumReaderSlots);
+  for (size_t i = 0; i != kNumReaderSlots; ++i) {
+    auto& slot = reader_slots_[(start + i) % kNumReaderSlots].timestamp;
+    uint64_t expected = kInvalidHybridTimeValue;
+    if (slot.load(std::memory_order_relaxed) != kInvalidHybridTimeValue ||
+        !slot.compare_exchange_strong(expected, value)) {
+      continue;
+    }
+    // Reader is published before loading committed history cutoff, while history cutoff is
+    // published before the final scan of readers. So either we see the updated cutoff here,
+    // or history cutoff calculation sees this reader.
+    const auto committed_history_cutoff = committed_history_cutoff_.load();
+    if (timestamp < committed_history_cutoff) {
+      UnregisterReaderTimestamp(timestamp);
+      return SnapshotTooOld(timestamp, committed_history_cutoff);
+    }
+    return Status::OK();
+  }
+
   std::lock_guard<std::mutex> lock(mutex_);
-  if (timestamp < committed_history_cutoff_) {
-    return STATUS(
-        SnapshotTooOld,
-        Format(
-            "Snapshot too old. Read point: $0, earliest read time allowed: $1, delta (usec): $2",
-            timestamp,
-            committed_history_cutoff_,
-            committed_history_cutoff_.PhysicalDiff(timestamp)),
-        TransactionError(TransactionErrorCode::kSnapshotTooOld));
+  const auto committed_history_cutoff = committed_history_cutoff_.load();
+  if (timestamp < committed_history_cutoff) {
+    return SnapshotTooOld(timestamp, committed_history_cutoff);
   }
-  active_readers_.insert(timestamp);
+  overflow_readers_.insert(timestamp);
   return Status::OK();
 }
 
 void TabletRetentionPolicy::UnregisterReaderTimestamp(HybridTime timestamp) {
+  const auto value = timestamp.ToUint64();
+  const auto start = ReaderSlotIndex(value, kNumReaderSlots);
+  for (size_t i = 0; i != kNumReaderSlots; ++i) {
+    auto& slot = reader_slots_[(start + i) % kNumReaderSlots].timestamp;
+    uint64_t expected = value;
+    if (slot.load(std::memory_order_relaxed) == value &&
+        slot.compare_exchange_strong(expected, kInvalidHybridTimeValue)) {
+      return;
+    }
+  }
+
   std::lock_guard<std::mutex> lock(mutex_);
-  active_readers_.erase(timestamp);
+  auto it = overflow_readers_.find(timestamp);
+  if (it != overflow_readers_.end()) {
+    overflow_readers_.erase(it);
+  }
+}
+
+HybridTime TabletRetentionPolicy::MinActiveReaderTimestamp() {
+  auto result = overflow_readers_.empty() ? HybridTime::kMax : *overflow_readers_.begin();
+  for (const auto& slot : reader_slots_) {
+    const auto value = slot.timestamp.load();
+    if (value != kInvalidHybridTimeValue) {
+      result = std::min(result, HybridTime(value));
+    }
+  }
+  return result;
+}
+
+void TabletRetentionPolicy::SetHistoryCutoffLagGauge(
+    scoped_refptr<AtomicGauge<uint64_t>> gauge) {
+  history_cutoff_lag_ms_ = std::move(gauge);
 }
 
 bool TabletRetentionPolicy::ShouldRetainDeleteMarkersInMajorCompaction() const {
@@ -142,7 +222,7 @@ HybridTime TabletRetentionPolicy::HistoryCutoffToPropagate(HybridTime last_write
                       << MonoDelta(next_history_cutoff_propagation_ - now);
 
   if (disable_counter_ != 0 || !FLAGS_enable_history_cutoff_propagation ||
-      now < next_history_cutoff_propagation_ || last_write_ht <= committed_history_cutoff_) {
+      now < next_history_cutoff_propagation_ || last_write_ht <= committed_history_cutoff_.load()) {
     return HybridTime();
   }
 
@@ -162,14 +242,9 @@ HybridTime TabletRetentionPolicy::EffectiveHistoryCutoff() {
 }
 
 HybridTime TabletRetentionPolicy::SanitizeHistoryCutoff(HybridTime proposed_cutoff) {
-  HybridTime allowed_cutoff;
-  if (active_readers_.empty()) {
-    // There are no readers restricting our garbage collection of old records.
-    allowed_cutoff = proposed_cutoff;
-  } else {
-    // Cannot garbage-collect any records that are still being read.
-    allowed_cutoff = std::min(proposed_cutoff, *active_readers_.begin());
-  }
+  // Cannot garbage-collect any records that are still being read.
+  const auto min_reader_timestamp = MinActiveReaderTimestamp();
+  HybridTime allowed_cutoff = std::min(proposed_cutoff, min_reader_timestamp);
 
   HybridTime provided_allowed_cutoff;
   if (allowed_history_cutoff_provider_) {
@@ -178,7 +253,7 @@ HybridTime TabletRetentionPolicy::SanitizeHistoryCutoff(HybridTime proposed_cuto
   }
 
   VLOG_WITH_PREFIX(4) << __func__ << ", result: " << allowed_cutoff
-                      << ", active readers: " << active_readers_.size()
+                      << ", min active reader: " << min_reader_timestamp
                       << ", provided_allowed_cutoff: " << provided_allowed_cutoff
                       << ", schedules: " << AsString(metadata_.SnapshotSchedules());
 
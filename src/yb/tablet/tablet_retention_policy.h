@@ -14,12 +14,21 @@
 #ifndef YB_TABLET_TABLET_RETENTION_POLICY_H_
 #define YB_TABLET_TABLET_RETENTION_POLICY_H_
 
+#include <atomic>
+
 #include "yb/docdb/docdb_compaction_filter.h"
+
+#include "yb/gutil/port.h"
+
 #include "yb/server/clock.h"
 
 #include "yb/tablet/tablet_fwd.h"
 
 namespace yb {
+
+template<class T>
+class AtomicGauge;
+
 namespace tablet {
 
 using AllowedHistoryCutoffProvider = std::function<HybridTime(RaftGroupMetadata*)>;
@@ -47,15 +56,29 @@ class TabletRetentionPolicy : public docdb::HistoryRetentionPolicy {
 
   // Register/Unregister a read operation, with an associated timestamp, for the purpose of
   // tracking the oldest read point.
+  // Both are lock-free in the common case, see reader_slots_.
   CHECKED_STATUS RegisterReaderTimestamp(HybridTime timestamp);
   void UnregisterReaderTimestamp(HybridTime timestamp);
 
   void EnableHistoryCutoffPropagation(bool value);
 
+  // Gauge that is updated with the difference between current time and history cutoff, each time
+  // history cutoff is calculated for compaction.
+  void SetHistoryCutoffLagGauge(scoped_refptr<AtomicGauge<uint64_t>> gauge);
+
  private:
+  static constexpr size_t kNumReaderSlots = 32;
+
+  struct CACHELINE_ALIGNED ReaderSlot {
+    std::atomic<uint64_t> timestamp{kInvalidHybridTimeValue};
+  };
+
   bool ShouldRetainDeleteMarkersInMajorCompaction() const;
   HybridTime EffectiveHistoryCutoff() REQUIRES(mutex_);
 
+  // Returns min timestamp of active readers, or HybridTime::kMax when there are no readers.
+  HybridTime MinActiveReaderTimestamp() REQUIRES(mutex_);
+
   // Check proposed history cutoff against other restrictions (for instance min reading timestamp),
   // and returns most close value that satisfies them.
   HybridTime SanitizeHistoryCutoff(HybridTime proposed_history_cutoff) REQUIRES(mutex_);
@@ -69,10 +92,18 @@ class TabletRetentionPolicy : public docdb::HistoryRetentionPolicy {
   RaftGroupMetadata& metadata_;
   const std::string log_prefix_;
 
+  // Active read timestamps. Reader occupies a free slot, starting the search from a slot
+  // determined by its timestamp. Readers with equal timestamps are interchangeable, so unregister
+  // could free any slot holding the same timestamp.
+  // The min-reduction over slots is done only when history cutoff is calculated.
+  ReaderSlot reader_slots_[kNumReaderSlots];
+
   mutable std::mutex mutex_;
-  // Set of active read timestamps.
-  std::multiset<HybridTime> active_readers_ GUARDED_BY(mutex_);
-  HybridTime committed_history_cutoff_ GUARDED_BY(mutex_) = HybridTime::kMin;
+  // Active read timestamps that did not fit into reader_slots_.
+  std::multiset<HybridTime> overflow_readers_ GUARDED_BY(mutex_);
+  // Modified only under mutex_, but read lock-free by RegisterReaderTimestamp.
+  std::atomic<HybridTime> committed_history_cutoff_{HybridTime::kMin};
+  scoped_refptr<AtomicGauge<uint64_t>> history_cutoff_lag_ms_;
   CoarseTimePoint next_history_cutoff_propagation_ GUARDED_BY(mutex_) = CoarseTimePoint::min();
   int disable_counter_ GUARDED_BY(mutex_) = 0;
 };
@@ -99,6 +99,16 @@ METRIC_DEFINE_simple_counter(
 METRIC_DEFINE_simple_gauge_uint64(
     tablet, transactions_running, "Total number of transactions running in participant",
     yb::MetricUnit::kTransactions);
+METRIC_DEFINE_simple_gauge_uint64(
+    tablet, transactions_applying, "Number of large transactions whose intents are being applied",
+    yb::MetricUnit::kTransactions);
+METRIC_DEFINE_simple_counter(
+    tablet, apply_intents_steps, "Total number of intents apply steps of large transactions",
+    yb::MetricUnit::kOperations);
+METRIC_DEFINE_simple_counter(
+    tablet, apply_intents_yields,
+    "Total number of times intents apply of a large transaction yielded to other tasks",
+    yb::MetricUnit::kOperations);
 
 DEFINE_test_flag(int32, txn_participant_inject_latency_on_apply_update_txn_ms, 0,
                  "How much latency to inject when a update txn operation is applied.");
@@ -129,6 +139,10 @@ class TransactionParticipant::Impl
     LOG_WITH_PREFIX(INFO) << "Create";
     metric_transactions_running_ = METRIC_transactions_running.Instantiate(entity, 0);
     metric_transaction_not_found_ = METRIC_transaction_not_found.Instantiate(entity);
+    apply_intents_metrics_.transactions_applying =
+        METRIC_transactions_applying.Instantiate(entity, 0);
+    apply_intents_metrics_.steps = METRIC_apply_intents_steps.Instantiate(entity);
+    apply_intents_metrics_.yields = METRIC_apply_intents_yields.Instantiate(entity);
   }
 
   ~Impl() {
@@ -1658,6 +1672,11 @@ Status TransactionParticipant::ResolveIntents(HybridTime resolve_at, CoarseTimeP
   return impl_->ResolveIntents(resolve_at, deadline);
 }
 
+std::vector<std::pair<TransactionId, size_t>> TransactionParticipant::TEST_ApplyIntentsEvents()
+    const {
+  return impl_->TEST_ApplyIntentsEvents();
+}
+
 size_t TransactionParticipant::TEST_GetNumRunningTransactions() const {
   return impl_->TEST_GetNumRunningTransactions();
 }
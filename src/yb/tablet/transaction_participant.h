@@ -209,6 +209,11 @@ class TransactionParticipant : public TransactionStatusManager {
 
   OneWayBitmap TEST_TransactionReplicatedBatches(const TransactionId& id) const;
 
+  // Returns large transaction apply events recorded when FLAGS_TEST_record_apply_intents_events
+  // is set. Each event is transaction id with the number of apply steps performed, 0 when apply
+  // task is enqueued.
+  std::vector<std::pair<TransactionId, size_t>> TEST_ApplyIntentsEvents() const;
+
  private:
   int64_t RegisterRequest() override;
   void UnregisterRequest(int64_t request) override;
@@ -370,6 +370,16 @@ Result<bool> WriteQuery::PgsqlPrepareExecute() {
     return false;
   }
 
+  if (!request().write_batch().has_transaction() &&
+      std::all_of(pgsql_write_batch.begin(), pgsql_write_batch.end(),
+                  [](const auto& req) { return req.is_bulk_load(); })) {
+    request().mutable_write_batch()->set_bulk_load(true);
+    if (std::all_of(pgsql_write_batch.begin(), pgsql_write_batch.end(),
+                    [](const auto& req) { return req.is_backfill(); })) {
+      request().mutable_write_batch()->set_bulk_load_allow_overlap(true);
+    }
+  }
+
   return true;
 }
 
@@ -35,6 +35,7 @@
 #include "yb/rpc/scheduler.h"
 
 #include "yb/tserver/pg_client_session.h"
+#include "yb/tserver/pg_table_cache.h"
 
 #include "yb/util/net/net_util.h"
 #include "yb/util/result.h"
@@ -117,6 +118,7 @@ class PgClientServiceImpl::Impl {
       rpc::Scheduler* scheduler)
       : client_future_(client_future),
         transaction_pool_provider_(std::move(transaction_pool_provider)),
+        table_cache_(client_future),
         check_expired_sessions_(scheduler) {
     ScheduleCheckExpiredSessions(CoarseMonoClock::now());
   }
@@ -136,25 +138,13 @@ class PgClientServiceImpl::Impl {
     resp->set_session_id(session_id);
     sessions_.emplace(
         FLAGS_pg_client_session_expiration_ms * 1ms,
-        std::make_shared<PgClientSession>(&client(), session_id));
+        std::make_shared<PgClientSession>(&client(), &table_cache_, session_id));
     return Status::OK();
   }
 
   CHECKED_STATUS OpenTable(
       const PgOpenTableRequestPB& req, PgOpenTableResponsePB* resp, rpc::RpcContext* context) {
-    client::YBTablePtr table;
-    RETURN_NOT_OK(client().OpenTable(req.table_id(), &table, resp->mutable_info()));
-    RSTATUS_DCHECK(
-        table->table_type() == client::YBTableType::PGSQL_TABLE_TYPE, RuntimeError,
-        "Wrong table type");
-
-    auto partitions = table->GetVersionedPartitions();
-    resp->mutable_partitions()->set_version(partitions->version);
-    for (const auto& key : partitions->keys) {
-      *resp->mutable_partitions()->mutable_keys()->Add() = key;
-    }
-
-    return Status::OK();
+    return table_cache_.Get(req.table_id(), req.ysql_catalog_version(), req.reload(), resp);
   }
 
   CHECKED_STATUS GetDatabaseInfo(
@@ -355,11 +345,13 @@ class PgClientServiceImpl::Impl {
     while (!sessions_.empty() && index.begin()->expiration() < now) {
       index.erase(index.begin());
     }
+    table_cache_.CleanupExpired();
     ScheduleCheckExpiredSessions(now);
   }
 
   std::shared_future<client::YBClient*> client_future_;
   TransactionPoolProvider transaction_pool_provider_;
+  PgTableCache table_cache_;
   std::mutex mutex_;
 
   class ExpirationTag;
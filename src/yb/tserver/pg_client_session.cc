@@ -23,6 +23,7 @@
 
 #include "yb/tserver/pg_client.pb.h"
 #include "yb/tserver/pg_create_table.h"
+#include "yb/tserver/pg_table_cache.h"
 
 #include "yb/util/result.h"
 #include "yb/util/status_format.h"
@@ -30,8 +31,9 @@
 namespace yb {
 namespace tserver {
 
-PgClientSession::PgClientSession(client::YBClient* client, uint64_t id)
-    : client_(*client), id_(id) {
+PgClientSession::PgClientSession(
+    client::YBClient* client, PgTableCache* table_cache, uint64_t id)
+    : client_(*client), table_cache_(*table_cache), id_(id) {
 }
 
 uint64_t PgClientSession::id() const {
@@ -42,9 +44,14 @@ Status PgClientSession::CreateTable(
     const PgCreateTableRequestPB& req, PgCreateTableResponsePB* resp, rpc::RpcContext* context) {
   PgCreateTable helper(req);
   RETURN_NOT_OK(helper.Prepare());
-  return helper.Exec(
+  auto status = helper.Exec(
       &client(), VERIFY_RESULT(GetDdlTransactionMetadata(req.use_transaction())),
       context->GetClientDeadline());
+  if (req.has_base_table_id()) {
+    // Info of the indexed table contains the list of its indexes.
+    table_cache_.Invalidate(PgObjectId::FromPB(req.base_table_id()).GetYBTableId());
+  }
+  return status;
 }
 
 Status PgClientSession::CreateDatabase(
@@ -75,11 +82,15 @@ Status PgClientSession::DropDatabase(
 Status PgClientSession::DropTable(
     const PgDropTableRequestPB& req, PgDropTableResponsePB* resp, rpc::RpcContext* context) {
   auto yb_table_id = PgObjectId::FromPB(req.table_id()).GetYBTableId();
+  table_cache_.Invalidate(yb_table_id);
   if (req.index()) {
     client::YBTableName indexed_table;
     RETURN_NOT_OK(client().DeleteIndexTable(
         yb_table_id, &indexed_table, true, context->GetClientDeadline()));
     indexed_table.SetIntoTableIdentifierPB(resp->mutable_indexed_table());
+    if (indexed_table.has_table_id()) {
+      table_cache_.Invalidate(indexed_table.table_id());
+    }
     return Status::OK();
   }
 
@@ -98,7 +109,8 @@ Status PgClientSession::AlterDatabase(
 
 Status PgClientSession::AlterTable(
     const PgAlterTableRequestPB& req, PgAlterTableResponsePB* resp, rpc::RpcContext* context) {
-  auto alterer = client().NewTableAlterer(PgObjectId::FromPB(req.table_id()).GetYBTableId());
+  auto yb_table_id = PgObjectId::FromPB(req.table_id()).GetYBTableId();
+  auto alterer = client().NewTableAlterer(yb_table_id);
   auto txn = VERIFY_RESULT(GetDdlTransactionMetadata(req.use_transaction()));
   if (txn) {
     alterer->part_of_transaction(txn);
@@ -121,7 +133,9 @@ Status PgClientSession::AlterTable(
   }
 
   alterer->timeout(context->GetClientDeadline() - CoarseMonoClock::now());
-  return alterer->Alter();
+  auto status = alterer->Alter();
+  table_cache_.Invalidate(yb_table_id);
+  return status;
 }
 
 Status PgClientSession::TruncateTable(
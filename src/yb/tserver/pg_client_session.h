@@ -46,7 +46,7 @@ namespace tserver {
 
 class PgClientSession {
  public:
-  PgClientSession(client::YBClient* client, uint64_t id);
+  PgClientSession(client::YBClient* client, PgTableCache* table_cache, uint64_t id);
 
   uint64_t id() const;
 
@@ -67,6 +67,7 @@ class PgClientSession {
   client::YBClient& client();
 
   client::YBClient& client_;
+  PgTableCache& table_cache_;
   const uint64_t id_;
 
   std::mutex mutex_;
@@ -0,0 +1,176 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/pg_table_cache.h"
+
+#include <mutex>
+#include <unordered_map>
+
+#include "yb/client/client.h"
+#include "yb/client/table.h"
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/tserver/pg_client.pb.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/monotime.h"
+#include "yb/util/result.h"
+#include "yb/util/status_format.h"
+
+using namespace std::literals;
+
+DEFINE_uint64(pg_client_table_cache_expiration_ms, 300000,
+              "Table info shared by YSQL sessions of the tablet server is reloaded from the master "
+              "after being cached for this number of milliseconds. 0 disables the cache.");
+TAG_FLAG(pg_client_table_cache_expiration_ms, runtime);
+TAG_FLAG(pg_client_table_cache_expiration_ms, advanced);
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+using CachedTableInfo = std::shared_ptr<const PgOpenTableResponsePB>;
+
+Status LoadTable(client::YBClient* client, const TableId& table_id, PgOpenTableResponsePB* resp) {
+  client::YBTablePtr table;
+  RETURN_NOT_OK(client->OpenTable(table_id, &table, resp->mutable_info()));
+  RSTATUS_DCHECK(
+      table->table_type() == client::YBTableType::PGSQL_TABLE_TYPE, RuntimeError,
+      "Wrong table type");
+
+  auto partitions = table->GetVersionedPartitions();
+  resp->mutable_partitions()->set_version(partitions->version);
+  for (const auto& key : partitions->keys) {
+    *resp->mutable_partitions()->mutable_keys()->Add() = key;
+  }
+
+  return Status::OK();
+}
+
+} // namespace
+
+class PgTableCache::Impl {
+ public:
+  explicit Impl(const std::shared_future<client::YBClient*>& client_future)
+      : client_future_(client_future) {}
+
+  CHECKED_STATUS Get(
+      const TableId& table_id, uint64_t catalog_version, bool reload,
+      PgOpenTableResponsePB* resp) {
+    const auto lifetime = FLAGS_pg_client_table_cache_expiration_ms * 1ms;
+    if (lifetime == CoarseDuration::zero()) {
+      return LoadTable(&client(), table_id, resp);
+    }
+
+    std::promise<Result<CachedTableInfo>> promise;
+    std::shared_future<Result<CachedTableInfo>> future;
+    uint64_t load_serial_no = 0;
+    {
+      const auto now = CoarseMonoClock::now();
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = entries_.find(table_id);
+      if (it == entries_.end() || reload || it->second.catalog_version < catalog_version ||
+          it->second.expiration < now) {
+        future = promise.get_future().share();
+        load_serial_no = ++load_serial_no_;
+        auto& entry = entries_[table_id];
+        entry.catalog_version = std::max(entry.catalog_version, catalog_version);
+        entry.expiration = now + lifetime;
+        entry.load_serial_no = load_serial_no;
+        entry.info = future;
+      } else {
+        future = it->second.info;
+      }
+    }
+
+    if (load_serial_no) {
+      auto info = std::make_shared<PgOpenTableResponsePB>();
+      auto status = LoadTable(&client(), table_id, info.get());
+      if (!status.ok()) {
+        // Do not cache failures, next request should retry the load.
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(table_id);
+        if (it != entries_.end() && it->second.load_serial_no == load_serial_no) {
+          entries_.erase(it);
+        }
+        promise.set_value(status);
+      } else {
+        promise.set_value(CachedTableInfo(std::move(info)));
+      }
+    }
+
+    const auto& info = future.get();
+    RETURN_NOT_OK(info);
+    resp->mutable_info()->CopyFrom((**info).info());
+    resp->mutable_partitions()->CopyFrom((**info).partitions());
+    return Status::OK();
+  }
+
+  void Invalidate(const TableId& table_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.erase(table_id);
+  }
+
+  void CleanupExpired() {
+    const auto now = CoarseMonoClock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->second.expiration < now) {
+        it = entries_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+ private:
+  client::YBClient& client() { return *client_future_.get(); }
+
+  struct Entry {
+    // Catalog version that was requested when info was loaded.
+    uint64_t catalog_version = 0;
+    CoarseTimePoint expiration;
+    // Distinguishes concurrent loads of the same table, so failed load does not remove entry
+    // of the load that replaced it.
+    uint64_t load_serial_no = 0;
+    std::shared_future<Result<CachedTableInfo>> info;
+  };
+
+  std::shared_future<client::YBClient*> client_future_;
+  std::mutex mutex_;
+  std::unordered_map<TableId, Entry> entries_ GUARDED_BY(mutex_);
+  uint64_t load_serial_no_ GUARDED_BY(mutex_) = 0;
+};
+
+PgTableCache::PgTableCache(const std::shared_future<client::YBClient*>& client_future)
+    : impl_(new Impl(client_future)) {}
+
+PgTableCache::~PgTableCache() {}
+
+Status PgTableCache::Get(
+    const TableId& table_id, uint64_t catalog_version, bool reload, PgOpenTableResponsePB* resp) {
+  return impl_->Get(table_id, catalog_version, reload, resp);
+}
+
+void PgTableCache::Invalidate(const TableId& table_id) {
+  impl_->Invalidate(table_id);
+}
+
+void PgTableCache::CleanupExpired() {
+  impl_->CleanupExpired();
+}
+
+}  // namespace tserver
+}  // namespace yb
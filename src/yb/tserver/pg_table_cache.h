@@ -0,0 +1,64 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TSERVER_PG_TABLE_CACHE_H
+#define YB_TSERVER_PG_TABLE_CACHE_H
+
+#include <future>
+#include <memory>
+
+#include "yb/client/client_fwd.h"
+
+#include "yb/common/entity_ids.h"
+
+#include "yb/tserver/pg_client.fwd.h"
+
+#include "yb/util/status.h"
+
+namespace yb {
+namespace tserver {
+
+// Table info (schema and partitions) shared by all YSQL sessions of the tablet server, so
+// connections opening the same relations do not load them from the master one by one.
+//
+// Each entry remembers the YSQL catalog version it was loaded for. A request with a newer catalog
+// version reloads the entry, so the cache never returns info older than what the caller has
+// already observed. DDLs that go through this tablet server invalidate affected relations
+// directly.
+class PgTableCache {
+ public:
+  explicit PgTableCache(const std::shared_future<client::YBClient*>& client_future);
+  ~PgTableCache();
+
+  // Fills resp with info of the specified table. Info is loaded from the master when it is not
+  // cached, was cached for an older catalog version or reload is requested.
+  // Concurrent requests for the same table wait for a single load.
+  CHECKED_STATUS Get(
+      const TableId& table_id, uint64_t catalog_version, bool reload,
+      PgOpenTableResponsePB* resp);
+
+  void Invalidate(const TableId& table_id);
+
+  // Removes entries that were not used for too long, e.g. entries of dropped tables.
+  void CleanupExpired();
+
+ private:
+  class Impl;
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace tserver
+}  // namespace yb
+
+#endif  // YB_TSERVER_PG_TABLE_CACHE_H
@@ -137,7 +137,16 @@ Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer) {
     typedef consensus::LeaderStatus LeaderStatus;
     auto status = leader_state.CreateStatus();
     switch (leader_state.status) {
-      case LeaderStatus::NOT_LEADER: FALLTHROUGH_INTENDED;
+      case LeaderStatus::NOT_LEADER: {
+        // Let the client know who we think is the leader, so it could retry without looking up
+        // tablet locations on master.
+        auto leader_uuid = consensus->ConsensusState(
+            consensus::CONSENSUS_CONFIG_ACTIVE).leader_uuid();
+        if (!leader_uuid.empty() && leader_uuid != tablet_peer.permanent_uuid()) {
+          status = status.CloneAndAddErrorCode(TabletServerLeaderHint({std::move(leader_uuid)}));
+        }
+        return status.CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::NOT_THE_LEADER));
+      }
       case LeaderStatus::LEADER_BUT_NO_MAJORITY_REPLICATED_LEASE:
         // We are returning a NotTheLeader as opposed to LeaderNotReady, because there is a chance
         // that we're a partitioned-away leader, and the client needs to do another leader lookup.
@@ -13,16 +13,21 @@
 
 #include "yb/tserver/tablet_memory_manager.h"
 
+#include "yb/consensus/log.h"
 #include "yb/consensus/log_cache.h"
 #include "yb/consensus/raft_consensus.h"
 
+#include "yb/encryption/universe_key_manager.h"
+
 #include "yb/gutil/casts.h"
 #include "yb/gutil/strings/human_readable.h"
 
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/memory_monitor.h"
+#include "yb/rocksdb/secondary_block_cache.h"
 
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_bootstrap_if.h"
 #include "yb/tablet/tablet_options.h"
 #include "yb/tablet/tablet_peer.h"
 
@@ -30,10 +35,12 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/mem_tracker.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status_log.h"
 
 using namespace std::literals;
 using namespace std::placeholders;
+using namespace yb::size_literals;
 
 DEFINE_bool(enable_log_cache_gc, true,
             "Set to true to enable log cache garbage collector.");
@@ -76,9 +83,63 @@ DEFINE_int32(db_block_cache_num_shard_bits, 4,
              "Number of bits to use for sharding the block cache (defaults to 4 bits)");
 TAG_FLAG(db_block_cache_num_shard_bits, advanced);
 
+DEFINE_bool(db_block_cache_use_clock, false,
+            "Use CLOCK eviction policy for the RocksDB block cache instead of LRU. Clock cache "
+            "lookups do not serialize on the cache shard mutex.");
+TAG_FLAG(db_block_cache_use_clock, advanced);
+
+DEFINE_string(db_secondary_block_cache_path, "",
+              "Directory on a local fast disk for the secondary RocksDB block cache. Data blocks "
+              "evicted from the in-memory block cache are written there and read back instead of "
+              "reading them from the data volume. Blocks are stored decrypted, so the cache is not "
+              "used while encryption at rest is enabled. Empty value disables secondary block "
+              "cache.");
+TAG_FLAG(db_secondary_block_cache_path, advanced);
+
+DEFINE_int64(db_secondary_block_cache_size_bytes, 0,
+             "Capacity of the secondary RocksDB block cache (in bytes).");
+TAG_FLAG(db_secondary_block_cache_size_bytes, advanced);
+
 DEFINE_test_flag(bool, pretend_memory_exceeded_enforce_flush, false,
                   "Always pretend memory has been exceeded to enforce background flush.");
 
+DEFINE_bool(enable_memstore_flush_scoring, true,
+            "When the global memstore limit is reached, pick memtables to flush by the memory "
+            "they hold, the WAL they retain and the write rate of the tablet. Otherwise the single "
+            "tablet with the oldest memtable write is flushed.");
+TAG_FLAG(enable_memstore_flush_scoring, runtime);
+TAG_FLAG(enable_memstore_flush_scoring, advanced);
+
+DEFINE_int32(memstore_flush_max_parallel_tablets, 4,
+             "Max number of tablets to start flush for in a single round of global memstore limit "
+             "enforcement, not counting tablets with small idle memtables.");
+TAG_FLAG(memstore_flush_max_parallel_tablets, runtime);
+TAG_FLAG(memstore_flush_max_parallel_tablets, advanced);
+
+DEFINE_double(memstore_flush_wal_retention_weight, 0.25,
+              "Weight of the WAL bytes retained by the tablet, relative to the memtable bytes, in "
+              "the score of the memtable to flush.");
+TAG_FLAG(memstore_flush_wal_retention_weight, runtime);
+TAG_FLAG(memstore_flush_wal_retention_weight, advanced);
+
+DEFINE_int64(memstore_flush_small_memtable_bytes, 1_MB,
+             "Memtables smaller than this, that are being filled for at least "
+             "memstore_flush_small_memtable_min_age_sec, are flushed together with the best scored "
+             "memtables, so idle tablets do not retain WAL forever.");
+TAG_FLAG(memstore_flush_small_memtable_bytes, runtime);
+TAG_FLAG(memstore_flush_small_memtable_bytes, advanced);
+
+DEFINE_int32(memstore_flush_small_memtable_min_age_sec, 60,
+             "See memstore_flush_small_memtable_bytes.");
+TAG_FLAG(memstore_flush_small_memtable_min_age_sec, runtime);
+TAG_FLAG(memstore_flush_small_memtable_min_age_sec, advanced);
+
+DEFINE_int32(memstore_flush_max_small_memtables_per_round, 32,
+             "Max number of tablets with small idle memtables to flush in a single round of global "
+             "memstore limit enforcement.");
+TAG_FLAG(memstore_flush_max_small_memtables_per_round, runtime);
+TAG_FLAG(memstore_flush_max_small_memtables_per_round, advanced);
+
 namespace yb {
 namespace tserver {
 
@@ -86,6 +147,28 @@ using strings::Substitute;
 
 namespace {
 
+// Memtable that is written at this rate (bytes per second), gets half of the score that it would
+// get if it was idle. Memory of a memtable that is written quickly is taken back soon after flush.
+constexpr double kMemtableWriteRateHalfScore = 1_MB;
+
+// Only this number of largest memtables per tablet that could be flushed in parallel, are scored
+// by the WAL they retain, since it requires walking WAL segments of the tablet.
+constexpr size_t kWalScoredCandidatesPerFlushedTablet = 8;
+
+// Returns the number of WAL bytes retained because of the memtable, i.e. WAL starting from the
+// first operation that was not persisted by the DB.
+uint64_t WalBytesRetainedAfter(log::Log* log, const OpId& persistent_op_id) {
+  const uint64_t total_bytes = log->OnDiskSize();
+  // The memtable does not anchor segments that contain only persisted operations.
+  int64_t gcable_bytes = 0;
+  auto status = log->GetGCableDataSize(std::max<int64_t>(persistent_op_id.index + 1, 0),
+                                       &gcable_bytes);
+  if (!status.ok()) {
+    return total_bytes;
+  }
+  return total_bytes - std::min<uint64_t>(gcable_bytes, total_bytes);
+}
+
 class FunctorGC : public GarbageCollector {
  public:
   explicit FunctorGC(std::function<void(size_t)> impl) : impl_(std::move(impl)) {}
@@ -196,14 +279,49 @@ void TabletMemoryManager::InitBlockCache(
       server_mem_tracker_);
 
   if (block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
-    options->block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
-                                                FLAGS_db_block_cache_num_shard_bits);
+    options->block_cache = FLAGS_db_block_cache_use_clock
+        ? rocksdb::NewClockCache(block_cache_size_bytes, FLAGS_db_block_cache_num_shard_bits)
+        : rocksdb::NewLRUCache(block_cache_size_bytes, FLAGS_db_block_cache_num_shard_bits);
     options->block_cache->SetMetrics(metrics);
+    InitSecondaryBlockCache(metrics, options);
     block_based_table_gc_ = std::make_shared<LRUCacheGC>(options->block_cache);
     block_based_table_mem_tracker_->AddGarbageCollector(block_based_table_gc_);
   }
 }
 
+void TabletMemoryManager::InitSecondaryBlockCache(
+    const scoped_refptr<MetricEntity>& metrics, tablet::TabletOptions* options) {
+  if (FLAGS_db_secondary_block_cache_path.empty() ||
+      FLAGS_db_secondary_block_cache_size_bytes <= 0) {
+    return;
+  }
+
+  rocksdb::FileSecondaryBlockCacheOptions secondary_options;
+  secondary_options.env = options->rocksdb_env;
+  secondary_options.path = FLAGS_db_secondary_block_cache_path;
+  secondary_options.capacity = FLAGS_db_secondary_block_cache_size_bytes;
+  secondary_options.metric_entity = metrics;
+  secondary_options.parent_mem_tracker = server_mem_tracker_;
+  if (options->universe_key_manager) {
+    // Blocks are stored decrypted, so the secondary cache is turned off while encryption at rest
+    // is enabled. Blocks admitted before the universe key registry is received from master are
+    // dropped as soon as it turns out that encryption is enabled.
+    secondary_options.encryption_enabled = [universe_key_manager = options->universe_key_manager] {
+      return universe_key_manager->IsEncryptionEnabled();
+    };
+  }
+  auto status = rocksdb::NewFileSecondaryBlockCache(
+      secondary_options, &options->secondary_block_cache);
+  if (!status.ok()) {
+    // Secondary block cache is an optimization, so continue without it.
+    LOG(WARNING) << "Failed to create secondary block cache at "
+                 << FLAGS_db_secondary_block_cache_path << ": " << status;
+    options->secondary_block_cache = nullptr;
+    return;
+  }
+  rocksdb::ConnectSecondaryBlockCache(options->block_cache.get(), options->secondary_block_cache);
+}
+
 void TabletMemoryManager::InitLogCacheGC() {
   auto log_cache_mem_tracker = consensus::LogCache::GetServerMemTracker(server_mem_tracker_);
   log_cache_gc_ = std::make_shared<FunctorGC>(
@@ -282,7 +400,31 @@ void TabletMemoryManager::LogCacheGC(MemTracker* log_cache_mem_tracker, size_t b
             << ", required: " << HumanReadableNumBytes::ToString(bytes_to_evict);
 }
 
+struct TabletMemoryManager::FlushCandidate {
+  tablet::TabletPeerPtr peer;
+  tablet::FlushFlags flags;
+  uint64_t memtable_bytes;
+  HybridTime oldest_write;
+  bool small_idle;
+  double score;
+  // Used to add retained WAL to the score.
+  log::Log* log;
+  OpId persistent_op_id;
+  double write_rate_factor;
+};
+
 void TabletMemoryManager::FlushTabletIfLimitExceeded() {
+  if (FLAGS_enable_memstore_flush_scoring) {
+    // Memory is released only when started flushes complete, so next round would pick more
+    // memtables than required. Memory monitor wakes us up again if limit is still exceeded.
+    if (memory_monitor_->Exceeded() || FLAGS_TEST_pretend_memory_exceeded_enforce_flush) {
+      YB_LOG_EVERY_N_SECS(INFO, 5) << Format(
+          "Memstore global limit of $0 bytes reached, looking for memtables to flush",
+          memory_monitor_->limit());
+      FlushBestCandidates(CollectFlushCandidates());
+    }
+    return;
+  }
   int iteration = 0;
   while (memory_monitor_->Exceeded() ||
          (iteration++ == 0 && FLAGS_TEST_pretend_memory_exceeded_enforce_flush)) {
@@ -291,25 +433,189 @@ void TabletMemoryManager::FlushTabletIfLimitExceeded() {
     auto flush_tick = rocksdb::FlushTick();
     tablet::TabletPeerPtr peer_to_flush = TabletToFlush();
     if (peer_to_flush) {
-      auto tablet_to_flush = peer_to_flush->shared_tablet();
       // TODO(bojanserafimov): If peer_to_flush flushes now because of other reasons,
       // we will schedule a second flush, which will unnecessarily stall writes for a short time.
       // This will not happen often, but should be fixed.
-      if (tablet_to_flush) {
-        LOG(INFO)
-            << LogPrefix(peer_to_flush)
-            << "Flushing tablet with oldest memstore write at "
-            << tablet_to_flush->OldestMutableMemtableWriteHybridTime();
-        WARN_NOT_OK(
-            tablet_to_flush->Flush(
-                tablet::FlushMode::kAsync, tablet::FlushFlags::kAll, flush_tick),
-            Substitute("Flush failed on $0", peer_to_flush->tablet_id()));
-        for (auto listener : TEST_listeners) {
-          listener->StartedFlush(peer_to_flush->tablet_id());
-        }
+      FlushTablet(peer_to_flush, tablet::FlushFlags::kAll, flush_tick);
+    }
+  }
+}
+
+bool TabletMemoryManager::FlushTablet(
+    const tablet::TabletPeerPtr& peer, tablet::FlushFlags flags, int64_t flush_tick) {
+  auto tablet = peer->shared_tablet();
+  if (!tablet) {
+    return false;
+  }
+  LOG(INFO)
+      << LogPrefix(peer)
+      << "Flushing tablet with oldest memstore write at "
+      << tablet->OldestMutableMemtableWriteHybridTime();
+  WARN_NOT_OK(
+      tablet->Flush(tablet::FlushMode::kAsync, flags, flush_tick),
+      Substitute("Flush failed on $0", peer->tablet_id()));
+  for (auto listener : TEST_listeners) {
+    listener->StartedFlush(peer->tablet_id());
+  }
+  return true;
+}
+
+std::vector<TabletMemoryManager::FlushCandidate> TabletMemoryManager::CollectFlushCandidates() {
+  std::vector<FlushCandidate> result;
+  const double wal_weight = FLAGS_memstore_flush_wal_retention_weight;
+  const uint64_t small_memtable_bytes = FLAGS_memstore_flush_small_memtable_bytes;
+  const auto small_memtable_min_age =
+      std::chrono::seconds(FLAGS_memstore_flush_small_memtable_min_age_sec);
+  for (const auto& peer : peers_fn_()) {
+    const auto tablet = peer->shared_tablet();
+    if (!tablet) {
+      continue;
+    }
+    const auto memtable_sizes = tablet->GetMutableMemtableSizes();
+    if (memtable_sizes.first == 0 && memtable_sizes.second == 0) {
+      continue;
+    }
+    const auto oldest_write = tablet->OldestMutableMemtableWriteHybridTime();
+    if (!oldest_write.ok()) {
+      YB_LOG_EVERY_N_SECS(WARNING, 5) << Format(
+          "Failed to get oldest mutable memtable write ht for tablet $0: $1",
+          tablet->tablet_id(), oldest_write.status());
+      continue;
+    }
+    // Time the memtables are being filled, used to estimate the write rate of the tablet.
+    std::chrono::microseconds fill_time(0);
+    if (*oldest_write != HybridTime::kMax) {
+      fill_time = std::chrono::microseconds(
+          std::max<int64_t>(tablet->clock()->Now().PhysicalDiff(*oldest_write), 0));
+    }
+    const double fill_seconds = std::chrono::duration<double>(fill_time).count();
+    auto persistent_op_ids = tablet->MaxPersistentOpId();
+    if (!persistent_op_ids.ok()) {
+      continue;
+    }
+    const auto log = peer->log_available() ? peer->log() : nullptr;
+
+    auto add_candidate = [&](
+        tablet::FlushFlags flags, uint64_t memtable_bytes, const OpId& persistent_op_id) {
+      if (memtable_bytes == 0) {
+        return;
       }
+      // Oldest write is tracked per tablet, so memtable that was created later than the other one
+      // of the same tablet is considered to be written slower than it actually is.
+      const double write_rate = memtable_bytes / std::max(fill_seconds, 1.0);
+      const double write_rate_factor =
+          kMemtableWriteRateHalfScore / (kMemtableWriteRateHalfScore + write_rate);
+      result.push_back(FlushCandidate {
+        peer,
+        flags,
+        memtable_bytes,
+        *oldest_write,
+        memtable_bytes < small_memtable_bytes && fill_time >= small_memtable_min_age,
+        memtable_bytes * write_rate_factor,
+        log,
+        persistent_op_id,
+        write_rate_factor,
+      });
+    };
+    add_candidate(
+        tablet::FlushFlags::kIntents, memtable_sizes.first, persistent_op_ids->intents);
+    add_candidate(
+        tablet::FlushFlags::kRegular, memtable_sizes.second, persistent_op_ids->regular);
+  }
+
+  // Add retained WAL to the score of the largest memtables only. The rest of memtables are
+  // unlikely to be picked before them, except small idle ones, that are picked anyway.
+  const size_t max_tablets = std::max(FLAGS_memstore_flush_max_parallel_tablets, 1);
+  const size_t num_wal_scored =
+      std::min(result.size(), kWalScoredCandidatesPerFlushedTablet * max_tablets);
+  std::nth_element(
+      result.begin(), result.begin() + num_wal_scored, result.end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.memtable_bytes > rhs.memtable_bytes; });
+  for (auto it = result.begin(); it != result.begin() + num_wal_scored; ++it) {
+    if (it->log) {
+      it->score += wal_weight * WalBytesRetainedAfter(it->log, it->persistent_op_id) *
+                   it->write_rate_factor;
+    }
+  }
+
+  std::sort(result.begin(), result.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.score > rhs.score;
+  });
+  return result;
+}
+
+size_t TabletMemoryManager::FlushBestCandidates(const std::vector<FlushCandidate>& candidates) {
+  const auto memory_usage = memory_monitor_->memory_usage();
+  const auto limit = memory_monitor_->limit();
+  const uint64_t bytes_to_free = memory_usage > limit ? memory_usage - limit : 1;
+  const size_t max_tablets = std::max(FLAGS_memstore_flush_max_parallel_tablets, 1);
+  const size_t max_small_memtables =
+      std::max(FLAGS_memstore_flush_max_small_memtables_per_round, 0);
+
+  // Tablets to flush in order of picking, with DBs that should be flushed.
+  struct TabletToFlushInfo {
+    tablet::TabletPeerPtr peer;
+    bool regular = false;
+    bool intents = false;
+  };
+  std::vector<TabletToFlushInfo> tablets;
+  auto pick = [&tablets](const FlushCandidate& candidate) {
+    auto it = std::find_if(tablets.begin(), tablets.end(), [&candidate](const auto& info) {
+      return info.peer == candidate.peer;
+    });
+    if (it == tablets.end()) {
+      tablets.push_back(TabletToFlushInfo { candidate.peer });
+      it = tablets.end() - 1;
+    }
+    (candidate.flags == tablet::FlushFlags::kRegular ? it->regular : it->intents) = true;
+  };
+
+  // Small idle memtables are flushed together with the best scored ones, so a lot of idle
+  // tablets could not pin WAL and memory for a long time, while the busiest tablet is flushed
+  // repeatedly. They are cheap to flush, so they go first, oldest first.
+  std::vector<size_t> small_idle;
+  for (size_t i = 0; i != candidates.size(); ++i) {
+    if (candidates[i].small_idle) {
+      small_idle.push_back(i);
+    }
+  }
+  std::stable_sort(small_idle.begin(), small_idle.end(), [&candidates](size_t lhs, size_t rhs) {
+    return candidates[lhs].oldest_write < candidates[rhs].oldest_write;
+  });
+  if (small_idle.size() > max_small_memtables) {
+    small_idle.resize(max_small_memtables);
+  }
+  uint64_t bytes_picked = 0;
+  std::vector<bool> picked(candidates.size());
+  for (auto i : small_idle) {
+    pick(candidates[i]);
+    picked[i] = true;
+    bytes_picked += candidates[i].memtable_bytes;
+  }
+  // Best scored memtables are flushed until enough memory would be freed.
+  size_t num_picked = 0;
+  for (size_t i = 0; i != candidates.size() && num_picked < max_tablets; ++i) {
+    if (bytes_picked >= bytes_to_free) {
+      break;
+    }
+    if (!picked[i]) {
+      pick(candidates[i]);
+      ++num_picked;
+      bytes_picked += candidates[i].memtable_bytes;
+    }
+  }
+
+  auto flush_tick = rocksdb::FlushTick();
+  size_t result = 0;
+  for (const auto& info : tablets) {
+    auto flags = info.regular && info.intents ? tablet::FlushFlags::kAll
+                                              : info.regular ? tablet::FlushFlags::kRegular
+                                                             : tablet::FlushFlags::kIntents;
+    if (FlushTablet(info.peer, flags, flush_tick)) {
+      ++result;
     }
   }
+  return result;
 }
 
 // Return the tablet with the oldest write in memstore, or nullptr if all tablet memstores are
@@ -73,6 +73,10 @@ class TabletMemoryManager {
       const int32_t default_block_cache_size_percentage,
       tablet::TabletOptions* options);
 
+  // Creates secondary block cache if it is configured and connects it to the block cache.
+  void InitSecondaryBlockCache(
+      const scoped_refptr<MetricEntity>& metrics, tablet::TabletOptions* options);
+
   // Initializes the log cache garbage collector.
   void InitLogCacheGC();
 
@@ -87,6 +91,23 @@ class TabletMemoryManager {
   // if no tablet meets the criteria.  Uses peers_fn_ to determine the full list of peers to check.
   tablet::TabletPeerPtr TabletToFlush();
 
+  struct FlushCandidate;
+
+  // Scores mutable memtables of regular and intents DBs of all peers, by memory they hold,
+  // WAL bytes they keep from being GCed, and write rate of the tablet.
+  // Memtables that are being refilled quickly by writes get lower score, since flushing them
+  // frees memory only for a short time.
+  // Returns candidates sorted by descending score.
+  std::vector<FlushCandidate> CollectFlushCandidates();
+
+  // Picks memtables to flush from candidates and starts flushing them in parallel.
+  // Returns the number of tablets that flushes were started for.
+  size_t FlushBestCandidates(const std::vector<FlushCandidate>& candidates);
+
+  // Starts async flush of the specified DBs of the tablet.
+  bool FlushTablet(
+      const tablet::TabletPeerPtr& peer, tablet::FlushFlags flags, int64_t flush_tick);
+
   // Function to return a log prefix with the tablet's tablet_id and permanent_uuid.
   std::string LogPrefix(const tablet::TabletPeerPtr& peer) const;
 
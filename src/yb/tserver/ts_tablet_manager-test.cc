@@ -572,7 +572,8 @@ Result<size_t> CountUniqueLimiters(const TSTabletManager::TabletPeers& peers,
     SCHECK_NOTNULL(db);
     auto rl = db->GetDBOptions().rate_limiter.get();
     if (rl) {
-      unique.insert(rl);
+      // Tablets access shared rate limiter through their own shares.
+      unique.insert(rocksdb::GetBaseRateLimiter(rl));
     }
   }
   return unique.size();
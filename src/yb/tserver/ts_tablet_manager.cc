@@ -75,6 +75,7 @@
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/poller.h"
 
+#include "yb/tablet/compaction_rate_controller.h"
 #include "yb/tablet/metadata.pb.h"
 #include "yb/tablet/operations/split_operation.h"
 #include "yb/tablet/tablet.h"
@@ -223,6 +224,7 @@ DEFINE_bool(enable_restart_transaction_status_tablets_first, true,
             "Set to true to prioritize bootstrapping transaction status tablets first.");
 
 DECLARE_string(rocksdb_compact_flush_rate_limit_sharing_mode);
+DECLARE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec);
 
 namespace yb {
 namespace tserver {
@@ -393,6 +395,10 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
                   server_->metric_entity(), admin_triggered_compaction_pool))
               .Build(&admin_triggered_compaction_pool_));
 
+  // Secondary block cache files are written through rocksdb env and depend on encryption state,
+  // so both should be set before TabletMemoryManager creates block caches.
+  tablet_options_.rocksdb_env = server_->GetRocksDBEnv();
+  tablet_options_.universe_key_manager = server_->options().universe_key_manager;
   mem_manager_ = std::make_shared<TabletMemoryManager>(
       &tablet_options_,
       server_->mem_tracker(),
@@ -421,10 +427,25 @@ Status TSTabletManager::Init() {
   });
 
   tablet_options_.env = server_->GetEnv();
-  tablet_options_.rocksdb_env = server_->GetRocksDBEnv();
   tablet_options_.listeners = server_->options().listeners;
   if (docdb::GetRocksDBRateLimiterSharingMode() == docdb::RateLimiterSharingMode::TSERVER) {
     tablet_options_.rate_limiter = docdb::CreateRocksDBRateLimiter();
+    if (tablet_options_.rate_limiter) {
+      // Number of SST files grows when compactions fall behind flushes.
+      tablet_options_.compaction_rate_controller =
+          std::make_shared<tablet::CompactionRateController>(
+              tablet_options_.rate_limiter, FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec,
+              [this] {
+                uint64_t result = 0;
+                for (const auto& peer : GetTabletPeers()) {
+                  auto tablet = peer->shared_tablet();
+                  if (tablet) {
+                    result += tablet->GetCurrentVersionNumSSTFiles();
+                  }
+                }
+                return result;
+              });
+    }
   }
 
   // Start the threadpool we'll use to open tablets.
@@ -66,6 +66,17 @@ struct TabletServerDelayTag : IntegralBackedErrorTag<MonoDeltaTraits> {
 
 typedef StatusErrorCodeImpl<TabletServerDelayTag> TabletServerDelay;
 
+// UUID of the tablet server that replica rejecting request with NOT_THE_LEADER considers to be
+// the leader, so client could send request directly to it.
+struct TabletServerLeaderHintTag : StringVectorBackedErrorTag {
+  // This category id is part of the wire protocol and should not be changed once released.
+  static constexpr uint8_t kCategory = 16;
+
+  static std::string ToMessage(const Value& value);
+};
+
+typedef StatusErrorCodeImpl<TabletServerLeaderHintTag> TabletServerLeaderHint;
+
 } // namespace tserver
 } // namespace yb
 
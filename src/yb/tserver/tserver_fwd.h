@@ -32,6 +32,7 @@ class ListTabletsResponsePB;
 class ListTabletsResponsePB_StatusAndSchemaPB;
 class LocalTabletServer;
 class MetricsSnapshotter;
+class PgTableCache;
 class TSTabletManager;
 class TabletPeerLookupIf;
 class TabletServer;
@@ -166,6 +166,11 @@ class RandomAccessFile : public FileWithUniqueId {
 
   virtual void Hint(AccessPattern pattern) {}
 
+  // Asks the platform to start loading the range [offset, offset + n) of this file in the
+  // background, so that a subsequent Read of this range does not have to wait for the device.
+  // Does not block on I/O and does not report errors, this is only a hint.
+  virtual void Prefetch(uint64_t offset, size_t n) {}
+
   // Remove any kind of caching of data from the offset to offset+length
   // of this file. If the length is 0, then it refers to the end of file.
   // If the system is not caching the file contents, then this is a noop.
@@ -221,6 +226,8 @@ class RandomAccessFileWrapper : public RandomAccessFile {
 
   void Hint(AccessPattern pattern) override { return target_->Hint(pattern); }
 
+  void Prefetch(uint64_t offset, size_t n) override { return target_->Prefetch(offset, n); }
+
   Status InvalidateCache(size_t offset, size_t length) override;
 
  private:
@@ -247,6 +247,14 @@ void PosixRandomAccessFile::Hint(AccessPattern pattern) {
   }
 }
 
+void PosixRandomAccessFile::Prefetch(uint64_t offset, size_t n) {
+  // Without OS buffering the prefetched pages would be dropped right after the next read.
+  if (!use_os_buffer_ || n == 0) {
+    return;
+  }
+  Fadvise(fd_, static_cast<off_t>(offset), n, POSIX_FADV_WILLNEED);
+}
+
 Status PosixRandomAccessFile::InvalidateCache(size_t offset, size_t length) {
 #ifndef __linux__
   return Status::OK();
@@ -62,6 +62,7 @@ class PosixRandomAccessFile : public RandomAccessFile {
   virtual size_t GetUniqueId(char* id) const override;
 #endif
   virtual void Hint(AccessPattern pattern) override;
+  void Prefetch(uint64_t offset, size_t n) override;
   virtual CHECKED_STATUS InvalidateCache(size_t offset, size_t length) override;
 
  private:
@@ -237,6 +237,16 @@ class percpu_rwlock {
     }
   }
 
+  // Waits until all readers that acquired the lock before this call release it.
+  // Unlike lock(), per-CPU locks are taken one by one, so readers are never blocked on all CPUs
+  // at the same time.
+  void wait_for_readers() {
+    for (int i = 0; i < n_cpus_; i++) {
+      locks_[i].lock.lock();
+      locks_[i].lock.unlock();
+    }
+  }
+
   // Returns the memory usage of this object without the object itself. Should
   // be used when embedded inside another object.
   size_t memory_footprint_excluding_this() const;
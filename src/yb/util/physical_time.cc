@@ -13,6 +13,8 @@
 
 #include "yb/util/physical_time.h"
 
+#include <atomic>
+
 #if !defined(__APPLE__)
 #include <sys/timex.h>
 #endif
@@ -40,6 +42,14 @@ DEFINE_uint64(max_clock_skew_usec, 500 * 1000,
               "Transaction read clock skew in usec. "
               "This is the maximum allowed time delta between servers of a single cluster.");
 
+DEFINE_uint64(adjtime_clock_refresh_interval_ms, 100,
+              "How often AdjTimeClock should query max clock error from the kernel using "
+              "ntp_adjtime syscall. In between the time is read from the realtime clock, that does "
+              "not require a syscall, and max error is extrapolated using max frequency tolerance. "
+              "0 - query ntp_adjtime on every clock read.");
+TAG_FLAG(adjtime_clock_refresh_interval_ms, advanced);
+TAG_FLAG(adjtime_clock_refresh_interval_ms, runtime);
+
 namespace yb {
 
 namespace {
@@ -96,26 +106,81 @@ CHECKED_STATUS CallAdjTime(timex* tx) {
   }
 }
 
+Result<PhysicalTime> AdjTimeNow() {
+  const MicrosTime kMicrosPerSec = 1000000;
+
+  timex tx;
+  RETURN_NOT_OK(CallAdjTime(&tx));
+
+  if (tx.status & STA_NANO) {
+    tx.time.tv_usec /= 1000;
+  }
+  DCHECK_LT(tx.time.tv_usec, 1000000);
+
+  return PhysicalTime {
+    tx.time.tv_sec * kMicrosPerSec + tx.time.tv_usec,
+    static_cast<yb::MicrosTime>(tx.maxerror)
+  };
+}
+
+// Kernel increases max error by the max frequency tolerance of the clock every second,
+// until it is reset by NTP daemon. See MAXFREQ in the kernel sources.
+constexpr MicrosTime kMaxFrequencyTolerancePpm = 500;
+
 class AdjTimeClockImpl : public PhysicalClock {
+ public:
   Result<PhysicalTime> Now() override {
-    const MicrosTime kMicrosPerSec = 1000000;
+    const auto refresh_interval_us =
+        GetAtomicFlag(&FLAGS_adjtime_clock_refresh_interval_ms) * 1000;
+    if (refresh_interval_us == 0) {
+      return CheckClockSyncError(VERIFY_RESULT(AdjTimeNow()));
+    }
 
-    timex tx;
-    RETURN_NOT_OK(CallAdjTime(&tx));
+    const auto mono_now = static_cast<MicrosTime>(GetMonoTimeMicros());
+    auto next_refresh = next_refresh_mono_micros_.load(std::memory_order_acquire);
+    // Only the thread that moved next refresh time forward queries the kernel, others use the
+    // previously obtained error.
+    if (mono_now >= next_refresh &&
+        next_refresh_mono_micros_.compare_exchange_strong(
+            next_refresh, mono_now + refresh_interval_us, std::memory_order_acq_rel)) {
+      auto now = AdjTimeNow();
+      if (!now.ok()) {
+        next_refresh_mono_micros_.store(0, std::memory_order_release);
+        return now.status();
+      }
+      error_state_.store(
+          ErrorState { .mono_micros = mono_now, .max_error = now->max_error },
+          boost::memory_order_release);
+      return CheckClockSyncError(*now);
+    }
 
-    if (tx.status & STA_NANO) {
-      tx.time.tv_usec /= 1000;
+    auto error_state = error_state_.load(boost::memory_order_acquire);
+    if (error_state.mono_micros == 0) {
+      // Max error was not obtained yet, because first refresh is in progress.
+      return CheckClockSyncError(VERIFY_RESULT(AdjTimeNow()));
     }
-    DCHECK_LT(tx.time.tv_usec, 1000000);
 
-    return CheckClockSyncError(
-        { tx.time.tv_sec * kMicrosPerSec + tx.time.tv_usec,
-          static_cast<yb::MicrosTime>(tx.maxerror) });
+    // Round up, so extrapolated error is never less than the real one.
+    const auto elapsed_us = mono_now > error_state.mono_micros
+        ? mono_now - error_state.mono_micros : 0;
+    const auto error_growth = (elapsed_us * kMaxFrequencyTolerancePpm + 999999) / 1000000;
+    return CheckClockSyncError({
+        static_cast<MicrosTime>(GetCurrentTimeMicros()), error_state.max_error + error_growth });
   }
 
   MicrosTime MaxGlobalTime(PhysicalTime time) override {
     return time.time_point + GetAtomicFlag(&FLAGS_max_clock_skew_usec);
   }
+
+ private:
+  struct ErrorState {
+    // Monotonic time when max error was obtained, 0 if not obtained yet.
+    MicrosTime mono_micros;
+    MicrosTime max_error;
+  };
+
+  std::atomic<MicrosTime> next_refresh_mono_micros_{0};
+  boost::atomic<ErrorState> error_state_{ErrorState { .mono_micros = 0, .max_error = 0 }};
 };
 
 #endif
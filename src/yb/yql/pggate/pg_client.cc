@@ -111,9 +111,12 @@ class PgClient::Impl {
     });
   }
 
-  Result<PgTableDescPtr> OpenTable(const PgObjectId& table_id) {
+  Result<PgTableDescPtr> OpenTable(
+      const PgObjectId& table_id, bool reload, uint64_t catalog_version) {
     tserver::PgOpenTableRequestPB req;
     req.set_table_id(table_id.GetYBTableId());
+    req.set_reload(reload);
+    req.set_ysql_catalog_version(catalog_version);
     tserver::PgOpenTableResponsePB resp;
 
     RETURN_NOT_OK(proxy_->OpenTable(req, &resp, PrepareAdminController()));
@@ -306,8 +309,9 @@ void PgClient::Shutdown() {
   impl_->Shutdown();
 }
 
-Result<PgTableDescPtr> PgClient::OpenTable(const PgObjectId& table_id) {
-  return impl_->OpenTable(table_id);
+Result<PgTableDescPtr> PgClient::OpenTable(
+    const PgObjectId& table_id, bool reload, uint64_t catalog_version) {
+  return impl_->OpenTable(table_id, reload, catalog_version);
 }
 
 Result<master::GetNamespaceInfoResponsePB> PgClient::GetDatabaseInfo(uint32_t oid) {
@@ -53,7 +53,10 @@ class PgClient {
                        const tserver::TServerSharedObject& tserver_shared_object);
   void Shutdown();
 
-  Result<PgTableDescPtr> OpenTable(const PgObjectId& table_id);
+  // Table info is shared by sessions of the tablet server. reload forces loading it from the
+  // master, info cached for a catalog version older than catalog_version is not used.
+  Result<PgTableDescPtr> OpenTable(
+      const PgObjectId& table_id, bool reload, uint64_t catalog_version);
 
   Result<master::GetNamespaceInfoResponsePB> GetDatabaseInfo(PgOid oid);
 
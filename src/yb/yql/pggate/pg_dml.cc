@@ -426,6 +426,7 @@ Result<bool> PgDml::GetNextRow(PgTuple *pg_tuple) {
         RETURN_NOT_OK(rowset.WritePgTuple(targets_, pg_tuple, &row_order));
         SCHECK(row_order == -1 || row_order == current_row_order_, InternalError,
                "The resulting row are not arranged in indexing order");
+        last_row_order_ = row_order;
 
         // Found the current row. Move cursor to next row.
         current_row_order_++;
@@ -78,6 +78,12 @@ class PgDml : public PgStatement {
   // Returns TRUE if docdb replies with more data.
   Result<bool> FetchDataFromServer();
 
+  // Order of the last fetched row among the rows requested by the batch of ybctids or keys,
+  // -1 if the rows are not ordered.
+  int64_t last_row_order() const {
+    return last_row_order_;
+  }
+
   // Returns TRUE if desired row is found.
   Result<bool> GetNextRow(PgTuple *pg_tuple);
 
@@ -229,6 +235,7 @@ class PgDml : public PgStatement {
   // Data members for navigating the output / result-set from either seleted or returned targets.
   std::list<PgDocResult> rowsets_;
   int64_t current_row_order_ = 0;
+  int64_t last_row_order_ = -1;
 
   // Yugabyte has a few IN/OUT parameters of statement execution, "pg_exec_params_" is used to sent
   // OUT value back to postgres.
@@ -259,7 +259,9 @@ Status PgDmlRead::Exec(const PgExecParameters *exec_params) {
   SetColumnRefs();
 
   const auto row_mark_type = GetRowMarkType(exec_params);
-  if (doc_op_ &&
+  if (!batched_key_values_.empty()) {
+    RETURN_NOT_OK(SubstituteBatchedKeysWithYbctids(exec_params));
+  } else if (doc_op_ &&
       !secondary_index_query_ &&
       IsValidRowMarkType(row_mark_type) &&
       CanBuildYbctidsFromPrimaryBinds()) {
@@ -300,7 +302,8 @@ Status PgDmlRead::Exec(const PgExecParameters *exec_params) {
 
     // Execute select statement and prefetching data from DocDB.
     // Note: For SysTable, doc_op_ === null, IndexScan doesn't send separate request.
-    if (doc_op_) {
+    // Execution could be already abandoned in case of empty batch of keys.
+    if (doc_op_ && !doc_op_->end_of_data()) {
       SCHECK_EQ(VERIFY_RESULT(doc_op_->Execute()), RequestSent::kTrue, IllegalState,
                 "YSQL read operation was not sent");
     }
@@ -520,6 +523,100 @@ Result<std::vector<std::string>> PgDmlRead::BuildYbctidsFromPrimaryBinds() {
   return STATUS(IllegalState, "Can't build ybctids, bad preconditions");
 }
 
+Status PgDmlRead::BindBatchedKeys(int n_keys, int n_attrs, const int *attr_nums,
+                                  PgExpr **attr_values) {
+  SCHECK(doc_op_ && !secondary_index_query_, NotSupported,
+         "Batched keys can be bound to a primary key read only");
+  SCHECK(bind_, IllegalState, "Table is not bound");
+  SCHECK_EQ(static_cast<size_t>(n_attrs), bind_->num_key_columns(), InvalidArgument,
+            "All primary key columns should be bound");
+  SCHECK_GE(n_keys, 0, InvalidArgument, "Wrong number of keys");
+
+  // Find key column index of each attribute.
+  std::vector<size_t> column_indexes(n_attrs);
+  for (int attr = 0; attr < n_attrs; attr++) {
+    PgColumn& col = VERIFY_RESULT(bind_.ColumnForAttr(attr_nums[attr]));
+    SCHECK(col.is_primary(), InvalidArgument, Format("Column $0 is not a primary key column",
+                                                     attr_nums[attr]));
+    auto& columns = bind_.columns();
+    column_indexes[attr] = &col - columns.data();
+  }
+
+  batched_key_values_.assign(n_attrs, std::vector<PgExpr*>());
+  for (int attr = 0; attr < n_attrs; attr++) {
+    const auto& col = bind_.ColumnForIndex(column_indexes[attr]);
+    auto& values = batched_key_values_[column_indexes[attr]];
+    SCHECK(values.empty(), InvalidArgument, Format("Column $0 is bound twice", attr_nums[attr]));
+    values.reserve(n_keys);
+    for (int key = 0; key < n_keys; key++) {
+      PgExpr* value = attr_values[key * n_attrs + attr];
+      SCHECK(value != nullptr, InvalidArgument, "Primary key value cannot be NULL");
+      // TODO(neil) Current code combine TEXT and BINARY datatypes into ONE representation.
+      if (col.internal_type() != InternalType::kBinaryValue) {
+        SCHECK_EQ(col.internal_type(), value->internal_type(), Corruption,
+                  "Attribute value type does not match column type");
+      }
+      values.push_back(value);
+    }
+  }
+  return Status::OK();
+}
+
+Result<std::vector<std::string>> PgDmlRead::BuildYbctidsFromBatchedKeys() {
+  const size_t num_hash_key_columns = bind_->num_hash_key_columns();
+  const size_t num_key_columns = bind_->num_key_columns();
+  const size_t n_keys = batched_key_values_.empty() ? 0 : batched_key_values_.front().size();
+
+  std::vector<std::string> ybctids;
+  ybctids.reserve(n_keys);
+  vector<docdb::PrimitiveValue> hashed_components, range_components;
+  hashed_components.reserve(num_hash_key_columns);
+  range_components.reserve(num_key_columns - num_hash_key_columns);
+  for (size_t key = 0; key < n_keys; key++) {
+    google::protobuf::RepeatedPtrField<PgsqlExpressionPB> hashed_values;
+    hashed_components.clear();
+    range_components.clear();
+    for (size_t i = 0; i < num_key_columns; ++i) {
+      const auto& col = bind_.ColumnForIndex(i);
+      auto* value_pb = i < num_hash_key_columns ? hashed_values.Add()->mutable_value()
+                                                : nullptr;
+      QLValuePB range_value;
+      if (!value_pb) {
+        value_pb = &range_value;
+      }
+      RETURN_NOT_OK(batched_key_values_[i][key]->Eval(value_pb));
+      auto component = docdb::PrimitiveValue::FromQLValuePB(*value_pb, col.desc().sorting_type());
+      if (i < num_hash_key_columns) {
+        hashed_components.push_back(std::move(component));
+      } else {
+        range_components.push_back(std::move(component));
+      }
+    }
+    auto dockey_builder = VERIFY_RESULT(CreateDocKeyBuilder(
+        hashed_components, hashed_values, bind_->partition_schema()));
+    ybctids.push_back(dockey_builder(range_components).Encode().ToStringBuffer());
+  }
+  return ybctids;
+}
+
+Status PgDmlRead::SubstituteBatchedKeysWithYbctids(const PgExecParameters* exec_params) {
+  // Keys are looked up by ybctids, one request per tablet, the same way as ybctids selected from
+  // a secondary index. Order of ybctids is kept, so row order is the index of the key in the batch.
+  const auto ybctids = VERIFY_RESULT(BuildYbctidsFromBatchedKeys());
+  RETURN_NOT_OK(doc_op_->ExecuteInit(exec_params));
+  if (ybctids.empty()) {
+    doc_op_->AbandonExecution();
+    return Status::OK();
+  }
+
+  std::vector<Slice> ybctids_as_slice;
+  ybctids_as_slice.reserve(ybctids.size());
+  for (const auto& ybctid : ybctids) {
+    ybctids_as_slice.emplace_back(ybctid);
+  }
+  return doc_op_->PopulateDmlByYbctidOps(&ybctids_as_slice);
+}
+
 // Function checks that one and only one range key component has IN clause
 // and all other key components are set.
 bool PgDmlRead::CanBuildYbctidsFromPrimaryBinds() {
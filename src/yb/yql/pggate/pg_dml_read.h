@@ -68,6 +68,13 @@ class PgDmlRead : public PgDml {
   // Bind a column with an IN condition.
   CHECKED_STATUS BindColumnCondIn(int attnum, int n_attr_values, PgExpr **attr_values);
 
+  // Bind a batch of primary keys, all rows of these keys are read with one request per tablet.
+  // - attr_nums lists n_attrs columns, all primary key columns must be present.
+  // - attr_values contains n_keys * n_attrs values, key by key, in the order of attr_nums.
+  // Rows are returned in the order of keys, and keys without a row are skipped.
+  CHECKED_STATUS BindBatchedKeys(int n_keys, int n_attrs, const int *attr_nums,
+                                 PgExpr **attr_values);
+
   CHECKED_STATUS BindHashCode(bool start_valid, bool start_inclusive,
                                 uint64_t start_hash_val, bool end_valid,
                                 bool end_inclusive, uint64_t end_hash_val);
@@ -113,6 +120,8 @@ class PgDmlRead : public PgDml {
   bool CanBuildYbctidsFromPrimaryBinds();
   Result<std::vector<std::string>> BuildYbctidsFromPrimaryBinds();
   CHECKED_STATUS SubstitutePrimaryBindsWithYbctids(const PgExecParameters* exec_params);
+  Result<std::vector<std::string>> BuildYbctidsFromBatchedKeys();
+  CHECKED_STATUS SubstituteBatchedKeysWithYbctids(const PgExecParameters* exec_params);
   CHECKED_STATUS MoveBoundKeyInOperator(PgColumn* col, const PgsqlConditionPB& in_operator);
   CHECKED_STATUS CopyBoundValue(
       const PgColumn& col, const PgsqlExpressionPB& src, QLValuePB* dest) const;
@@ -120,6 +129,9 @@ class PgDmlRead : public PgDml {
       const PgColumn& col, const PgsqlExpressionPB& src, PgsqlExpressionPB* dest);
   Result<docdb::PrimitiveValue> BuildKeyColumnValue(
       const PgColumn& col, const PgsqlExpressionPB& src);
+
+  // Values bound by BindBatchedKeys(), one vector per primary key column, in key column order.
+  std::vector<std::vector<PgExpr*>> batched_key_values_;
 };
 
 }  // namespace pggate
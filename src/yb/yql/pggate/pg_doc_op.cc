@@ -15,8 +15,11 @@
 #include "yb/yql/pggate/pg_doc_op.h"
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
+#include <random>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -33,6 +36,7 @@
 #include "yb/yql/pggate/pg_tools.h"
 #include "yb/yql/pggate/pggate_flags.h"
 #include "yb/yql/pggate/util/pg_doc_data.h"
+#include "yb/yql/pggate/util/pg_wire.h"
 
 using std::lower_bound;
 using std::list;
@@ -177,6 +181,7 @@ Result<RequestSent> PgDocOp::Execute(bool force_non_bufferable) {
   // layer.
   exec_status_ = SendRequest(force_non_bufferable);
   RETURN_NOT_OK(exec_status_);
+  response_prefetched_ = false;
   return RequestSent(response_.InProgress());
 }
 
@@ -189,10 +194,21 @@ Status PgDocOp::GetResult(list<PgDocResult> *rowsets) {
     if (suppress_next_result_prefetching_ && !response_.InProgress()) {
       exec_status_ = SendRequest(true /* force_non_bufferable */);
       RETURN_NOT_OK(exec_status_);
+      response_prefetched_ = false;
     }
 
     DCHECK(response_.InProgress());
+    // Upper level consumed previous rows before the prefetched ones were received.
+    waited_for_prefetched_response_ = response_prefetched_ && !response_.Ready();
+    response_prefetched_ = false;
     auto rows = VERIFY_RESULT(ProcessResponse(response_.GetStatus(pg_session_.get())));
+    // Parallel scan holds back rows of partitions that follow the one being returned, so it is
+    // possible that nothing could be returned yet. Keep reading until rows are available.
+    while (rows.empty() && !end_of_data_) {
+      exec_status_ = SendRequest(true /* force_non_bufferable */);
+      RETURN_NOT_OK(exec_status_);
+      rows = VERIFY_RESULT(ProcessResponse(response_.GetStatus(pg_session_.get())));
+    }
     // In case ProcessResponse doesn't fail with an error
     // it should return non empty rows and/or set end_of_data_.
     DCHECK(!rows.empty() || end_of_data_);
@@ -201,6 +217,7 @@ Status PgDocOp::GetResult(list<PgDocResult> *rowsets) {
     if (!(end_of_data_ || suppress_next_result_prefetching_)) {
       exec_status_ = SendRequest(true /* force_non_bufferable */);
       RETURN_NOT_OK(exec_status_);
+      response_prefetched_ = true;
     }
   }
 
@@ -233,31 +250,27 @@ Status PgDocOp::ClonePgsqlOps(size_t op_count) {
 }
 
 void PgDocOp::MoveInactiveOpsOutside() {
-  // Move inactive op to the end.
-  const ssize_t total_op_count = pgsql_ops_.size();
+  // Move inactive op to the end. Active operators keep their relative order, parallel scan relies
+  // on it to return rows in the order of partitions.
+  const size_t total_op_count = pgsql_ops_.size();
   bool has_sorting_order = !batch_row_orders_.empty();
-  ssize_t left_iter = 0;
-  ssize_t right_iter = total_op_count - 1;
-  while (true) {
-    // Advance left iterator.
-    while (left_iter < total_op_count && pgsql_ops_[left_iter]->is_active()) left_iter++;
-
-    // Advance right iterator.
-    while (right_iter >= 0 && !pgsql_ops_[right_iter]->is_active()) right_iter--;
-
-    // Move inactive operator to the end by swapping the pointers.
-    if (left_iter < right_iter) {
-      std::swap(pgsql_ops_[left_iter], pgsql_ops_[right_iter]);
+  size_t active_count = 0;
+  for (size_t op_index = 0; op_index < total_op_count; op_index++) {
+    if (!pgsql_ops_[op_index]->is_active()) {
+      continue;
+    }
+    // Move active operator to the front by swapping the pointers.
+    if (op_index != active_count) {
+      std::swap(pgsql_ops_[active_count], pgsql_ops_[op_index]);
       if (has_sorting_order) {
-        std::swap(batch_row_orders_[left_iter], batch_row_orders_[right_iter]);
+        std::swap(batch_row_orders_[active_count], batch_row_orders_[op_index]);
       }
-    } else {
-      break;
     }
+    active_count++;
   }
 
   // Set active op count.
-  active_op_count_ = left_iter;
+  active_op_count_ = active_count;
 }
 
 Status PgDocOp::SendRequest(bool force_non_bufferable) {
@@ -391,11 +404,20 @@ Status PgDocReadOp::ExecuteInit(const PgExecParameters *exec_params) {
 }
 
 Result<std::list<PgDocResult>> PgDocReadOp::ProcessResponseImpl() {
-  // Process result from tablet server and check result status.
-  auto result = VERIFY_RESULT(ProcessResponseResult());
+  std::list<PgDocResult> result;
+  if (template_op_->request().has_sampling_state()) {
+    result = VERIFY_RESULT(ProcessSamplingResponse());
+  } else if (parallel_scan_) {
+    result = VERIFY_RESULT(ProcessParallelScanResponse());
+  } else {
+    // Process result from tablet server and check result status.
+    result = VERIFY_RESULT(ProcessResponseResult());
 
-  // Process paging state and check status.
-  RETURN_NOT_OK(ProcessResponseReadStates());
+    // Process paging state and check status.
+    RETURN_NOT_OK(ProcessResponseReadStates());
+  }
+
+  AdjustPrefetchLimit();
   return result;
 }
 
@@ -423,6 +445,12 @@ Status PgDocReadOp::CreateRequests() {
     // - Multiple requests for differrent hash permutations / keys.
     return PopulateNextHashPermutationOps();
 
+  } else if (IsParallelScanApplicable()) {
+    // Optimization for sequential scan of multiple partitions.
+    // - SELECT * FROM sql_table;
+    // - Multiple requests are created to scan partitions in parallel.
+    return PopulateParallelScanOps();
+
   } else {
     // No optimization.
     if (exec_params_.partition_key != nullptr) {
@@ -633,21 +661,7 @@ Status PgDocReadOp::PopulateParallelSelectCountOps() {
   // the following line?
   RETURN_NOT_OK(ClonePgsqlOps(table_->GetPartitionCount()));
   // Set "pararallelism_level_" to control how many operators can be sent at one time.
-  //
-  // TODO(neil) The calculation for this control variable should be applied to ALL operators, but
-  // the following calculation needs to be refined before it can be used for all statements.
-  auto parallelism_level = FLAGS_ysql_select_parallelism;
-  if (parallelism_level < 0) {
-    int tserver_count = VERIFY_RESULT(pg_session_->TabletServerCount(true /* primary_only */));
-
-    // Establish lower and upper bounds on parallelism.
-    int kMinParSelCountParallelism = 1;
-    int kMaxParSelCountParallelism = 16;
-    parallelism_level_ =
-      std::min(std::max(tserver_count * 2, kMinParSelCountParallelism), kMaxParSelCountParallelism);
-  } else {
-    parallelism_level_ = parallelism_level;
-  }
+  parallelism_level_ = VERIFY_RESULT(GetParallelismLevel());
 
   // Assign partitions to operators.
   const auto& partition_keys = table_->GetPartitions();
@@ -679,20 +693,181 @@ Status PgDocReadOp::PopulateParallelSelectCountOps() {
   return Status::OK();
 }
 
+Result<size_t> PgDocReadOp::GetParallelismLevel() {
+  // TODO(neil) The calculation for this control variable should be applied to ALL operators, but
+  // the following calculation needs to be refined before it can be used for all statements.
+  auto parallelism_level = FLAGS_ysql_select_parallelism;
+  if (parallelism_level < 0) {
+    int tserver_count = VERIFY_RESULT(pg_session_->TabletServerCount(true /* primary_only */));
+
+    // Establish lower and upper bounds on parallelism.
+    int kMinParSelCountParallelism = 1;
+    int kMaxParSelCountParallelism = 16;
+    return static_cast<size_t>(std::min(std::max(tserver_count * 2, kMinParSelCountParallelism),
+                                        kMaxParSelCountParallelism));
+  }
+  return static_cast<size_t>(std::max(parallelism_level, 1));
+}
+
+bool PgDocReadOp::IsParallelScanApplicable() {
+  if (!FLAGS_ysql_enable_parallel_scan || table_->GetPartitionCount() < 2) {
+    return false;
+  }
+
+  // Scans that are restricted by postgres to a part of the table, fetch a few rows only (LIMIT),
+  // lock rows or backfill an index are executed one partition at a time.
+  if (exec_params_.partition_key != nullptr || suppress_next_result_prefetching_ ||
+      exec_params_.is_index_backfill) {
+    return false;
+  }
+  const auto& req = template_op_->request();
+  if (req.has_index_request() || req.has_ybctid_column_value() || req.has_row_mark_type() ||
+      req.has_backfill_spec() || req.has_paging_state() || req.has_lower_bound() ||
+      req.has_upper_bound() || req.has_hash_code() || req.has_max_hash_code() ||
+      req.range_column_values_size() > 0) {
+    return false;
+  }
+
+  // For range partitioned table, key conditions could restrict the scan to a few partitions.
+  // Parallel requests would touch all of them, so use it for full scans only.
+  return table_->IsHashPartitioned() || !req.has_condition_expr();
+}
+
+Status PgDocReadOp::PopulateParallelScanOps() {
+  // Create batch operators, one per partition, to scan the table in parallel.
+  // TODO(tsplit): what if table partition is changed during PgDocReadOp lifecycle before or after
+  // the following line?
+  RETURN_NOT_OK(ClonePgsqlOps(table_->GetPartitionCount()));
+  max_parallelism_level_ = VERIFY_RESULT(GetParallelismLevel());
+  parallelism_level_ = max_parallelism_level_;
+
+  const auto& partition_keys = table_->GetPartitions();
+  SCHECK_EQ(partition_keys.size(), pgsql_ops_.size(), IllegalState,
+            "Number of partitions and number of partition keys are not the same");
+
+  // Operators are ordered the same way as a single request would visit partitions, so the first
+  // active operator always scans the partition whose rows should be returned next.
+  const bool is_forward_scan = template_op_->request().is_forward_scan();
+  for (size_t op_index = 0; op_index < partition_keys.size(); op_index++) {
+    const size_t partition =
+        is_forward_scan ? op_index : partition_keys.size() - 1 - op_index;
+    pgsql_ops_[op_index]->set_active(true);
+
+    string upper_bound;
+    if (partition < partition_keys.size() - 1) {
+      upper_bound = partition_keys[partition + 1];
+    }
+    RETURN_NOT_OK(table_->SetScanBoundary(GetReadOp(op_index)->mutable_request(),
+                                          partition_keys[partition],
+                                          true /* lower_bound_is_inclusive */,
+                                          upper_bound,
+                                          false /* upper_bound_is_inclusive */));
+  }
+  active_op_count_ = partition_keys.size();
+  parallel_scan_ = true;
+  // Sequential scan of hash partitioned table does not guarantee any order of rows, so there is
+  // no need to return them partition by partition.
+  parallel_scan_ordered_ = !table_->IsHashPartitioned();
+  if (parallel_scan_ordered_) {
+    // Completed operators are moved outside of the active range, so the order of rows is
+    // remembered separately.
+    parallel_scan_order_.clear();
+    parallel_scan_order_.reserve(pgsql_ops_.size());
+    for (const auto& pgsql_op : pgsql_ops_) {
+      parallel_scan_order_.push_back(pgsql_op.get());
+    }
+    parallel_scan_next_ = 0;
+  }
+  request_population_completed_ = true;
+
+  return Status::OK();
+}
+
+Result<std::list<PgDocResult>> PgDocReadOp::ProcessParallelScanResponse() {
+  const auto send_count = std::min(parallelism_level_, active_op_count_);
+  std::list<PgDocResult> result;
+  rows_affected_count_ = 0;
+  size_t received_bytes = 0;
+  for (size_t op_index = 0; op_index < send_count; op_index++) {
+    RETURN_NOT_OK(pg_session_->HandleResponse(*pgsql_ops_[op_index], PgObjectId()));
+
+    YBPgsqlOp *pgsql_op = pgsql_ops_[op_index].get();
+    rows_affected_count_ += pgsql_op->response().rows_affected_count();
+
+    const auto size = pgsql_op->mutable_rows_data()->size();
+    if (size > 0 && !parallel_scan_ordered_) {
+      result.emplace_back(pgsql_op->rows_data());
+    } else if (size > 0) {
+      auto& buffer = parallel_scan_buffers_[pgsql_op];
+      buffer.rows.emplace_back(pgsql_op->rows_data());
+      buffer.bytes += size;
+      parallel_scan_buffered_bytes_ += size;
+      received_bytes += size;
+    }
+  }
+
+  RETURN_NOT_OK(ProcessResponseReadStates());
+
+  // Unordered scan returns rows of all operators right away.
+  if (!parallel_scan_ordered_) {
+    VLOG(3) << __func__ << ": returning " << result.size() << " results";
+    return result;
+  }
+
+  // Return rows of the first unfinished operator, and of the following ones as long as all
+  // operators before them are completed. Operators that completed ahead of their turn are no
+  // longer sent, so they are visited in partition order rather than in the order of this round.
+  for (; parallel_scan_next_ < parallel_scan_order_.size(); ++parallel_scan_next_) {
+    const auto* pgsql_op = parallel_scan_order_[parallel_scan_next_];
+    auto it = parallel_scan_buffers_.find(pgsql_op);
+    if (it != parallel_scan_buffers_.end()) {
+      result.splice(result.end(), it->second.rows);
+      parallel_scan_buffered_bytes_ -= it->second.bytes;
+      parallel_scan_buffers_.erase(it);
+    }
+    if (pgsql_op->is_active()) {
+      break;
+    }
+  }
+
+  // Bound the memory used by held rows. Rows of the first operator are returned right away, so
+  // it is always sent, and other operators are sent only while their expected response fits into
+  // the remaining budget.
+  if (received_bytes > 0) {
+    const size_t average_bytes = std::max<size_t>(received_bytes / send_count, 1);
+    const size_t budget = FLAGS_ysql_parallel_scan_max_buffered_bytes;
+    const size_t available_bytes =
+        budget > parallel_scan_buffered_bytes_ ? budget - parallel_scan_buffered_bytes_ : 0;
+    parallelism_level_ = std::min(1 + available_bytes / average_bytes, max_parallelism_level_);
+  }
+  VLOG(3) << __func__ << ": returning " << result.size() << " results, holding "
+          << parallel_scan_buffered_bytes_ << " bytes, next parallelism level "
+          << parallelism_level_;
+
+  return result;
+}
+
 Status PgDocReadOp::PopulateSamplingOps() {
   // Create one PgsqlOp per partition
   RETURN_NOT_OK(ClonePgsqlOps(table_->GetPartitionCount()));
-  // Partitions are sampled sequentially, one at a time
-  parallelism_level_ = 1;
+  // Partitions are sampled in parallel, each one into its own reservoir.
+  parallelism_level_ = VERIFY_RESULT(GetParallelismLevel());
   // Assign partitions to operators.
   const auto& partition_keys = table_->GetPartitions();
   SCHECK_EQ(partition_keys.size(), pgsql_ops_.size(), IllegalState,
             "Number of partitions and number of partition keys are not the same");
 
+  // Random generator used to pick random state of the partition samplers and to merge their
+  // reservoirs. It is seeded by postgres, so setseed() makes ANALYZE repeatable.
+  sample_random_.seed(template_op_->request().sampling_state().rand_state());
+  constexpr uint64_t kRandStateMask = (1ULL << 48) - 1;
+
   // Bind requests to partitions
   for (size_t partition = 0; partition < partition_keys.size(); partition++) {
     // Construct a new YBPgsqlReadOp.
     pgsql_ops_[partition]->set_active(true);
+    GetReadOp(partition)->mutable_request()->mutable_sampling_state()->set_rand_state(
+        sample_random_() & kRandStateMask);
 
     // Use partition index to setup the protobuf to identify the partition that this request
     // is for. Batcher will use this information to send the request to correct tablet server, and
@@ -711,14 +886,115 @@ Status PgDocReadOp::PopulateSamplingOps() {
   }
   active_op_count_ = partition_keys.size();
   VLOG(1) << "Number of partitions to sample: " << active_op_count_;
-  // If we have big enough sample after processing some partitions we skip the rest.
-  // By shuffling partitions we randomly select the partition(s) to sample.
-  std::random_shuffle(pgsql_ops_.begin(), pgsql_ops_.end());
   request_population_completed_ = true;
 
   return Status::OK();
 }
 
+Result<std::list<PgDocResult>> PgDocReadOp::ProcessSamplingResponse() {
+  // Remember the sent operators, since completed operators are moved outside while processing
+  // paging state.
+  const auto send_count = std::min(parallelism_level_, active_op_count_);
+  const auto targrows = template_op_->request().sampling_state().targrows();
+  std::vector<const YBPgsqlOp*> sent_ops;
+  sent_ops.reserve(send_count);
+
+  for (size_t op_index = 0; op_index < send_count; op_index++) {
+    RETURN_NOT_OK(pg_session_->HandleResponse(*pgsql_ops_[op_index], PgObjectId()));
+
+    YBPgsqlOp *pgsql_op = pgsql_ops_[op_index].get();
+    sent_ops.push_back(pgsql_op);
+
+    // Update reservoir of the partition with newly selected rows.
+    auto& reservoir = partition_samples_[pgsql_op];
+    if (reservoir.empty()) {
+      reservoir.resize(targrows);
+    }
+    if (!pgsql_op->mutable_rows_data()->empty()) {
+      PgDocResult rows(pgsql_op->rows_data());
+      RETURN_NOT_OK(rows.ProcessSparseSystemColumns(reservoir.data()));
+    }
+  }
+
+  RETURN_NOT_OK(ProcessResponseReadStates());
+
+  // Merge reservoirs of completed partitions into the table sample.
+  for (const auto* pgsql_op : sent_ops) {
+    if (pgsql_op->is_active()) {
+      continue;
+    }
+    auto it = partition_samples_.find(pgsql_op);
+    const auto& sampling_state = pgsql_op->response().sampling_state();
+    it->second.resize(std::min(std::max(sampling_state.numrows(), 0), targrows));
+    MergeSample(&it->second, sampling_state.samplerows());
+    partition_samples_.erase(it);
+  }
+
+  // Return the table sample as (index, ybctid) pairs, the same way DocDB returns reservoir
+  // updates, once after the last partition is completed. Nothing is returned before that, the
+  // caller keeps reading until the end of data.
+  std::list<PgDocResult> result;
+  if (end_of_data_ && !sample_.empty()) {
+    faststring buffer;
+    PgWire::WriteInt64(sample_.size(), &buffer);
+    QLValuePB index;
+    QLValuePB ybctid;
+    for (size_t i = 0; i < sample_.size(); i++) {
+      index.set_int32_value(narrow_cast<int32_t>(i));
+      RETURN_NOT_OK(WriteColumn(index, &buffer));
+      ybctid.set_binary_value(sample_[i]);
+      RETURN_NOT_OK(WriteColumn(ybctid, &buffer));
+    }
+    result.emplace_back(buffer.ToString());
+  }
+  VLOG(1) << "Sampled " << sample_.size() << " of " << sample_rows_ << " rows, "
+          << active_op_count_ << " partitions left";
+
+  return result;
+}
+
+void PgDocReadOp::MergeSample(std::vector<std::string>* partition_sample, double partition_rows) {
+  // Both the table sample and the partition sample are uniform samples of their rows, of size
+  // targrows or all rows if there are fewer rows. Merged sample is a uniform sample of the rows
+  // of both, where the number of items taken from each sample follows hypergeometric
+  // distribution over the row counts.
+  const size_t targrows = template_op_->request().sampling_state().targrows();
+  if (sample_.size() + partition_sample->size() <= targrows) {
+    // Both samples contain all rows.
+    std::move(partition_sample->begin(), partition_sample->end(), std::back_inserter(sample_));
+    sample_rows_ += partition_rows;
+    return;
+  }
+
+  std::uniform_real_distribution<double> fraction(0.0, 1.0);
+  double table_rows_left = sample_rows_;
+  double partition_rows_left = partition_rows;
+  size_t take_from_partition = 0;
+  for (size_t i = 0; i < targrows; i++) {
+    if (fraction(sample_random_) * (table_rows_left + partition_rows_left) < partition_rows_left) {
+      ++take_from_partition;
+      partition_rows_left -= 1;
+    } else {
+      table_rows_left -= 1;
+    }
+  }
+  take_from_partition = std::min(take_from_partition, partition_sample->size());
+  const size_t take_from_table = std::min(targrows - take_from_partition, sample_.size());
+
+  // Pick random subsets of both samples by partial Fisher-Yates shuffle.
+  auto pick = [this](std::vector<std::string>* items, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      std::uniform_int_distribution<size_t> position(i, items->size() - 1);
+      std::swap((*items)[i], (*items)[position(sample_random_)]);
+    }
+    items->resize(count);
+  };
+  pick(&sample_, take_from_table);
+  pick(partition_sample, take_from_partition);
+  std::move(partition_sample->begin(), partition_sample->end(), std::back_inserter(sample_));
+  sample_rows_ += partition_rows;
+}
+
 Status PgDocReadOp::GetEstimatedRowCount(double *liverows, double *deadrows) {
   if (liverows != nullptr) {
     // Return estimated number of live tuples
@@ -834,21 +1110,9 @@ Status PgDocReadOp::ProcessResponseReadStates() {
         // the next block.
         PgsqlReadRequestPB *req = read_op->mutable_request();
         *req->mutable_sampling_state() = std::move(*res.mutable_sampling_state());
-      } else {
-        // Partition sampling is completed.
-        // If samplerows is greater than or equal to targrows the sampling is complete. There are
-        // enough rows selected to calculate stats and we can estimate total number of rows in the
-        // table by extrapolating samplerows to the partitions that have not been scanned.
-        // If samplerows is less than targrows next partition needs to be sampled. Next pgdoc_op
-        // already has sampling state copied from the template_op_, only couple fields need to be
-        // updated: numrows and samplerows. The targrows never changes, and in reservoir population
-        // phase (before samplerows reaches targrows) 1. numrows and samplerows are always equal;
-        // and 2. random numbers never generated, so random state remains the same.
-        // That essentially means the only thing we need to collect from the partition's final
-        // sampling state is the samplerows. We use that number to either estimate liverows, or to
-        // update numrows and samplerows in next partition's sampling state.
-        sample_rows_ = res.mutable_sampling_state()->samplerows();
       }
+      // Otherwise partition sampling is completed, and its final sampling state is left in the
+      // response for ProcessSamplingResponse() to merge the partition reservoir.
     }
 
     if (has_more_arg) {
@@ -868,28 +1132,6 @@ Status PgDocReadOp::ProcessResponseReadStates() {
     end_of_data_ = request_population_completed_;
   }
 
-  if (active_op_count_ > 0 && template_op_->request().has_sampling_state()) {
-    PgsqlReadRequestPB *req = GetReadOp(0)->mutable_request();
-    if (!req->has_paging_state()) {
-      // Current sampling op without paging state means that previous one was completed and moved
-      // outside.
-      auto sampling_state = req->mutable_sampling_state();
-      if (sample_rows_ < sampling_state->targrows()) {
-        // More sample rows are needed, update sampling state and let next partition be scanned
-        VLOG(1) << "Continue sampling next partition from " << sample_rows_;
-        sampling_state->set_numrows(static_cast<int32>(sample_rows_));
-        sampling_state->set_samplerows(sample_rows_);
-      } else {
-        // Have enough of sample rows, estimate total table rows assuming they are evenly
-        // distributed between partitions
-        auto completed_ops = pgsql_ops_.size() - active_op_count_;
-        sample_rows_ = floor((sample_rows_ / completed_ops) * pgsql_ops_.size() + 0.5);
-        VLOG(1) << "Done sampling, prorated rowcount is " << sample_rows_;
-        end_of_data_ = true;
-      }
-    }
-  }
-
   return Status::OK();
 }
 
@@ -915,13 +1157,57 @@ void PgDocReadOp::SetRequestPrefetchLimit() {
     limit = predicted_limit;
     suppress_next_result_prefetching_ = false;
   }
+
+  // Adaptive prefetch could grow the limit later, but not above the statement LIMIT.
+  prefetch_limit_ = limit;
+  max_prefetch_limit_ = limit;
+  if (FLAGS_ysql_adaptive_prefetch && !suppress_next_result_prefetching_) {
+    uint64_t adaptive_limit = FLAGS_ysql_adaptive_prefetch_max_limit;
+    if (!req->is_forward_scan()) {
+      adaptive_limit =
+          static_cast<uint64_t>(adaptive_limit * FLAGS_ysql_backward_prefetch_scale_factor);
+    }
+    max_prefetch_limit_ = std::max<uint64_t>(limit, adaptive_limit);
+    if (!exec_params_.limit_use_default) {
+      max_prefetch_limit_ = std::min<uint64_t>(
+          max_prefetch_limit_, exec_params_.limit_count + exec_params_.limit_offset);
+    }
+  }
   VLOG(3) << __func__
           << " exec_params_.limit_count=" << exec_params_.limit_count
           << " exec_params_.limit_offset=" << exec_params_.limit_offset
           << " exec_params_.limit_use_default=" << exec_params_.limit_use_default
           << " predicted_limit=" << predicted_limit
-          << " limit=" << limit;
+          << " limit=" << limit
+          << " max_prefetch_limit=" << max_prefetch_limit_;
   req->set_limit(limit);
+
+  // Bound the size of each response, so wide rows don't make prefetched pages huge.
+  if (FLAGS_ysql_prefetch_size_limit_bytes > 0) {
+    req->set_size_limit(FLAGS_ysql_prefetch_size_limit_bytes);
+  } else {
+    req->clear_size_limit();
+  }
+}
+
+void PgDocReadOp::AdjustPrefetchLimit() {
+  // Postgres waited for the prefetched rows, so it consumes rows faster than they are fetched.
+  // Bigger pages would save round trips, while response size is still bounded by size_limit.
+  if (!waited_for_prefetched_response_ || end_of_data_ || prefetch_limit_ >= max_prefetch_limit_) {
+    return;
+  }
+  // Limit has different meaning for sampling and does not matter for aggregates.
+  const auto& req = template_op_->request();
+  if (req.has_sampling_state() || req.is_aggregate()) {
+    return;
+  }
+  prefetch_limit_ = std::min(prefetch_limit_ * 2, max_prefetch_limit_);
+  VLOG(3) << __func__ << " prefetch_limit=" << prefetch_limit_;
+
+  template_op_->mutable_request()->set_limit(prefetch_limit_);
+  for (size_t op_index = 0; op_index < active_op_count_; op_index++) {
+    GetReadOp(op_index)->mutable_request()->set_limit(prefetch_limit_);
+  }
 }
 
 void PgDocReadOp::SetRowMark() {
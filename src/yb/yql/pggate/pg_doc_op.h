@@ -16,6 +16,11 @@
 #define YB_YQL_PGGATE_PG_DOC_OP_H_
 
 #include <deque>
+#include <list>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <boost/optional.hpp>
 
@@ -270,6 +275,7 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
   //   * This optimization is used by
   //       PopulateDmlByYbctidOps()
   //       PopulateParallelSelectCountOps()
+  //       PopulateParallelScanOps()
   // - When parallelism by arguments is applied, each operator has only one argument.
   //   When tablet server will run the requests in parallel as it assigned one thread per request.
   //       PopulateNextHashPermutationOps()
@@ -278,6 +284,7 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
   // Only active operators are kept in the active range [0, active_op_count_)
   // - Not execute operators that are outside of range [0, active_op_count_).
   // - Sort the operators in "pgsql_ops_" to move "inactive" operators to the end of the list.
+  // - Active operators keep their relative order.
   void MoveInactiveOpsOutside();
 
   // Clone READ or WRITE "template_op_" into new operators.
@@ -315,6 +322,12 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
   // Next request will be sent in case upper level will ask for additional data.
   bool suppress_next_result_prefetching_ = false;
 
+  // Whether the request in progress was sent ahead of upper level asking for more data.
+  bool response_prefetched_ = false;
+
+  // Whether upper level had to wait for the prefetched response while processing the last one.
+  bool waited_for_prefetched_response_ = false;
+
   // Populated protobuf request.
   std::vector<std::shared_ptr<client::YBPgsqlOp>> pgsql_ops_;
 
@@ -442,9 +455,38 @@ class PgDocReadOp : public PgDocOp {
   //     Create parallel request for SELECT COUNT().
   CHECKED_STATUS PopulateParallelSelectCountOps();
 
-  // Create one sampling operator per partition and arrange their execution in random order
+  // Create operators by partitions.
+  // - Optimization for sequential scan that is not restricted to a subset of partitions:
+  //     SELECT * FROM sql_table;
+  // - Partitions are scanned in parallel. For range partitioned table rows are returned in the
+  //   same order as they would be returned by scanning one partition after another.
+  CHECKED_STATUS PopulateParallelScanOps();
+
+  // Whether the request could be executed by PopulateParallelScanOps().
+  bool IsParallelScanApplicable();
+
+  // Number of operators to be sent at one time when partitions are read in parallel.
+  Result<size_t> GetParallelismLevel();
+
+  // Process response of parallel scan.
+  // - Rows of hash partitioned table are passed to the caller right away, in any order.
+  // - Rows of the partition being returned are passed to the caller right away.
+  // - Rows of the following partitions are held until all preceding partitions are completed.
+  // - Number of operators sent next time is reduced when held rows exceed their memory budget.
+  Result<std::list<PgDocResult>> ProcessParallelScanResponse();
+
+  // Create one sampling operator per partition, partitions are sampled in parallel.
   CHECKED_STATUS PopulateSamplingOps();
 
+  // Process response of sampling operators.
+  // - Each partition collects its own reservoir, updated from the partition responses.
+  // - When partition is completed, its reservoir is merged into the table sample.
+  // - The table sample is returned to the caller once, when the last partition is completed.
+  Result<std::list<PgDocResult>> ProcessSamplingResponse();
+
+  // Merge sample of partition_rows rows of a completed partition into sample_.
+  void MergeSample(std::vector<std::string>* partition_sample, double partition_rows);
+
   // Set partition boundaries to a given partition.
   CHECKED_STATUS SetScanPartitionBoundary();
 
@@ -460,6 +502,10 @@ class PgDocReadOp : public PgDocOp {
   // Analyze options and pick the appropriate prefetch limit.
   void SetRequestPrefetchLimit();
 
+  // Grow the prefetch limit of active operators when postgres consumes rows faster than they are
+  // fetched.
+  void AdjustPrefetchLimit();
+
   // Set the backfill_spec field of our read request.
   void SetBackfillSpec();
 
@@ -487,11 +533,19 @@ class PgDocReadOp : public PgDocOp {
   // Template operation, used to fill in pgsql_ops_ by either assigning or cloning.
   std::shared_ptr<client::YBPgsqlReadOp> template_op_;
 
-  // While sampling is in progress, number of scanned row is accumulated in this variable.
-  // After completion the value is extrapolated to account for not scanned partitions and estimate
+  // Number of rows in the partitions that were completely sampled. After completion it is the
   // total number of rows in the table.
   double sample_rows_ = 0;
 
+  // Uniform sample of up to targrows ybctids from the partitions that were completely sampled.
+  std::vector<std::string> sample_;
+
+  // Reservoirs of the partitions being sampled.
+  std::unordered_map<const client::YBPgsqlOp*, std::vector<std::string>> partition_samples_;
+
+  // Random generator for sampling, seeded with random state provided by postgres.
+  std::mt19937_64 sample_random_;
+
   // Used internally for PopulateNextHashPermutationOps to keep track of which permutation should
   // be used to construct the next read_op.
   // Is valid as long as request_population_completed_ is false.
@@ -512,6 +566,35 @@ class PgDocReadOp : public PgDocOp {
   // For a query clause "h1 = 1 AND h2 IN (2,3) AND h3 IN (4,5,6) AND h4 = 7",
   // this will be initialized to [[1], [2, 3], [4, 5, 6], [7]]
   std::vector<std::vector<const PgsqlExpressionPB*>> partition_exprs_;
+
+  // Number of rows requested by each operator, and the limit it could be grown to by
+  // AdjustPrefetchLimit().
+  uint64_t prefetch_limit_ = 0;
+  uint64_t max_prefetch_limit_ = 0;
+
+  // Whether operators were created by PopulateParallelScanOps().
+  bool parallel_scan_ = false;
+
+  // Whether parallel scan should return rows in the order of partitions.
+  bool parallel_scan_ordered_ = false;
+
+  // Upper limit on parallelism_level_ during parallel scan, it is lowered when held rows are big.
+  size_t max_parallelism_level_ = 1;
+
+  // Rows received by parallel scan operators ahead of their turn to be returned.
+  struct ParallelScanBuffer {
+    std::list<PgDocResult> rows;
+    size_t bytes = 0;
+  };
+  std::unordered_map<const client::YBPgsqlOp*, ParallelScanBuffer> parallel_scan_buffers_;
+
+  // Operators of ordered parallel scan in the order of their partitions, and the index of the
+  // first one whose rows were not returned completely.
+  std::vector<const client::YBPgsqlOp*> parallel_scan_order_;
+  size_t parallel_scan_next_ = 0;
+
+  // Total size of rows in parallel_scan_buffers_.
+  size_t parallel_scan_buffered_bytes_ = 0;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -39,6 +39,10 @@ class PgInsert : public PgDmlWrite {
     write_req_->set_is_backfill(is_backfill);
   }
 
+  void SetIsBulkLoad(const bool is_bulk_load) {
+    write_req_->set_is_bulk_load(is_bulk_load);
+  }
+
  private:
   std::unique_ptr<client::YBPgsqlWriteOp> AllocWriteOperation() const override {
     return target_->NewPgsqlInsert();
@@ -332,6 +332,11 @@ bool PgSessionAsyncRunResult::InProgress() const {
   return future_status_.valid();
 }
 
+bool PgSessionAsyncRunResult::Ready() const {
+  return InProgress() &&
+         future_status_.wait_for(std::chrono::seconds::zero()) == std::future_status::ready;
+}
+
 //--------------------------------------------------------------------------------------------------
 // Class PgSession::RunHelper
 //--------------------------------------------------------------------------------------------------
@@ -827,13 +832,22 @@ Result<PgTableDescPtr> PgSession::LoadTable(const PgObjectId& table_id) {
   }
 
   VLOG(4) << "Table cache MISS: " << table_id;
-  auto table = VERIFY_RESULT(pg_client_.OpenTable(table_id));
+  // Shared catalog version is updated by tablet server heartbeats, so it could be behind the
+  // version of the last cache refresh.
+  auto catalog_version = catalog_version_;
+  auto shared_catalog_version = GetSharedCatalogVersion();
+  if (shared_catalog_version.ok()) {
+    catalog_version = std::max(catalog_version, *shared_catalog_version);
+  }
+  const bool reload = invalidated_table_ids_.erase(table_id) != 0;
+  auto table = VERIFY_RESULT(pg_client_.OpenTable(table_id, reload, catalog_version));
   table_cache_.emplace(table_id, table);
   return table;
 }
 
 void PgSession::InvalidateTableCache(const PgObjectId& table_id) {
   table_cache_.erase(table_id);
+  invalidated_table_ids_.insert(table_id);
 }
 
 Status PgSession::StartOperationsBuffering() {
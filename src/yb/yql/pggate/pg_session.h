@@ -74,6 +74,8 @@ class PgSessionAsyncRunResult {
                           client::YBSessionPtr session);
   CHECKED_STATUS GetStatus(PgSession* session);
   bool InProgress() const;
+  // Whether GetStatus could be called without waiting for the response.
+  bool Ready() const;
 
  private:
   // buffered_operations_ holds buffered operations (if any) which were applied to
@@ -288,8 +290,10 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
     return GenerateObjectId(true /* binary_id */);
   }
 
-  void InvalidateCache() {
+  void InvalidateCache(uint64_t catalog_version) {
     table_cache_.clear();
+    invalidated_table_ids_.clear();
+    catalog_version_ = std::max(catalog_version_, catalog_version);
   }
 
   void InvalidateForeignKeyReferenceCache() {
@@ -409,6 +413,11 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   string errmsg_;
 
   std::unordered_map<PgObjectId, PgTableDescPtr, PgObjectIdHash> table_cache_;
+  // Tables that were explicitly invalidated, their info cached by the tablet server should be
+  // reloaded as well.
+  std::unordered_set<PgObjectId, PgObjectIdHash> invalidated_table_ids_;
+  // Catalog version of the last cache refresh.
+  uint64_t catalog_version_ = 0;
   boost::unordered_set<PgForeignKeyReference> fk_reference_cache_;
   boost::unordered_set<PgForeignKeyReference> fk_reference_intent_;
 
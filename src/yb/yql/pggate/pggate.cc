@@ -310,8 +310,8 @@ Status PgApiImpl::InitSession(const PgEnv *pg_env,
   return Status::OK();
 }
 
-Status PgApiImpl::InvalidateCache() {
-  pg_session_->InvalidateCache();
+Status PgApiImpl::InvalidateCache(uint64_t catalog_version) {
+  pg_session_->InvalidateCache(catalog_version);
   return Status::OK();
 }
 
@@ -913,6 +913,17 @@ Status PgApiImpl::DmlBindColumnCondIn(PgStatement *handle, int attr_num, int n_a
   return down_cast<PgDmlRead*>(handle)->BindColumnCondIn(attr_num, n_attr_values, attr_values);
 }
 
+Status PgApiImpl::DmlBindBatchedKeys(PgStatement *handle, int n_keys, int n_attrs,
+    const int *attr_nums, PgExpr **attr_values) {
+  return down_cast<PgDmlRead*>(handle)->BindBatchedKeys(n_keys, n_attrs, attr_nums, attr_values);
+}
+
+Result<int64_t> PgApiImpl::DmlGetBatchedKeyIndex(PgStatement *handle) {
+  const auto row_order = down_cast<PgDml*>(handle)->last_row_order();
+  SCHECK_GE(row_order, 0, IllegalState, "No row of a batched key was fetched");
+  return row_order;
+}
+
 Status PgApiImpl::DmlBindHashCode(PgStatement *handle, bool start_valid,
                                     bool start_inclusive,
                                     uint64_t start_hash_val, bool end_valid,
@@ -1100,6 +1111,15 @@ Status PgApiImpl::InsertStmtSetIsBackfill(PgStatement *handle, const bool is_bac
   return Status::OK();
 }
 
+Status PgApiImpl::InsertStmtSetIsBulkLoad(PgStatement *handle, const bool is_bulk_load) {
+  if (!PgStatement::IsValidStmt(handle, StmtOp::STMT_INSERT)) {
+    // Invalid handle.
+    return STATUS(InvalidArgument, "Invalid statement handle");
+  }
+  down_cast<PgInsert*>(handle)->SetIsBulkLoad(is_bulk_load);
+  return Status::OK();
+}
+
 // Update ------------------------------------------------------------------------------------------
 
 Status PgApiImpl::NewUpdate(const PgObjectId& table_id,
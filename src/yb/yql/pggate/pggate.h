@@ -125,7 +125,7 @@ class PgApiImpl {
   CHECKED_STATUS GetTabledescFromCurrentPgMemctx(size_t table_desc_id, PgTableDesc **handle);
 
   // Invalidate the sessions table cache.
-  CHECKED_STATUS InvalidateCache();
+  CHECKED_STATUS InvalidateCache(uint64_t catalog_version);
 
   // Get the gflag TEST_ysql_disable_transparent_cache_refresh_retry.
   bool GetDisableTransparentCacheRefreshRetry();
@@ -359,6 +359,9 @@ class PgApiImpl {
       YBCPgExpr attr_value_end);
   CHECKED_STATUS DmlBindColumnCondIn(YBCPgStatement handle, int attr_num, int n_attr_values,
       YBCPgExpr *attr_value);
+  CHECKED_STATUS DmlBindBatchedKeys(YBCPgStatement handle, int n_keys, int n_attrs,
+      const int *attr_nums, YBCPgExpr *attr_values);
+  Result<int64_t> DmlGetBatchedKeyIndex(YBCPgStatement handle);
 
   CHECKED_STATUS DmlBindHashCode(PgStatement *handle, bool start_valid,
                                 bool start_inclusive, uint64_t start_hash_val,
@@ -420,6 +423,8 @@ class PgApiImpl {
 
   CHECKED_STATUS InsertStmtSetIsBackfill(PgStatement *handle, const bool is_backfill);
 
+  CHECKED_STATUS InsertStmtSetIsBulkLoad(PgStatement *handle, const bool is_bulk_load);
+
   //------------------------------------------------------------------------------------------------
   // Update.
   CHECKED_STATUS NewUpdate(const PgObjectId& table_id,
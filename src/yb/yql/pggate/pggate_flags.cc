@@ -18,8 +18,11 @@
 #include <gflags/gflags.h>
 
 #include "yb/util/flag_tags.h"
+#include "yb/util/size_literals.h"
 #include "yb/yql/pggate/pggate_flags.h"
 
+using namespace yb::size_literals;
+
 DEFINE_int32(pgsql_rpc_keepalive_time_ms, 0,
              "If an RPC connection from a client is idle for this amount of time, the server "
              "will disconnect the client. Setting flag to 0 disables this clean up.");
@@ -48,7 +51,26 @@ DEFINE_int32(ysql_request_limit, 1024,
              "Maximum number of requests to be sent at once");
 
 DEFINE_uint64(ysql_prefetch_limit, 1024,
-              "Maximum number of rows to prefetch");
+              "Maximum number of rows to prefetch. When ysql_adaptive_prefetch is enabled, it is "
+              "the number of rows to prefetch by the first request of a scan.");
+
+DEFINE_bool(ysql_adaptive_prefetch, true,
+            "Whether the number of rows to prefetch should grow above ysql_prefetch_limit, up to "
+            "ysql_adaptive_prefetch_max_limit, while postgres consumes rows faster than they "
+            "are fetched.");
+TAG_FLAG(ysql_adaptive_prefetch, runtime);
+TAG_FLAG(ysql_adaptive_prefetch, advanced);
+
+DEFINE_uint64(ysql_adaptive_prefetch_max_limit, 16384,
+              "Maximum number of rows to prefetch when adaptive prefetch is enabled.");
+TAG_FLAG(ysql_adaptive_prefetch_max_limit, runtime);
+TAG_FLAG(ysql_adaptive_prefetch_max_limit, advanced);
+
+DEFINE_uint64(ysql_prefetch_size_limit_bytes, 4_MB,
+              "Maximum size of rows to prefetch by a single request. The last row could exceed "
+              "the limit. 0 means no limit.");
+TAG_FLAG(ysql_prefetch_size_limit_bytes, runtime);
+TAG_FLAG(ysql_prefetch_size_limit_bytes, advanced);
 
 DEFINE_double(ysql_backward_prefetch_scale_factor, 0.0625 /* 1/16th */,
               "Scale factor to reduce ysql_prefetch_limit for backward scan");
@@ -112,6 +134,19 @@ DEFINE_int32(ysql_select_parallelism, -1,
             "Number of read requests to issue in parallel to tablets of a table "
             "for SELECT.");
 
+DEFINE_bool(ysql_enable_parallel_scan, false,
+            "Whether sequential scans of multi-tablet tables should read several tablets in "
+            "parallel. Rows of range partitioned tables are still returned in the same order as "
+            "by tablet by tablet scan.");
+TAG_FLAG(ysql_enable_parallel_scan, runtime);
+TAG_FLAG(ysql_enable_parallel_scan, advanced);
+
+DEFINE_uint64(ysql_parallel_scan_max_buffered_bytes, 16_MB,
+              "Limit on the size of rows that parallel scan could receive ahead of the tablet "
+              "being returned to postgres. Fewer tablets are read in parallel when rows are big.");
+TAG_FLAG(ysql_parallel_scan_max_buffered_bytes, runtime);
+TAG_FLAG(ysql_parallel_scan_max_buffered_bytes, advanced);
+
 DEFINE_int32(ysql_max_write_restart_attempts, 20,
              "Max number of restart attempts made for writes on transaction conflicts.");
 
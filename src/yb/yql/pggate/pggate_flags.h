@@ -25,6 +25,9 @@ DECLARE_int32(pggate_tserver_shm_fd);
 DECLARE_bool(TEST_pggate_ignore_tserver_shm);
 DECLARE_int32(ysql_request_limit);
 DECLARE_uint64(ysql_prefetch_limit);
+DECLARE_bool(ysql_adaptive_prefetch);
+DECLARE_uint64(ysql_adaptive_prefetch_max_limit);
+DECLARE_uint64(ysql_prefetch_size_limit_bytes);
 DECLARE_double(ysql_backward_prefetch_scale_factor);
 DECLARE_uint64(ysql_session_max_batch_size);
 DECLARE_bool(ysql_non_txn_copy);
@@ -34,6 +37,8 @@ DECLARE_int64(TEST_inject_delay_between_prepare_ybctid_execute_batch_ybctid_ms);
 DECLARE_bool(TEST_index_read_multiple_partitions);
 DECLARE_int32(ysql_output_buffer_size);
 DECLARE_int32(ysql_select_parallelism);
+DECLARE_bool(ysql_enable_parallel_scan);
+DECLARE_uint64(ysql_parallel_scan_max_buffered_bytes);
 DECLARE_int32(ysql_sequence_cache_minval);
 
 DECLARE_bool(ysql_suppress_unsupported_error);
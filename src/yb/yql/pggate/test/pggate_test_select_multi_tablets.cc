@@ -281,5 +281,115 @@ TEST_F(PggateTestSelectMultiTablets, TestSelectMultiTablets) {
   pg_stmt = nullptr;
 }
 
+TEST_F(PggateTestSelectMultiTablets, TestSelectBatchedKeys) {
+  CHECK_OK(Init("TestSelectBatchedKeys"));
+
+  const char *tabname = "batched_keys_table";
+  const YBCPgOid tab_oid = 3;
+  YBCPgStatement pg_stmt;
+
+  // Create table in the connected database.
+  int col_count = 0;
+  CHECK_YBC_STATUS(YBCPgNewCreateTable(kDefaultDatabase, kDefaultSchema, tabname,
+                                       kDefaultDatabaseOid, tab_oid,
+                                       false /* is_shared_table */, true /* if_not_exist */,
+                                       false /* add_primary_key */, true /* colocated */,
+                                       kInvalidOid /* tablegroup_id */,
+                                       kInvalidOid /* tablespace_id */,
+                                       &pg_stmt));
+  CHECK_YBC_STATUS(YBCTestCreateTableAddColumn(pg_stmt, "hash_key", ++col_count,
+                                             DataType::INT64, true, true));
+  CHECK_YBC_STATUS(YBCTestCreateTableAddColumn(pg_stmt, "id", ++col_count,
+                                             DataType::INT32, false, true));
+  CHECK_YBC_STATUS(YBCTestCreateTableAddColumn(pg_stmt, "project_count", ++col_count,
+                                             DataType::INT32, false, false));
+  CHECK_YBC_STATUS(YBCPgExecCreateTable(pg_stmt));
+  pg_stmt = nullptr;
+
+  // INSERT ----------------------------------------------------------------------------------------
+  CHECK_YBC_STATUS(YBCPgNewInsert(kDefaultDatabaseOid, tab_oid,
+                                  false /* is_single_row_txn */, &pg_stmt));
+  int seed = 1;
+  YBCPgExpr expr_hash;
+  CHECK_YBC_STATUS(YBCTestNewConstantInt8(pg_stmt, seed, false, &expr_hash));
+  YBCPgExpr expr_id;
+  CHECK_YBC_STATUS(YBCTestNewConstantInt4(pg_stmt, seed, false, &expr_id));
+  YBCPgExpr expr_projcnt;
+  CHECK_YBC_STATUS(YBCTestNewConstantInt4(pg_stmt, 100 + seed, false, &expr_projcnt));
+
+  int attr_num = 0;
+  CHECK_YBC_STATUS(YBCPgDmlBindColumn(pg_stmt, ++attr_num, expr_hash));
+  CHECK_YBC_STATUS(YBCPgDmlBindColumn(pg_stmt, ++attr_num, expr_id));
+  CHECK_YBC_STATUS(YBCPgDmlBindColumn(pg_stmt, ++attr_num, expr_projcnt));
+  CHECK_EQ(attr_num, col_count);
+
+  const int insert_row_count = 7;
+  for (int i = 0; i < insert_row_count; i++) {
+    BeginTransaction();
+    CHECK_YBC_STATUS(YBCPgExecInsert(pg_stmt));
+    CommitTransaction();
+
+    seed++;
+    CHECK_YBC_STATUS(YBCPgUpdateConstInt8(expr_hash, seed, false));
+    CHECK_YBC_STATUS(YBCPgUpdateConstInt4(expr_id, seed, false));
+    CHECK_YBC_STATUS(YBCPgUpdateConstInt4(expr_projcnt, 100 + seed, false));
+  }
+
+  pg_stmt = nullptr;
+
+  // SELECT ----------------------------------------------------------------------------------------
+  LOG(INFO) << "Test SELECTing batch of primary keys";
+  CHECK_YBC_STATUS(YBCPgNewSelect(kDefaultDatabaseOid, tab_oid,
+                                  NULL /* prepare_params */, &pg_stmt));
+
+  YBCPgExpr colref;
+  CHECK_YBC_STATUS(YBCTestNewColumnRef(pg_stmt, 1, DataType::INT64, &colref));
+  CHECK_YBC_STATUS(YBCPgDmlAppendTarget(pg_stmt, colref));
+  CHECK_YBC_STATUS(YBCTestNewColumnRef(pg_stmt, 2, DataType::INT32, &colref));
+  CHECK_YBC_STATUS(YBCPgDmlAppendTarget(pg_stmt, colref));
+  CHECK_YBC_STATUS(YBCTestNewColumnRef(pg_stmt, 3, DataType::INT32, &colref));
+  CHECK_YBC_STATUS(YBCPgDmlAppendTarget(pg_stmt, colref));
+
+  // Key 100 does not exist, so only rows for the keys with index 0, 2 and 3 are expected.
+  const std::vector<int> keys = {5, 100, 2, 7};
+  const int key_attr_nums[] = {1, 2};
+  std::vector<YBCPgExpr> key_values;
+  for (int key : keys) {
+    CHECK_YBC_STATUS(YBCTestNewConstantInt8(pg_stmt, key, false, &expr_hash));
+    key_values.push_back(expr_hash);
+    CHECK_YBC_STATUS(YBCTestNewConstantInt4(pg_stmt, key, false, &expr_id));
+    key_values.push_back(expr_id);
+  }
+  CHECK_YBC_STATUS(YBCPgDmlBindBatchedKeys(pg_stmt, static_cast<int>(keys.size()), 2,
+                                           key_attr_nums, key_values.data()));
+
+  BeginTransaction();
+  CHECK_YBC_STATUS(YBCPgExecSelect(pg_stmt, nullptr /* exec_params */));
+
+  uint64_t *values = static_cast<uint64_t*>(YBCPAlloc(col_count * sizeof(uint64_t)));
+  bool *isnulls = static_cast<bool*>(YBCPAlloc(col_count * sizeof(bool)));
+  const std::vector<int64_t> expected_key_indexes = {0, 2, 3};
+  for (int64_t expected_key_index : expected_key_indexes) {
+    bool has_data = false;
+    CHECK_YBC_STATUS(YBCPgDmlFetch(pg_stmt, col_count, values, isnulls, nullptr, &has_data));
+    CHECK(has_data) << "Not all batched keys are fetched";
+
+    int64_t key_index = -1;
+    CHECK_YBC_STATUS(YBCPgDmlGetBatchedKeyIndex(pg_stmt, &key_index));
+    CHECK_EQ(key_index, expected_key_index);
+
+    const int64_t id = keys[key_index];
+    CHECK_EQ(values[0], id);  // hash_key : int64
+    CHECK_EQ(values[1], id);  // id : int32
+    CHECK_EQ(values[2], 100 + id);  // project_count : int32
+  }
+  bool has_data = true;
+  CHECK_YBC_STATUS(YBCPgDmlFetch(pg_stmt, col_count, values, isnulls, nullptr, &has_data));
+  CHECK(!has_data) << "Unexpected row fetched";
+  CommitTransaction();
+
+  pg_stmt = nullptr;
+}
+
 } // namespace pggate
 } // namespace yb
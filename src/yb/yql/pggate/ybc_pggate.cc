@@ -173,8 +173,8 @@ void YBCPgDeleteStatement(YBCPgStatement handle) {
   pgapi->DeleteStatement(handle);
 }
 
-YBCStatus YBCPgInvalidateCache() {
-  return ToYBCStatus(pgapi->InvalidateCache());
+YBCStatus YBCPgInvalidateCache(uint64_t catalog_version) {
+  return ToYBCStatus(pgapi->InvalidateCache(catalog_version));
 }
 
 const YBCPgTypeEntity *YBCPgFindTypeEntity(int type_oid) {
@@ -598,6 +598,15 @@ YBCStatus YBCPgDmlBindColumnCondIn(YBCPgStatement handle, int attr_num, int n_at
   return ToYBCStatus(pgapi->DmlBindColumnCondIn(handle, attr_num, n_attr_values, attr_values));
 }
 
+YBCStatus YBCPgDmlBindBatchedKeys(YBCPgStatement handle, int n_keys, int n_attrs,
+                                  const int *attr_nums, YBCPgExpr *attr_values) {
+  return ToYBCStatus(pgapi->DmlBindBatchedKeys(handle, n_keys, n_attrs, attr_nums, attr_values));
+}
+
+YBCStatus YBCPgDmlGetBatchedKeyIndex(YBCPgStatement handle, int64_t *key_index) {
+  return ExtractValueFromResult(pgapi->DmlGetBatchedKeyIndex(handle), key_index);
+}
+
 YBCStatus YBCPgDmlBindHashCodes(YBCPgStatement handle, bool start_valid,
                                  bool start_inclusive, uint64_t start_hash_val,
                                  bool end_valid, bool end_inclusive,
@@ -709,6 +718,10 @@ YBCStatus YBCPgInsertStmtSetIsBackfill(YBCPgStatement handle, const bool is_back
   return ToYBCStatus(pgapi->InsertStmtSetIsBackfill(handle, is_backfill));
 }
 
+YBCStatus YBCPgInsertStmtSetIsBulkLoad(YBCPgStatement handle, const bool is_bulk_load) {
+  return ToYBCStatus(pgapi->InsertStmtSetIsBulkLoad(handle, is_bulk_load));
+}
+
 // UPDATE Operations -------------------------------------------------------------------------------
 YBCStatus YBCPgNewUpdate(const YBCPgOid database_oid,
                          const YBCPgOid table_oid,
@@ -52,7 +52,9 @@ YBCStatus YBCPgResetMemctx(YBCPgMemctx memctx);
 void YBCPgDeleteStatement(YBCPgStatement handle);
 
 // Invalidate the sessions table cache.
-YBCStatus YBCPgInvalidateCache();
+// catalog_version is the catalog version the cache is refreshed for, table info cached by the
+// tablet server for older versions is not used anymore.
+YBCStatus YBCPgInvalidateCache(uint64_t catalog_version);
 
 // Check if initdb has been already run.
 YBCStatus YBCPgIsInitDbDone(bool* initdb_done);
@@ -338,6 +340,16 @@ YBCStatus YBCPgDmlBindColumnCondIn(YBCPgStatement handle, int attr_num, int n_at
     YBCPgExpr *attr_values);
 YBCStatus YBCPgDmlGetColumnInfo(YBCPgStatement handle, int attr_num, YBCPgColumnInfo* info);
 
+// Batched lookup of primary keys, e.g. for the inner side of nested loop join.
+// - attr_nums lists n_attrs attributes, all primary key columns must be present.
+// - attr_values contains n_keys * n_attrs values, key by key, in the order of attr_nums.
+// All keys are read with one request per tablet. Rows are fetched in the order of keys, keys that
+// have no row are skipped. After fetching a row, YBCPgDmlGetBatchedKeyIndex returns the index of
+// its key in the batch, so the row could be matched to the outer row.
+YBCStatus YBCPgDmlBindBatchedKeys(YBCPgStatement handle, int n_keys, int n_attrs,
+                                  const int *attr_nums, YBCPgExpr *attr_values);
+YBCStatus YBCPgDmlGetBatchedKeyIndex(YBCPgStatement handle, int64_t *key_index);
+
 YBCStatus YBCPgDmlBindHashCodes(YBCPgStatement handle, bool start_valid,
                                 bool start_inclusive, uint64_t start_hash_val,
                                 bool end_valid, bool end_inclusive,
@@ -406,6 +418,10 @@ YBCStatus YBCPgInsertStmtSetWriteTime(YBCPgStatement handle, const uint64_t writ
 
 YBCStatus YBCPgInsertStmtSetIsBackfill(YBCPgStatement handle, const bool is_backfill);
 
+// Mark insert of non transactional COPY or index backfill, so tablets could write such rows
+// directly to SST files.
+YBCStatus YBCPgInsertStmtSetIsBulkLoad(YBCPgStatement handle, const bool is_bulk_load);
+
 // UPDATE ------------------------------------------------------------------------------------------
 YBCStatus YBCPgNewUpdate(YBCPgOid database_oid,
                          YBCPgOid table_oid,
@@ -11,8 +11,11 @@
 // under the License.
 //
 
+#include <algorithm>
 #include <atomic>
+#include <set>
 #include <thread>
+#include <unordered_map>
 
 #include <gtest/gtest.h>
 
@@ -20,6 +23,7 @@
 
 #include "yb/common/pgsql_error.h"
 
+#include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/value_type.h"
 
 #include "yb/integration-tests/mini_cluster.h"
@@ -30,6 +34,7 @@
 #include "yb/master/sys_catalog_constants.h"
 
 #include "yb/rocksdb/db.h"
+#include "yb/rocksdb/metadata.h"
 
 #include "yb/server/skewed_clock.h"
 
@@ -61,7 +66,13 @@ DECLARE_double(TEST_transaction_ignore_applying_probability);
 DECLARE_int32(history_cutoff_propagation_interval_ms);
 DECLARE_int32(timestamp_history_retention_interval_sec);
 DECLARE_int32(txn_max_apply_batch_records);
+DECLARE_int32(tablet_bulk_load_ingest_min_records);
+DECLARE_int32(TEST_slowdown_backfill_by_ms);
 DECLARE_int64(apply_intents_task_injected_delay_ms);
+DECLARE_int32(apply_intents_task_max_steps_per_run);
+DECLARE_bool(TEST_record_apply_intents_events);
+DECLARE_int32(TEST_pause_and_skip_apply_intents_task_loop_ms);
+DECLARE_int32(ysql_batch_ybctid_shared_iterator_min_keys);
 DECLARE_uint64(max_clock_skew_usec);
 DECLARE_int64(db_write_buffer_size);
 DECLARE_bool(rocksdb_use_logging_iterator);
@@ -897,6 +908,160 @@ TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(BulkCopyWithRestart), PgMiniSmallW
   }, 10s * kTimeMultiplier, "Intents cleanup", 200ms));
 }
 
+class PgMiniBulkLoadTest : public PgMiniTest {
+ public:
+  void SetUp() override {
+    FLAGS_ysql_non_txn_copy = true;
+    // Lower than the number of rows that COPY sends to a tablet in one batch.
+    FLAGS_tablet_bulk_load_ingest_min_records = 100;
+    PgMiniTest::SetUp();
+  }
+
+  // Returns number of live files in regular DBs of all tablet peers. Checks that all of them have
+  // frontiers, and that no bulk load file was ingested twice, i.e. by bootstrap after restart.
+  size_t CheckLiveFiles() {
+    size_t result = 0;
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+      auto* db = peer->tablet()->TEST_db();
+      if (!db) {
+        continue;
+      }
+      std::vector<rocksdb::LiveFileMetaData> files;
+      db->GetLiveFilesMetaData(&files);
+      std::set<OpId> single_op_ids;
+      for (const auto& file : files) {
+        EXPECT_TRUE(file.smallest.user_frontier && file.largest.user_frontier) << file.ToString();
+        if (!file.smallest.user_frontier || !file.largest.user_frontier) {
+          continue;
+        }
+        auto& smallest = down_cast<docdb::ConsensusFrontier&>(*file.smallest.user_frontier);
+        auto& largest = down_cast<docdb::ConsensusFrontier&>(*file.largest.user_frontier);
+        EXPECT_TRUE(largest.hybrid_time().is_valid()) << file.ToString();
+        EXPECT_NE(largest.hybrid_time(), HybridTime::kMax) << file.ToString();
+        if (smallest.op_id() == largest.op_id()) {
+          EXPECT_TRUE(single_op_ids.insert(largest.op_id()).second)
+              << "Duplicate file of " << largest.op_id() << ": " << file.ToString();
+        }
+      }
+      result += files.size();
+    }
+    return result;
+  }
+};
+
+// Checks that rows of non transactional COPY, that were written to SST files bypassing the mem
+// table, are readable before and after restart.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(BulkLoadIngest), PgMiniBulkLoadTest) {
+  constexpr int kRows = 5000;
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE t (key INT PRIMARY KEY, value TEXT) SPLIT INTO 1 TABLETS"));
+
+  ASSERT_OK(conn.CopyBegin("COPY t FROM STDIN WITH BINARY"));
+  for (int key = 1; key <= kRows; ++key) {
+    conn.CopyStartRow(2);
+    conn.CopyPutInt32(key);
+    conn.CopyPutString(Format("value_$0", key));
+  }
+  ASSERT_OK(conn.CopyEnd());
+
+  // Mem tables are big enough for all rows, so SST files are created by ingestion only.
+  auto num_files = CheckLiveFiles();
+  LOG(INFO) << "Ingested files: " << num_files;
+  ASSERT_GT(num_files, 0);
+
+  auto check_rows = [this] {
+    auto read_conn = ASSERT_RESULT(Connect());
+    auto count = ASSERT_RESULT(read_conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t"));
+    ASSERT_EQ(count, kRows);
+    for (int key : {1, kRows / 2, kRows}) {
+      auto value = ASSERT_RESULT(read_conn.FetchValue<std::string>(
+          Format("SELECT value FROM t WHERE key = $0", key)));
+      ASSERT_EQ(value, Format("value_$0", key));
+    }
+  };
+
+  ASSERT_NO_FATALS(check_rows());
+
+  // Restart without flushing mem tables, so COPY operations are replayed by bootstrap.
+  FLAGS_flush_rocksdb_on_shutdown = false;
+  ASSERT_OK(cluster_->RestartSync());
+
+  ASSERT_NO_FATALS(check_rows());
+  // Replayed operations should find their files instead of adding them again.
+  ASSERT_EQ(CheckLiveFiles(), num_files);
+
+  ASSERT_OK(cluster_->CompactTablets());
+  ASSERT_NO_FATALS(check_rows());
+
+  // Compacted files do not let replayed operations find their files, so they are written through
+  // the mem table again.
+  ASSERT_OK(cluster_->RestartSync());
+  ASSERT_NO_FATALS(check_rows());
+  ASSERT_OK(cluster_->CompactTablets());
+  ASSERT_NO_FATALS(check_rows());
+}
+
+// Checks that index backfill, which runs concurrently with online writes to the index, ingests
+// its batches into the key range that overlaps with existing index entries, and that the index
+// stays consistent after restart and compaction.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(BulkLoadIngestBackfill), PgMiniBulkLoadTest) {
+  constexpr int kRows = 5000;
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE t (key INT PRIMARY KEY, value INT) SPLIT INTO 1 TABLETS"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, i % 100 FROM generate_series(1, $0) AS i", kRows));
+
+  // Online writes to the index use the same values as backfilled rows, so they fall into the key
+  // range of backfill batches.
+  FLAGS_TEST_slowdown_backfill_by_ms = 50;
+  std::atomic<int> next_key{kRows + 1};
+  TestThreadHolder thread_holder;
+  thread_holder.AddThreadFunctor([this, &next_key, &stop = thread_holder.stop_flag()] {
+    auto write_conn = ASSERT_RESULT(Connect());
+    while (!stop.load(std::memory_order_acquire)) {
+      auto key = next_key.load(std::memory_order_acquire);
+      ASSERT_OK(write_conn.ExecuteFormat("INSERT INTO t VALUES ($0, $1)", key, key % 100));
+      next_key.store(key + 1, std::memory_order_release);
+      if (key % 50 == 0) {
+        ASSERT_OK(cluster_->FlushTablets());
+      }
+    }
+  });
+
+  ASSERT_OK(conn.Execute("CREATE INDEX ON t(value)"));
+  thread_holder.Stop();
+  FLAGS_TEST_slowdown_backfill_by_ms = 0;
+
+  const int total_rows = next_key.load(std::memory_order_acquire) - 1;
+  LOG(INFO) << "Total rows: " << total_rows;
+  ASSERT_GT(total_rows, kRows);
+
+  auto check_rows = [this, total_rows] {
+    auto read_conn = ASSERT_RESULT(Connect());
+    const std::string query = "SELECT COUNT(*) FROM t WHERE value = 42";
+    ASSERT_TRUE(ASSERT_RESULT(read_conn.HasIndexScan(query)));
+    auto count = ASSERT_RESULT(read_conn.FetchValue<int64_t>(query));
+    int expected = 0;
+    for (int key = 1; key <= total_rows; ++key) {
+      expected += key % 100 == 42;
+    }
+    ASSERT_EQ(count, expected);
+  };
+
+  ASSERT_NO_FATALS(check_rows());
+  LOG(INFO) << "Live files: " << CheckLiveFiles();
+
+  FLAGS_flush_rocksdb_on_shutdown = false;
+  ASSERT_OK(cluster_->RestartSync());
+  ASSERT_NO_FATALS(check_rows());
+  CheckLiveFiles();
+
+  ASSERT_OK(cluster_->CompactTablets());
+  ASSERT_NO_FATALS(check_rows());
+}
+
 void PgMiniTest::TestForeignKey(IsolationLevel isolation_level) {
   const std::string kDataTable = "data";
   const std::string kReferenceTable = "reference";
@@ -1619,6 +1784,150 @@ TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(BigSelect)) {
   ASSERT_EQ(res, kRows);
 }
 
+class PgMiniParallelScanTest : public PgMiniTest {
+ protected:
+  void SetUp() override {
+    FLAGS_ysql_enable_parallel_scan = true;
+    // Small pages and budget, so parallel scan has to hold rows and reduce parallelism.
+    FLAGS_ysql_prefetch_limit = 16;
+    FLAGS_ysql_parallel_scan_max_buffered_bytes = 4_KB;
+    PgMiniTest::SetUp();
+  }
+
+  // Checks that scan of table t, containing keys 1..num_rows, returns them in key order in both
+  // directions.
+  void CheckScanOrder(PGConn* conn, int num_rows) {
+    for (bool ascending : {true, false}) {
+      auto res = ASSERT_RESULT(conn->FetchFormat(
+          "SELECT key FROM t ORDER BY key $0", ascending ? "ASC" : "DESC"));
+      ASSERT_EQ(PQntuples(res.get()), num_rows);
+      for (int i = 0; i != num_rows; ++i) {
+        auto expected = ascending ? i + 1 : num_rows - i;
+        ASSERT_EQ(ASSERT_RESULT(GetInt32(res.get(), i, 0)), expected);
+      }
+    }
+  }
+};
+
+// Check that parallel scan returns rows in the same order as partition by partition scan.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ParallelScanOrder), PgMiniParallelScanTest) {
+  constexpr int kRows = 1000;
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE t (key INT, value TEXT, PRIMARY KEY (key ASC)) "
+      "SPLIT AT VALUES ((100), (250), (400), (700))"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, repeat('x', i % 100) FROM generate_series(1, $0) i", kRows));
+
+  ASSERT_NO_FATALS(CheckScanOrder(&conn, kRows));
+
+  auto count = ASSERT_RESULT(conn.FetchValue<int64_t>(
+      "SELECT COUNT(*) FROM (SELECT DISTINCT key FROM t WHERE length(value) > 50) s"));
+  ASSERT_EQ(count, 490);
+}
+
+// Check parallel scan order when the head partition is the largest one in both directions, so
+// following partitions complete while it is still being read.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ParallelScanOrderLargeHead), PgMiniParallelScanTest) {
+  constexpr int kRows = 1000;
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE t (key INT, value TEXT, PRIMARY KEY (key ASC)) "
+      "SPLIT AT VALUES ((450), (500), (550))"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, repeat('x', i % 100) FROM generate_series(1, $0) i", kRows));
+
+  ASSERT_NO_FATALS(CheckScanOrder(&conn, kRows));
+}
+
+// Check that parallel scan of hash partitioned table returns every row exactly once.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ParallelScanHash), PgMiniParallelScanTest) {
+  constexpr int kRows = 1000;
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE t (key INT PRIMARY KEY, value TEXT) SPLIT INTO 5 TABLETS"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, repeat('x', i % 100) FROM generate_series(1, $0) i", kRows));
+
+  auto res = ASSERT_RESULT(conn.Fetch("SELECT key FROM t"));
+  ASSERT_EQ(PQntuples(res.get()), kRows);
+  std::vector<bool> seen(kRows + 1);
+  for (int i = 0; i != kRows; ++i) {
+    auto key = ASSERT_RESULT(GetInt32(res.get(), i, 0));
+    ASSERT_GE(key, 1);
+    ASSERT_LE(key, kRows);
+    ASSERT_FALSE(seen[key]) << "Duplicate key: " << key;
+    seen[key] = true;
+  }
+}
+
+// Check that parallel sampling of all partitions counts every row of the table.
+TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(AnalyzeMultiTablet)) {
+  constexpr int kRows = 5000;
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY, value INT) SPLIT INTO 8 TABLETS"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, i % 10 FROM generate_series(1, $0) i", kRows));
+  ASSERT_OK(conn.Execute("ANALYZE t"));
+
+  auto reltuples = ASSERT_RESULT(conn.FetchValue<int64_t>(
+      "SELECT reltuples::bigint FROM pg_class WHERE relname = 't'"));
+  ASSERT_EQ(reltuples, kRows);
+  auto n_distinct = ASSERT_RESULT(conn.FetchValue<int64_t>(
+      "SELECT n_distinct::bigint FROM pg_stats WHERE tablename = 't' AND attname = 'value'"));
+  ASSERT_EQ(n_distinct, 10);
+}
+
+class PgMiniPrefetchSizeLimitTest : public PgMiniSingleTServerTest {
+ protected:
+  void SetUp() override {
+    FLAGS_ysql_prefetch_size_limit_bytes = 16_KB;
+    PgMiniTest::SetUp();
+  }
+};
+
+// Check that scan returns all rows when pages are cut by size limit rather than by row count.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(PrefetchSizeLimit), PgMiniPrefetchSizeLimitTest) {
+  constexpr int kRows = 200;
+  constexpr int kValueSize = 3_KB;
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT, value TEXT, PRIMARY KEY (key ASC))"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, repeat('x', $0) FROM generate_series(1, $1) i", kValueSize, kRows));
+
+  auto res = ASSERT_RESULT(conn.Fetch("SELECT key, length(value) FROM t"));
+  ASSERT_EQ(PQntuples(res.get()), kRows);
+  for (int i = 0; i != kRows; ++i) {
+    ASSERT_EQ(ASSERT_RESULT(GetInt32(res.get(), i, 0)), i + 1);
+    ASSERT_EQ(ASSERT_RESULT(GetInt32(res.get(), i, 1)), kValueSize);
+  }
+}
+
+// Check that connections of the same tablet server do not use table info cached by the tablet
+// server before the table was altered.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(SharedTableCacheAlter), PgMiniSingleTServerTest) {
+  auto conn1 = ASSERT_RESULT(Connect());
+  auto conn2 = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn1.Execute("CREATE TABLE t (key INT PRIMARY KEY, value INT)"));
+  ASSERT_OK(conn1.Execute("INSERT INTO t VALUES (1, 1)"));
+  ASSERT_EQ(ASSERT_RESULT(conn2.FetchValue<int32_t>("SELECT value FROM t WHERE key = 1")), 1);
+
+  ASSERT_OK(conn1.Execute("ALTER TABLE t ADD COLUMN extra INT"));
+  ASSERT_OK(conn1.Execute("INSERT INTO t VALUES (2, 2, 20)"));
+
+  // New connection should see the new column, as well as the one that read the table before.
+  auto conn3 = ASSERT_RESULT(Connect());
+  ASSERT_EQ(ASSERT_RESULT(conn3.FetchValue<int32_t>("SELECT extra FROM t WHERE key = 2")), 20);
+  ASSERT_OK(conn2.Execute("INSERT INTO t VALUES (3, 3, 30)"));
+  ASSERT_EQ(ASSERT_RESULT(conn2.FetchValue<int64_t>("SELECT SUM(extra) FROM t")), 50);
+}
+
 TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ManyRowsInsert), PgMiniSingleTServerTest) {
   constexpr int kRows = 100000;
   auto conn = ASSERT_RESULT(Connect());
@@ -2007,6 +2316,89 @@ TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(BigInsertWithDropTable)) {
   ASSERT_OK(conn.Execute("DROP TABLE t"));
 }
 
+// Check that apply of several large transactions is interleaved in the tablet strand, and
+// produces correct results.
+TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(BigInsertsInterleaved)) {
+  constexpr int kNumRows = 10000;
+  constexpr int kNumInserts = 3;
+  FLAGS_txn_max_apply_batch_records = kNumRows / 10;
+  FLAGS_apply_intents_task_max_steps_per_run = 1;
+  FLAGS_TEST_record_apply_intents_events = true;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (a int PRIMARY KEY) SPLIT INTO 1 TABLETS"));
+
+  std::vector<tablet::TransactionParticipant*> participants;
+  for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+    auto* participant = peer->tablet()->transaction_participant();
+    if (participant && peer->tablet()->metadata()->table_name() == "t") {
+      participants.push_back(participant);
+    }
+  }
+  ASSERT_FALSE(participants.empty());
+
+  // Block the first apply task in the strand, until apply tasks of all transactions are enqueued
+  // behind it.
+  FLAGS_TEST_pause_and_skip_apply_intents_task_loop_ms = 10;
+  for (int i = 0; i != kNumInserts; ++i) {
+    ASSERT_OK(conn.ExecuteFormat(
+        "INSERT INTO t SELECT generate_series($0, $1)", i * kNumRows + 1, (i + 1) * kNumRows));
+  }
+  ASSERT_OK(WaitFor([&participants] {
+    for (auto* participant : participants) {
+      auto events = participant->TEST_ApplyIntentsEvents();
+      auto enqueued = std::count_if(events.begin(), events.end(), [](const auto& event) {
+        return event.second == 0;
+      });
+      if (enqueued < kNumInserts) {
+        return false;
+      }
+    }
+    return true;
+  }, 30s * kTimeMultiplier, "Apply tasks enqueued"));
+  FLAGS_TEST_pause_and_skip_apply_intents_task_loop_ms = 0;
+
+  ASSERT_OK(WaitFor([this] {
+    return CountIntents(cluster_.get()) == 0;
+  }, 60s * kTimeMultiplier, "Intents apply", 200ms));
+
+  // Each task performs a single step per run, and is enqueued behind the other tasks after that.
+  // So consecutive steps of the same transaction are possible only when all other transactions
+  // are already applied.
+  for (auto* participant : participants) {
+    std::vector<TransactionId> steps;
+    for (const auto& event : participant->TEST_ApplyIntentsEvents()) {
+      if (event.second != 0) {
+        steps.push_back(event.first);
+      }
+    }
+    LOG(INFO) << "Apply steps: " << AsString(steps);
+    std::unordered_map<TransactionId, size_t, TransactionIdHash> last_step;
+    for (size_t i = 0; i != steps.size(); ++i) {
+      last_step[steps[i]] = i;
+    }
+    ASSERT_EQ(last_step.size(), static_cast<size_t>(kNumInserts));
+    size_t num_interleaved = 0;
+    for (size_t i = 1; i != steps.size(); ++i) {
+      if (steps[i] != steps[i - 1]) {
+        ++num_interleaved;
+        continue;
+      }
+      for (const auto& id_and_last_step : last_step) {
+        if (id_and_last_step.first != steps[i]) {
+          ASSERT_LT(id_and_last_step.second, i)
+              << "Consecutive steps of " << steps[i] << " at " << i << ", while "
+              << id_and_last_step.first << " is not applied yet";
+        }
+      }
+    }
+    ASSERT_GE(num_interleaved, static_cast<size_t>(kNumInserts - 1));
+  }
+
+  auto res = ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t"));
+  ASSERT_EQ(res, kNumInserts * kNumRows);
+}
+
 void PgMiniTest::TestConcurrentDeleteRowAndUpdateColumn(bool select_before_update) {
   auto conn1 = ASSERT_RESULT(Connect());
   auto conn2 = ASSERT_RESULT(Connect());
@@ -2122,6 +2514,36 @@ TEST_F_EX(
   ASSERT_EQ(lines, numRows);
 }
 
+// Check that batched ybctid read returns the same rows, regardless of whether separate iterator
+// is used for each ybctid or a single iterator is used for the whole batch.
+TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(BatchYbctidSharedIterator)) {
+  constexpr int kNumRows = 1000;
+  constexpr int kNumSelectedRows = 100;
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (k INT PRIMARY KEY, v INT, w INT) SPLIT INTO 2 TABLETS"));
+  ASSERT_OK(conn.Execute("CREATE INDEX ON t(v)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, i, i * 2 FROM generate_series(1, $0) AS i", kNumRows));
+  // Delete some of the rows in a transaction, so reads should take its intents into account.
+  ASSERT_OK(conn.StartTransaction(IsolationLevel::SNAPSHOT_ISOLATION));
+  ASSERT_OK(conn.Execute("DELETE FROM t WHERE k % 3 = 0"));
+
+  const auto query = Format(
+      "SELECT COUNT(*), SUM(w) FROM t WHERE v <= $0", kNumSelectedRows);
+  ASSERT_TRUE(ASSERT_RESULT(conn.HasIndexScan(query)));
+  std::vector<std::pair<int64_t, int64_t>> results;
+  for (auto min_keys : {-1, 0}) {
+    FLAGS_ysql_batch_ybctid_shared_iterator_min_keys = min_keys;
+    auto res = ASSERT_RESULT(conn.FetchMatrix(query, 1, 2));
+    results.emplace_back(
+        ASSERT_RESULT(GetInt64(res.get(), 0, 0)), ASSERT_RESULT(GetInt64(res.get(), 0, 1)));
+  }
+  ASSERT_OK(conn.CommitTransaction());
+  LOG(INFO) << "Results: " << AsString(results);
+  ASSERT_EQ(results[0].first, kNumSelectedRows - kNumSelectedRows / 3);
+  ASSERT_EQ(results[0], results[1]);
+}
+
 class PgMiniTabletSplitTest : public PgMiniTest {
  public:
   void SetUp() override {